@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "arena.h"
+
+#define ARENA_ALIGN (2 * sizeof(void *))
+#define ARENA_MIN_CHUNK (64 * 1024)
+
+struct ArenaChunk
+{
+    ArenaChunk *next;   /* older chunk */
+    size_t size;        /* usable bytes in data[] */
+    size_t used;
+    char data[];
+};
+
+static ArenaChunk *new_chunk(size_t at_least, ArenaChunk *next)
+{
+    // Chunks double in size so a large source needs only a handful of them
+    size_t size = next ? next->size * 2 : ARENA_MIN_CHUNK;
+    while (size < at_least + ARENA_ALIGN)
+        size *= 2;
+
+    ArenaChunk *c = (ArenaChunk *)malloc(sizeof(ArenaChunk) + size);
+    if (!c)
+    {
+        fprintf(stderr, "Memory allocation failed for arena chunk.\n");
+        exit(EXIT_FAILURE);
+    }
+    c->next = next;
+    c->size = size;
+    c->used = 0;
+    return c;
+}
+
+void *arena_alloc(Arena *arena, size_t size)
+{
+    ArenaChunk *c = arena->head;
+
+    if (c)
+    {
+        uintptr_t base = (uintptr_t)c->data;
+        uintptr_t p = (base + c->used + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+        if (p + size <= base + c->size)
+        {
+            c->used = (size_t)(p - base) + size;
+            arena->total += size;
+            return (void *)p;
+        }
+    }
+
+    c = arena->head = new_chunk(size, c);
+
+    uintptr_t base = (uintptr_t)c->data;
+    uintptr_t p = (base + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+    c->used = (size_t)(p - base) + size;
+    arena->total += size;
+    return (void *)p;
+}
+
+char *arena_strndup(Arena *arena, const char *s, size_t n)
+{
+    char *copy = (char *)arena_alloc(arena, n + 1);
+    memcpy(copy, s, n);
+    copy[n] = '\0';
+    return copy;
+}
+
+char *arena_strdup(Arena *arena, const char *s)
+{
+    return arena_strndup(arena, s, strlen(s));
+}
+
+void arena_reset(Arena *arena)
+{
+    ArenaChunk *keep = arena->head;
+    if (!keep)
+        return;
+
+    ArenaChunk *c = keep->next;
+    while (c)
+    {
+        ArenaChunk *next = c->next;
+        free(c);
+        c = next;
+    }
+
+    keep->next = NULL;
+    keep->used = 0;
+    arena->total = 0;
+}
+
+void arena_free(Arena *arena)
+{
+    arena_reset(arena);
+    free(arena->head);
+    arena->head = NULL;
+}
@@ -0,0 +1,34 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/* ----------------------------
+Bump-pointer arena
+
+Owns the text of one compilation: the spelling of every token and
+generated name, copied in once when it is interned (the AST lives in
+its own parallel arrays). Allocation is a pointer bump inside the
+current chunk; nothing is freed individually.
+arena_reset() drops everything at once and keeps the newest chunk for
+the next compilation.
+---------------------------- */
+typedef struct ArenaChunk ArenaChunk;
+
+typedef struct
+{
+    ArenaChunk *head;   /* chunk currently being filled (largest so far) */
+    size_t total;       /* bytes handed out since the last reset */
+} Arena;
+
+void *arena_alloc(Arena *arena, size_t size);
+char *arena_strdup(Arena *arena, const char *s);
+char *arena_strndup(Arena *arena, const char *s, size_t n);
+
+/* Release every allocation; the arena stays usable */
+void arena_reset(Arena *arena);
+
+/* Release every allocation and all chunk memory */
+void arena_free(Arena *arena);
+
+#endif /* ARENA_H */
@@ -3,118 +3,306 @@
 #include <string.h>
 #include "ast.h"
 
-int islexerror = 0;
+static void grow(AstTree *t)
+{
+    uint32_t cap = t->capacity ? t->capacity * 2 : 1024;
 
-ASTNode *root = NULL;
+    AstTag *tag = (AstTag *)realloc(t->tag, cap * sizeof(AstTag));
+    if (tag)
+        t->tag = tag;
+    AstRef *left = (AstRef *)realloc(t->left, cap * sizeof(AstRef));
+    if (left)
+        t->left = left;
+    AstRef *right = (AstRef *)realloc(t->right, cap * sizeof(AstRef));
+    if (right)
+        t->right = right;
+    int *sym = (int *)realloc(t->sym, cap * sizeof(int));
+    if (sym)
+        t->sym = sym;
+    int *line = (int *)realloc(t->line, cap * sizeof(int));
+    if (line)
+        t->line = line;
 
-ASTNode *new_node(NodeType type, const char *val, ASTNode *l, ASTNode *r, int line)
-{
-    ASTNode *n = (ASTNode *)malloc(sizeof(ASTNode));
-    if (!n)
+    if (!tag || !left || !right || !sym || !line)
     {
-        fprintf(stderr, "Memory allocation failed for AST node.\n");
+        fprintf(stderr, "Memory allocation failed for AST.\n");
         exit(EXIT_FAILURE);
     }
+    t->capacity = cap;
+}
 
-    n->type = type;
-    n->left = l;
-    n->right = r;
-    n->line = line; // store line number
+static AstRef add(AstTree *t, NodeType type, AstRef l, AstRef r, int line)
+{
+    if (t->count == 0)
+    {
+        // slot 0 is AST_NULL: an interior node with no children
+        grow(t);
+        memset(&t->tag[0], 0, sizeof(AstTag));
+        t->left[0] = t->right[0] = AST_NULL;
+        t->sym[0] = INTERN_NONE;
+        t->line[0] = 0;
+        t->count = 1;
+    }
+    if (t->count >= t->capacity)
+        grow(t);
 
-    if (val)
+    AstRef n = t->count++;
+    t->tag[n].type = (unsigned char)type;
+    t->tag[n].kind = AST_KIND_NONE;
+    t->tag[n].op = AST_OP_NONE;
+    t->tag[n].dtype = AST_TYPE_KUAN;
+    t->left[n] = l;
+    t->right[n] = r;
+    t->sym[n] = INTERN_NONE;
+    t->line[n] = line;
+    return n;
+}
+
+static void set_lit(AstTree *t, AstRef n, int64_t v)
+{
+    t->left[n] = (AstRef)((uint64_t)v & 0xffffffffu);
+    t->right[n] = (AstRef)((uint64_t)v >> 32);
+}
+
+AstRef ast_node(AstTree *t, NodeType type, AstKind kind, AstRef l, AstRef r, int line)
+{
+    AstRef n = add(t, type, l, r, line);
+    t->tag[n].kind = (unsigned char)kind;
+    return n;
+}
+
+AstRef ast_op_node(AstTree *t, NodeType type, AstOp op, AstRef l, AstRef r, int line)
+{
+    AstRef n = add(t, type, l, r, line);
+    t->tag[n].op = (unsigned char)op;
+    return n;
+}
+
+AstRef ast_declaration(AstTree *t, AstDataType dtype, AstRef list, int line)
+{
+    AstRef n = ast_node(t, NODE_DECLARATION, AST_DECL_TYPED, list, AST_NULL, line);
+    t->tag[n].dtype = (unsigned char)dtype;
+    return n;
+}
+
+AstRef ast_ident(AstTree *t, int sym, int line)
+{
+    AstRef n = add(t, NODE_IDENTIFIER, AST_NULL, AST_NULL, line);
+    t->sym[n] = sym;
+    return n;
+}
+
+AstRef ast_int_literal(AstTree *t, const InternTable *names, int sym, int line)
+{
+    AstRef n = add(t, NODE_LITERAL, AST_NULL, AST_NULL, line);
+    t->sym[n] = sym;
+    t->tag[n].kind = AST_LIT_INT;
+    set_lit(t, n, strtoll(intern_name(names, sym), NULL, 10)); // the scanner only passes digits; too many saturate
+    return n;
+}
+
+AstRef ast_char_literal(AstTree *t, const InternTable *names, int sym, int line)
+{
+    AstRef n = add(t, NODE_LITERAL, AST_NULL, AST_NULL, line);
+    const char *text = intern_name(names, sym);
+    size_t len = strlen(text);
+    int64_t v = 0;
+
+    t->sym[n] = sym;
+
+    // the scanner passes 'c' or '\c'
+    if (len == 3)
     {
-        n->value = strdup(val);
-        if (!n->value)
-        {
-            fprintf(stderr, "strdup failed.\n");
-            exit(EXIT_FAILURE);
-        }
+        t->tag[n].kind = AST_LIT_CHAR;
+        v = (unsigned char)text[1];
     }
-    else
+    else if (len == 4 && text[1] == '\\')
     {
-        n->value = NULL;
+        t->tag[n].kind = AST_LIT_CHAR;
+        switch (text[2])
+        {
+        case 'n':  v = '\n'; break;
+        case 't':  v = '\t'; break;
+        case 'r':  v = '\r'; break;
+        case '0':  v = '\0'; break;
+        case '\\': v = '\\'; break;
+        case '\'': v = '\''; break;
+        case '"':  v = '"'; break;
+        default:   t->tag[n].kind = AST_KIND_NONE; break; // unknown escape, left undecoded
+        }
     }
 
+    set_lit(t, n, v);
     return n;
 }
 
-static void indent(int level)
+AstRef ast_string_literal(AstTree *t, int sym, int line)
 {
-    for (int i = 0; i < level; i++)
-        printf("  ");
+    AstRef n = add(t, NODE_STRING_LITERAL, AST_NULL, AST_NULL, line);
+    t->sym[n] = sym;
+    return n;
 }
 
-// Pretty print AST with type names
-void print_ast(ASTNode *node, int indent)
+void ast_reset(AstTree *t)
 {
-    if (!node)
-        return;
+    if (t->count)
+        t->count = 1;
+}
+
+void ast_free(AstTree *t)
+{
+    free(t->tag);
+    free(t->left);
+    free(t->right);
+    free(t->sym);
+    free(t->line);
+    memset(t, 0, sizeof(*t));
+}
+
+void ast_push(AstStack *s, AstRef node, int state, int aux)
+{
+    if (s->count == s->capacity)
+    {
+        size_t cap = s->capacity ? s->capacity * 2 : 256;
+        AstFrame *frames = (AstFrame *)realloc(s->frames, cap * sizeof(AstFrame));
+        if (!frames)
+        {
+            fprintf(stderr, "Memory allocation failed for AST walk.\n");
+            exit(EXIT_FAILURE);
+        }
+        s->frames = frames;
+        s->capacity = cap;
+    }
+    AstFrame *f = &s->frames[s->count++];
+    f->node = node;
+    f->state = state;
+    f->aux = aux;
+}
+
+void ast_stack_free(AstStack *s)
+{
+    free(s->frames);
+    s->frames = NULL;
+    s->count = s->capacity = 0;
+}
 
-    // Print indentation
-    for (int i = 0; i < indent; i++)
-        printf("  ");
+const char *ast_op_text(AstOp op)
+{
+    switch (op)
+    {
+    case AST_OP_ADD:        return "+";
+    case AST_OP_SUB:        return "-";
+    case AST_OP_MUL:        return "*";
+    case AST_OP_DIV:        return "/";
+    case AST_OP_INC:        return "++";
+    case AST_OP_DEC:        return "--";
+    case AST_OP_ASSIGN:     return "=";
+    case AST_OP_ADD_ASSIGN: return "+=";
+    case AST_OP_SUB_ASSIGN: return "-=";
+    case AST_OP_MUL_ASSIGN: return "*=";
+    case AST_OP_DIV_ASSIGN: return "/=";
+    default:                return "";
+    }
+}
 
-    // Print node value and type
-    printf("(%s: ", node->value ? node->value : "NULL");
+static const char *datatype_text(AstDataType dtype)
+{
+    switch (dtype)
+    {
+    case AST_TYPE_ENTEGER: return "ENTEGER";
+    case AST_TYPE_CHAROT:  return "CHAROT";
+    default:               return "KUAN";
+    }
+}
 
-    switch (node->type)
+const char *ast_text(const AstTree *t, const InternTable *names, AstRef n)
+{
+    switch (ast_type(t, n))
     {
     case NODE_START:
-        printf("START");
-        break;
+        return "START";
     case NODE_STATEMENT_LIST:
-        printf("STATEMENT_LIST");
-        break;
+        return "STMT_LIST";
     case NODE_STATEMENT:
-        printf("STATEMENT");
-        break;
+        switch (ast_kind(t, n))
+        {
+        case AST_STMT_DECL:   return "DECL_STMT";
+        case AST_STMT_ASSIGN: return "ASSIGN_STMT";
+        case AST_STMT_EXPR:   return "EXPR_STMT";
+        case AST_STMT_PRINT:  return "PRINT_STMT";
+        default:              return "EMPTY!";
+        }
     case NODE_PRINTING:
-        printf("PRINTING");
-        break;
+        return "PRINT";
     case NODE_PRINT_ITEM:
-        printf("PRINT_ITEM");
-        break;
+        return ast_kind(t, n) == AST_PRINT_LIST ? "PRINT_LIST" : "PRINT_ITEM";
     case NODE_DECLARATION:
-        printf("DECL");
-        break;
+        switch (ast_kind(t, n))
+        {
+        case AST_DECL_LIST: return "DECL";
+        case AST_DECL_INIT: return "INIT_DECL";
+        default:            return datatype_text(ast_dtype(t, n));
+        }
     case NODE_DATATYPE:
-        printf("DATATYPE");
-        break;
+        return datatype_text(ast_dtype(t, n));
     case NODE_IDENTIFIER:
-        printf("IDENTIFIER");
-        break;
     case NODE_LITERAL:
-        printf("LITERAL");
-        break;
+    case NODE_STRING_LITERAL:
+        return intern_name(names, ast_sym(t, n));
     case NODE_ASSIGNMENT:
-        printf("ASSIGNMENT");
-        break;
-    case NODE_UNKNOWN:
-        printf("UNKNOWN");
-        break;
     case NODE_EXPRESSION:
-        printf("EXPRESSION");
-        break;
     case NODE_TERM:
-        printf("TERM");
-        break;
     case NODE_UNARY_OP:
-        printf("UNARY_OP");
-        break;
     case NODE_POSTFIX_OP:
-        printf("POSTFIX_OP");
-        break;
-    case NODE_FACTOR:
-        printf("FACTOR");
-        break;
+        return ast_op_text(ast_op(t, n));
     default:
-        printf("OTHER");
-        break;
+        return "NULL";
+    }
+}
+
+static const char *node_type_name(NodeType type)
+{
+    switch (type)
+    {
+    case NODE_START:          return "START";
+    case NODE_STATEMENT_LIST: return "STATEMENT_LIST";
+    case NODE_STATEMENT:      return "STATEMENT";
+    case NODE_PRINTING:       return "PRINTING";
+    case NODE_PRINT_ITEM:     return "PRINT_ITEM";
+    case NODE_DECLARATION:    return "DECL";
+    case NODE_DATATYPE:       return "DATATYPE";
+    case NODE_IDENTIFIER:     return "IDENTIFIER";
+    case NODE_LITERAL:        return "LITERAL";
+    case NODE_ASSIGNMENT:     return "ASSIGNMENT";
+    case NODE_UNKNOWN:        return "UNKNOWN";
+    case NODE_EXPRESSION:     return "EXPRESSION";
+    case NODE_TERM:           return "TERM";
+    case NODE_UNARY_OP:       return "UNARY_OP";
+    case NODE_POSTFIX_OP:     return "POSTFIX_OP";
+    case NODE_FACTOR:         return "FACTOR";
+    default:                  return "OTHER";
     }
+}
+
+// Pretty print AST with type names, preorder
+void print_ast(BaiTrace *tr, const AstTree *t, const InternTable *names, AstRef root, int level)
+{
+    AstStack stack = {0};
+    ast_push(&stack, root, 0, level);
+
+    while (stack.count)
+    {
+        AstFrame f = stack.frames[--stack.count];
+        if (f.node == AST_NULL)
+            continue;
 
-    printf(")\n");
+        // indentation, then node value and type
+        trace_printf(tr, "%*s(%s: %s)\n", f.aux * 2, "", ast_text(t, names, f.node), node_type_name(ast_type(t, f.node)));
+
+        // children next, left first
+        ast_push(&stack, ast_right(t, f.node), 0, f.aux + 1);
+        ast_push(&stack, ast_left(t, f.node), 0, f.aux + 1);
+    }
 
-    // Recursively print children
-    print_ast(node->left, indent + 1);
-    print_ast(node->right, indent + 1);
+    ast_stack_free(&stack);
 }
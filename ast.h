@@ -1,6 +1,10 @@
 #ifndef AST_H
 #define AST_H
 
+#include <stdint.h>
+#include "intern.h"
+#include "trace.h"
+
 typedef enum NodeType {
     NODE_START,
     NODE_STATEMENT_LIST,
@@ -21,20 +25,151 @@ typedef enum NodeType {
     NODE_STRING_LITERAL
 } NodeType;
 
+/* Operator of a NODE_EXPRESSION, NODE_TERM, NODE_UNARY_OP, NODE_POSTFIX_OP
+   or NODE_ASSIGNMENT node */
+typedef enum AstOp {
+    AST_OP_NONE,
+    AST_OP_ADD,         // a + b, +a
+    AST_OP_SUB,         // a - b, -a
+    AST_OP_MUL,
+    AST_OP_DIV,
+    AST_OP_INC,         // ++
+    AST_OP_DEC,         // --
+    AST_OP_ASSIGN,      // =
+    AST_OP_ADD_ASSIGN,  // +=
+    AST_OP_SUB_ASSIGN,  // -=
+    AST_OP_MUL_ASSIGN,  // *=
+    AST_OP_DIV_ASSIGN   // /=
+} AstOp;
+
+/* What a node stands for within its NodeType, fixed by the parser */
+typedef enum AstKind {
+    AST_KIND_NONE,
+
+    // NODE_STATEMENT
+    AST_STMT_DECL,
+    AST_STMT_ASSIGN,
+    AST_STMT_EXPR,
+    AST_STMT_PRINT,
+    AST_STMT_EMPTY,
+
+    // NODE_DECLARATION
+    AST_DECL_TYPED,     // whole declaration: left = declarators, dtype = declared type
+    AST_DECL_LIST,      // left = one declarator, right = the rest
+    AST_DECL_INIT,      // left = identifier, right = initializer
+
+    // NODE_PRINT_ITEM: first item of a PRENT, and each one after a comma
+    AST_PRINT_LIST,
+    AST_PRINT_ITEM,
+
+    // NODE_LITERAL; a literal the parser could not decode keeps AST_KIND_NONE
+    AST_LIT_INT,
+    AST_LIT_CHAR
+} AstKind;
+
+/* Declared type of an AST_DECL_TYPED node */
+typedef enum AstDataType {
+    AST_TYPE_KUAN,
+    AST_TYPE_ENTEGER,
+    AST_TYPE_CHAROT
+} AstDataType;
+
+
+/* ----------------------------
+Flat AST
+
+Nodes are stored column-wise in parallel arrays and referred to by a
+32-bit index; index 0 is reserved so AST_NULL can mean "no child". The
+walkers only touch the columns they need and a node takes 20 bytes. The
+arrays are kept between compiles and only grow.
+
+Every leaf carries an interned spelling and has no children, so its two
+child slots hold the low and high halves of its decoded literal value
+instead (see ast_lit); ast_left/ast_right read as AST_NULL there.
+---------------------------- */
+typedef uint32_t AstRef;
+#define AST_NULL 0u
+
+typedef struct {
+    unsigned char type;     // NodeType
+    unsigned char kind;     // AstKind
+    unsigned char op;       // AstOp
+    unsigned char dtype;    // AstDataType
+} AstTag;
+
+typedef struct {
+    AstTag *tag;
+    AstRef *left;
+    AstRef *right;
+    int *sym;               // intern ID of a leaf's spelling, INTERN_NONE otherwise
+    int *line;
+    uint32_t count;         // including the AST_NULL slot
+    uint32_t capacity;
+} AstTree;
+
+/* Interior node of `type` */
+AstRef ast_node(AstTree *t, NodeType type, AstKind kind, AstRef l, AstRef r, int line);
+AstRef ast_op_node(AstTree *t, NodeType type, AstOp op, AstRef l, AstRef r, int line);
+AstRef ast_declaration(AstTree *t, AstDataType dtype, AstRef list, int line);
+
+/* Leaves; `sym` is the interned spelling. Literals are decoded here once
+   so later phases never re-parse the text. */
+AstRef ast_ident(AstTree *t, int sym, int line);
+AstRef ast_int_literal(AstTree *t, const InternTable *names, int sym, int line);
+AstRef ast_char_literal(AstTree *t, const InternTable *names, int sym, int line);
+AstRef ast_string_literal(AstTree *t, int sym, int line);
+
+static inline NodeType ast_type(const AstTree *t, AstRef n) { return (NodeType)t->tag[n].type; }
+static inline AstKind ast_kind(const AstTree *t, AstRef n) { return (AstKind)t->tag[n].kind; }
+static inline AstOp ast_op(const AstTree *t, AstRef n) { return (AstOp)t->tag[n].op; }
+static inline AstDataType ast_dtype(const AstTree *t, AstRef n) { return (AstDataType)t->tag[n].dtype; }
+static inline int ast_sym(const AstTree *t, AstRef n) { return t->sym[n]; }
+static inline int ast_is_leaf(const AstTree *t, AstRef n) { return t->sym[n] != INTERN_NONE; }
+static inline AstRef ast_left(const AstTree *t, AstRef n) { return ast_is_leaf(t, n) ? AST_NULL : t->left[n]; }
+static inline AstRef ast_right(const AstTree *t, AstRef n) { return ast_is_leaf(t, n) ? AST_NULL : t->right[n]; }
+static inline int ast_line(const AstTree *t, AstRef n) { return t->line[n]; }
+
+/* Decoded value of an AST_LIT_INT / AST_LIT_CHAR leaf */
+static inline int64_t ast_lit(const AstTree *t, AstRef n)
+{
+    return (int64_t)(((uint64_t)t->right[n] << 32) | t->left[n]);
+}
+
+/* Link `r` in as the right child of an interior node (for lists built
+   front to back) */
+static inline void ast_set_right(AstTree *t, AstRef n, AstRef r) { t->right[n] = r; }
+
+/* Drop every node, keeping the arrays */
+void ast_reset(AstTree *t);
+void ast_free(AstTree *t);
+
+const char *ast_op_text(AstOp op);
+
+/* ----------------------------
+Walker stack
 
-typedef struct ASTNode {
-    NodeType type;
-    char *value;
-    struct ASTNode *left;
-    struct ASTNode *right;
-    int line;  // <-- added line number
-} ASTNode;
+The tree walkers keep their pending nodes here instead of on the C stack,
+so lists and expressions of any length or depth are walked in constant
+stack space. A walker remembers `count` on entry and runs until the
+stack is back to it, which lets nested walkers share one stack.
+---------------------------- */
+typedef struct {
+    AstRef node;
+    int state;      // how far the walker has got with this node
+    int aux;        // walker-specific (indent, used_in_expr, ...)
+} AstFrame;
 
-extern ASTNode *root;
+typedef struct {
+    AstFrame *frames;
+    size_t count;
+    size_t capacity;
+} AstStack;
 
-extern int islexerror;
+void ast_push(AstStack *s, AstRef node, int state, int aux);
+void ast_stack_free(AstStack *s);
 
-ASTNode *new_node(NodeType type, const char *val, ASTNode *l, ASTNode *r, int line);
-void print_ast(ASTNode *node, int level);
+/* The label print_ast shows for a node ("DECL_STMT", "+", an identifier...) */
+const char *ast_text(const AstTree *t, const InternTable *names, AstRef n);
+void print_ast(BaiTrace *tr, const AstTree *t, const InternTable *names, AstRef node, int level);
 
 #endif
@@ -0,0 +1,408 @@
+/* End-to-end compile throughput benchmark
+ *
+ * Generates valid BaiScript programs of a given shape and size in memory,
+ * compiles each one with bai_compile_source() (console trace off, stats
+ * on) and reports statements/s and bytes/s for every phase. Sizes go up
+ * by 10x from --min-size to --max-size; the default stops at 1M, the
+ * full sweep is --max-size=100M.
+ *
+ * The target and machine-code phases see the whole program. Before the
+ * assembly and machine-code lists could grow they stopped at 9999 lines,
+ * so on large programs those phases in earlier --json runs timed only
+ * a prefix of the output; do not use such runs as a --baseline for them.
+ *
+ * Shapes:
+ *     decls    ENTEGER/CHAROT declarations, some with several declarators
+ *     prent    long PRENT lists over a handful of variables
+ *     parens   initializers nested 32 parentheses deep
+ *     incdec   ++, --, += and -= on a few counters
+ *     idents   every statement introduces a new long identifier
+ *     mixed    all of the above, round robin
+ *
+ * Options:
+ *     --shape=NAME          one shape instead of all of them
+ *     --min-size=N[K|M]     smallest program (default 1K)
+ *     --max-size=N[K|M]     largest program (default 1M)
+ *     --fast-lexer          scan with scanner.c instead of lex.l
+ *     --json                print the results as JSON, one record per line
+ *     --baseline=FILE       compare against an earlier --json run
+ *     --emit=SHAPE:SIZE     write one generated program to stdout and exit
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/compile_bench.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c \
+ *         yacc.tab.c symbol_table.c semantic_analyzer.c intermediate_code_generator.c \
+ *         target_code_generator.c machine_code_generator.c compiler.c -o compile_bench
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "compiler.h"
+
+#define PAREN_DEPTH 32
+#define PRENT_ITEMS 32
+#define MAX_BASELINE 4096
+
+typedef struct
+{
+    char *data;
+    size_t len;
+    size_t cap;
+    long statements;
+} Source;
+
+typedef enum
+{
+    SHAPE_DECLS,
+    SHAPE_PRENT,
+    SHAPE_PARENS,
+    SHAPE_INCDEC,
+    SHAPE_IDENTS,
+    SHAPE_MIXED,
+    SHAPE_COUNT
+} Shape;
+
+static const char *shape_names[SHAPE_COUNT] = {
+    "decls", "prent", "parens", "incdec", "idents", "mixed",
+};
+
+typedef struct
+{
+    char shape[16];
+    char phase[16];
+    size_t size;
+    double wall_ms;
+} BaselineEntry;
+
+static BaselineEntry baseline[MAX_BASELINE];
+static int baseline_count;
+
+/* ----------------------------
+Generator
+---------------------------- */
+
+static void emit(Source *s, const char *fmt, ...)
+{
+    va_list ap;
+    for (;;)
+    {
+        size_t room = s->cap - s->len;
+        va_start(ap, fmt);
+        int n = vsnprintf(s->data + s->len, room, fmt, ap);
+        va_end(ap);
+        if (n < 0)
+            return;
+        if ((size_t)n < room)
+        {
+            s->len += (size_t)n;
+            return;
+        }
+
+        size_t cap = s->cap * 2;
+        char *data = (char *)realloc(s->data, cap);
+        if (!data)
+        {
+            fprintf(stderr, "out of memory generating source\n");
+            exit(1);
+        }
+        s->data = data;
+        s->cap = cap;
+    }
+}
+
+// Variables the statements of a shape refer to
+static void preamble(Source *s, Shape shape)
+{
+    if (shape == SHAPE_PRENT || shape == SHAPE_MIXED)
+    {
+        for (int i = 0; i < 8; i++)
+            emit(s, "ENTEGER p%d = %d!\n", i, i * 7);
+        s->statements += 8;
+    }
+    if (shape == SHAPE_INCDEC || shape == SHAPE_MIXED)
+    {
+        emit(s, "ENTEGER n = 0!\nKUAN k = 'a'!\n");
+        s->statements += 2;
+    }
+}
+
+// Statement i of a shape; every name it declares is unique to i
+static void statement(Source *s, Shape shape, long i)
+{
+    switch (shape)
+    {
+    case SHAPE_DECLS:
+        switch (i % 3)
+        {
+        case 0: emit(s, "ENTEGER d_%ld = %ld!\n", i, i % 1000); break;
+        case 1: emit(s, "CHAROT c_%ld = 'q'!\n", i); break;
+        default: emit(s, "ENTEGER a_%ld, b_%ld = %ld, c_%ld!\n", i, i, i % 100, i); break;
+        }
+        break;
+
+    case SHAPE_PRENT:
+        emit(s, "PRENT \"row \"");
+        for (int j = 0; j < PRENT_ITEMS; j++)
+            emit(s, ", p%d", (int)((i + j) % 8));
+        emit(s, "!\n");
+        break;
+
+    case SHAPE_PARENS:
+        emit(s, "ENTEGER e_%ld = ", i);
+        for (int j = 0; j < PAREN_DEPTH; j++)
+            emit(s, "(");
+        emit(s, "%ld", i % 1000);
+        for (int j = 0; j < PAREN_DEPTH; j++)
+            emit(s, j % 2 ? ") * 1" : ") + 1");
+        emit(s, "!\n");
+        break;
+
+    case SHAPE_INCDEC:
+        switch (i % 6)
+        {
+        case 0: emit(s, "n++!\n"); break;
+        case 1: emit(s, "++n!\n"); break;
+        case 2: emit(s, "n += 3!\n"); break;
+        case 3: emit(s, "n -= 2!\n"); break;
+        case 4: emit(s, "k++!\n--k!\n"); s->statements++; break;
+        default: emit(s, "ENTEGER t_%ld = n++ + ++n!\n", i); break;
+        }
+        break;
+
+    case SHAPE_IDENTS:
+        if (i % 2 == 0)
+            emit(s, "ENTEGER identifier_number_%08ld_value = %ld!\n", i, i % 1000);
+        else
+            emit(s, "ENTEGER identifier_number_%08ld_copy = identifier_number_%08ld_value + 1!\n", i, i - 1);
+        break;
+
+    default:
+        // the idents statements refer back to the previous one, so keep pairs together
+        statement(s, (Shape)((i / 2) % SHAPE_MIXED), i);
+        return;
+    }
+    s->statements++;
+}
+
+static int generate(Source *s, Shape shape, size_t size)
+{
+    s->cap = size + 4096;
+    s->data = (char *)malloc(s->cap);
+    s->len = 0;
+    s->statements = 0;
+    if (!s->data)
+        return 0;
+
+    preamble(s, shape);
+    for (long i = 0; s->len < size; i++)
+        statement(s, shape, i);
+    return 1;
+}
+
+/* ----------------------------
+Driver
+---------------------------- */
+
+static size_t parse_size(const char *text)
+{
+    char *end;
+    double v = strtod(text, &end);
+    if (*end == 'K' || *end == 'k')
+        v *= 1024;
+    else if (*end == 'M' || *end == 'm')
+        v *= 1024 * 1024;
+    return v > 0 ? (size_t)v : 0;
+}
+
+static void size_label(size_t size, char *buf, size_t n)
+{
+    if (size >= 1024 * 1024)
+        snprintf(buf, n, "%zuM", size / (1024 * 1024));
+    else if (size >= 1024)
+        snprintf(buf, n, "%zuK", size / 1024);
+    else
+        snprintf(buf, n, "%zu", size);
+}
+
+static void load_baseline(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[512];
+    if (!f)
+    {
+        perror(path);
+        return;
+    }
+    while (fgets(line, sizeof(line), f) && baseline_count < MAX_BASELINE)
+    {
+        BaselineEntry *e = &baseline[baseline_count];
+        const char *rec = line[0] == ',' ? line + 1 : line;
+        if (sscanf(rec, " {\"shape\":\"%15[^\"]\",\"size\":%zu,\"phase\":\"%15[^\"]\",\"wall_ms\":%lf",
+                   e->shape, &e->size, e->phase, &e->wall_ms) == 4)
+            baseline_count++;
+    }
+    fclose(f);
+}
+
+static const BaselineEntry *find_baseline(const char *shape, size_t size, const char *phase)
+{
+    for (int i = 0; i < baseline_count; i++)
+        if (baseline[i].size == size && strcmp(baseline[i].shape, shape) == 0 &&
+            strcmp(baseline[i].phase, phase) == 0)
+            return &baseline[i];
+    return NULL;
+}
+
+static void report(const char *shape, size_t size, const Source *src, const PhaseStats *p,
+                   const char *phase, int json, int *first)
+{
+    // phases under a microsecond (report, with the trace off) have no meaningful rate
+    double secs = p->wall_ms / 1000.0;
+    double stmts_per_sec = secs >= 1e-6 ? src->statements / secs : 0;
+    double bytes_per_sec = secs >= 1e-6 ? src->len / secs : 0;
+    const BaselineEntry *base = find_baseline(shape, size, phase);
+
+    if (json)
+    {
+        printf("%s{\"shape\":\"%s\",\"size\":%zu,\"phase\":\"%s\",\"wall_ms\":%.3f,\"cpu_ms\":%.3f,"
+               "\"bytes\":%zu,\"statements\":%ld,\"stmts_per_sec\":%.0f,\"bytes_per_sec\":%.0f}\n",
+               *first ? "" : ",", shape, size, phase, p->wall_ms, p->cpu_ms, src->len,
+               src->statements, stmts_per_sec, bytes_per_sec);
+        *first = 0;
+        return;
+    }
+
+    char label[32];
+    size_label(size, label, sizeof(label));
+    printf("%-7s | %6s | %10ld | %-8s | %11.3f | %13.0f | %9.2f",
+           shape, label, src->statements, phase, p->wall_ms, stmts_per_sec, bytes_per_sec / (1024 * 1024));
+    if (base && base->wall_ms > 0)
+        printf(" | %7.2fx", p->wall_ms / base->wall_ms);
+    printf("\n");
+}
+
+static int run(BaiCompiler *ctx, Shape shape, size_t size, int json, int *first)
+{
+    Source src;
+    if (!generate(&src, shape, size))
+    {
+        fprintf(stderr, "out of memory generating %s\n", shape_names[shape]);
+        return 0;
+    }
+
+    int failed = bai_compile_source(ctx, src.data, src.len);
+    if (failed)
+    {
+        fprintf(stderr, "%s/%zu: program did not compile\n", shape_names[shape], size);
+        free(src.data);
+        return 0;
+    }
+
+    PhaseStats total = {0};
+    for (int i = 0; i < STATS_PHASE_COUNT; i++)
+    {
+        const PhaseStats *p = &ctx->stats.phase[i];
+        if (!p->ran)
+            continue;
+        report(shape_names[shape], size, &src, p, stats_phase_name((StatsPhase)i), json, first);
+        total.wall_ms += p->wall_ms;
+        total.cpu_ms += p->cpu_ms;
+    }
+    report(shape_names[shape], size, &src, &total, "total", json, first);
+
+    free(src.data);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t min_size = 1024, max_size = 1024 * 1024;
+    int only = -1, json = 0, fast = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--shape=", 8) == 0)
+        {
+            for (int s = 0; s < SHAPE_COUNT; s++)
+                if (strcmp(argv[i] + 8, shape_names[s]) == 0)
+                    only = s;
+            if (only < 0)
+            {
+                fprintf(stderr, "unknown shape %s\n", argv[i] + 8);
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--min-size=", 11) == 0)
+            min_size = parse_size(argv[i] + 11);
+        else if (strncmp(argv[i], "--max-size=", 11) == 0)
+            max_size = parse_size(argv[i] + 11);
+        else if (strcmp(argv[i], "--fast-lexer") == 0)
+            fast = 1;
+        else if (strcmp(argv[i], "--json") == 0)
+            json = 1;
+        else if (strncmp(argv[i], "--baseline=", 11) == 0)
+            load_baseline(argv[i] + 11);
+        else if (strncmp(argv[i], "--emit=", 7) == 0)
+        {
+            char name[16];
+            char size_text[32];
+            Source src;
+            if (sscanf(argv[i] + 7, "%15[^:]:%31s", name, size_text) != 2)
+            {
+                fprintf(stderr, "usage: --emit=SHAPE:SIZE\n");
+                return 1;
+            }
+            for (int s = 0; s < SHAPE_COUNT; s++)
+            {
+                if (strcmp(name, shape_names[s]) == 0 && generate(&src, (Shape)s, parse_size(size_text)))
+                {
+                    fwrite(src.data, 1, src.len, stdout);
+                    free(src.data);
+                    return 0;
+                }
+            }
+            fprintf(stderr, "unknown shape %s\n", name);
+            return 1;
+        }
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    BaiCompiler *ctx = bai_compiler_new();
+    if (!ctx)
+        return 1;
+    trace_set_all(&ctx->trace, TRACE_OFF);
+    ctx->stats.enabled = 1;
+    ctx->fast_lexer = fast;
+
+    int first = 1, ok = 1;
+    if (json)
+        printf("{\"results\":[\n");
+    else
+    {
+        printf("%-7s | %6s | %10s | %-8s | %11s | %13s | %9s%s\n", "shape", "size", "statements", "phase",
+               "wall ms", "statements/s", "MB/s", baseline_count ? " | vs base" : "");
+        printf("---------------------------------------------------------------------------------%s\n",
+               baseline_count ? "----------" : "");
+    }
+
+    for (int s = 0; s < SHAPE_COUNT; s++)
+    {
+        if (only >= 0 && s != only)
+            continue;
+        for (size_t size = min_size; size <= max_size; size *= 10)
+        {
+            ok &= run(ctx, (Shape)s, size, json, &first);
+            fflush(stdout);
+        }
+    }
+
+    if (json)
+        printf("]}\n");
+
+    bai_compiler_free(ctx);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/* Scanner throughput benchmark
+ *
+ * Generates a program of N statements in memory and times how fast the
+ * flex scanner (lex.l) and the hand-written scanner (scanner.c) turn it
+ * into tokens for the parser, identifiers and literals interned. The last
+ * column is the hand-written scanner on its own, without interning. The
+ * flex scanner prints a "[LEX]" line per token, so stdout is sent to
+ * /dev/null while it runs and the results are printed on stderr.
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/lexer_bench.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c yacc.tab.c \
+ *         symbol_table.c semantic_analyzer.c intermediate_code_generator.c \
+ *         target_code_generator.c machine_code_generator.c compiler.c -o lexer_bench
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "compiler.h"
+#include "yacc.tab.h"
+
+int yylex_init_extra(BaiCompiler *user_defined, yyscan_t *scanner);
+struct yy_buffer_state *yy_scan_bytes(const char *bytes, int len, yyscan_t scanner);
+int yylex_destroy(yyscan_t scanner);
+int bai_lex(YYSTYPE *yylval, BaiCompiler *ctx, yyscan_t scanner);
+
+static double seconds_since(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static char *make_source(int statements, size_t *len)
+{
+    size_t cap = (size_t)statements * 64 + 64;
+    char *src = malloc(cap);
+    size_t n = 0;
+    if (!src)
+        return NULL;
+
+    n += (size_t)snprintf(src + n, cap - n, "ENTEGER counter_total = 0!\n");
+    for (int i = 0; i < statements; i++)
+    {
+        switch (i % 4)
+        {
+        case 0: n += (size_t)snprintf(src + n, cap - n, "ENTEGER value_%d = %d * (counter_total + 12)!\n", i, i); break;
+        case 1: n += (size_t)snprintf(src + n, cap - n, "    counter_total += value_%d / 3! // running sum\n", i - 1); break;
+        case 2: n += (size_t)snprintf(src + n, cap - n, "CHAROT letter_%d = 'x'!\n", i); break;
+        default: n += (size_t)snprintf(src + n, cap - n, "PRENT \"total \", counter_total, letter_%d!\n", i - 1); break;
+        }
+    }
+    *len = n;
+    return src;
+}
+
+// Tokens per second through bai_lex(), flex or hand-written
+static double run(BaiCompiler *ctx, const char *src, size_t len, int fast, long *tokens)
+{
+    bai_compiler_reset(ctx);
+    ctx->fast_lexer = fast;
+
+    yyscan_t scanner = NULL;
+    if (fast)
+        scanner_init(&ctx->scan, src, len);
+    else
+    {
+        yylex_init_extra(ctx, &scanner);
+        yy_scan_bytes(src, (int)len, scanner);
+    }
+
+    YYSTYPE value;
+    long count = 0;
+    clock_t t0 = clock();
+    while (bai_lex(&value, ctx, scanner) != 0)
+        count++;
+    double secs = seconds_since(t0);
+
+    if (scanner)
+        yylex_destroy(scanner);
+    *tokens = count;
+    return secs > 0 ? count / secs : 0;
+}
+
+// Tokens per second of scanner_next() alone
+static double run_slices(BaiCompiler *ctx, const char *src, size_t len)
+{
+    Scanner s;
+    ScanToken tok;
+    long count = 0;
+
+    bai_compiler_reset(ctx);
+    scanner_init(&s, src, len);
+
+    clock_t t0 = clock();
+    while (scanner_next(ctx, &s, &tok) != 0)
+        count++;
+    double secs = seconds_since(t0);
+    return secs > 0 ? count / secs : 0;
+}
+
+int main(void)
+{
+    BaiCompiler *ctx = bai_compiler_new();
+    if (!ctx || !freopen("/dev/null", "w", stdout))
+        return 1;
+    trace_set_all(&ctx->trace, TRACE_FULL);
+
+    fprintf(stderr, "%12s | %10s | %14s | %14s | %8s | %14s\n", "statements", "tokens", "flex tok/s", "scanner tok/s", "speedup", "slices tok/s");
+    fprintf(stderr, "----------------------------------------------------------------------------------------\n");
+
+    for (int n = 10000; n <= 1000000; n *= 10)
+    {
+        size_t len;
+        char *src = make_source(n, &len);
+        if (!src)
+            return 1;
+
+        long flex_tokens, fast_tokens;
+        double flex = run(ctx, src, len, 0, &flex_tokens);
+        double fast = run(ctx, src, len, 1, &fast_tokens);
+        double slices = run_slices(ctx, src, len);
+
+        if (flex_tokens != fast_tokens)
+            fprintf(stderr, "token count mismatch: flex %ld, scanner %ld\n", flex_tokens, fast_tokens);
+        fprintf(stderr, "%12d | %10ld | %14.0f | %14.0f | %7.1fx | %14.0f\n", n, fast_tokens, flex, fast, flex > 0 ? fast / flex : 0, slices);
+        free(src);
+    }
+
+    bai_compiler_free(ctx);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/* Micro-benchmark: convert_to_machine_code()
+ *
+ * Encodes a listing of 8192 assembly lines in the mix the target code
+ * generator produces (daddiu, ld, sd, daddu, dsub, dmult/ddiv + mflo, the
+ * shift/mfhi/lui/ori sequences of constant multiplies and divides and the
+ * "; tac" comment lines it skips), restored before every run. The
+ * trace is off. Figures are per line; words/s is 1e9 / ns.
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/micro_encode.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c \
+ *         yacc.tab.c symbol_table.c semantic_analyzer.c intermediate_code_generator.c \
+ *         target_code_generator.c machine_code_generator.c compiler.c -o micro_encode
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compiler.h"
+#include "microbench.h"
+
+#define LINES 8192
+
+void add_assembly_line(BaiCompiler *ctx, const char *format, ...);
+void convert_to_machine_code(BaiCompiler *ctx);
+
+typedef struct
+{
+    BaiCompiler *ctx;
+    ASSEMBLY *listing;
+} EncodeRun;
+
+static const char *mix[] = {
+    "; a = b + c\n",
+    "ld r1, 16(r0)\n",
+    "ld r2, 24(r0)\n",
+    "daddu r3, r1, r2\n",
+    "sd r3, 8(r0)\n",
+    "daddiu r4, r0, 42\n",
+    "dsub r5, r3, r4\n",
+    "dmult r5, r1\n",
+    "mflo r6\n",
+    "ddiv r6, r2\n",
+    "mflo r7\n",
+    "sd r7, 32(r0)\n",
+    "dsll r8, r1, 3\n",
+    "dsubu r9, r8, r1\n",
+    "lui r10, 21845\n",
+    "ori r10, r10, 21846\n",
+    "dmult r9, r10\n",
+    "mfhi r11\n",
+    "dsrl32 r12, r11, 31\n",
+    "dsra r13, r11, 2\n",
+};
+
+static void restore(void *arg)
+{
+    EncodeRun *r = arg;
+    memcpy(r->ctx->target.assembly_code, r->listing, LINES * sizeof(ASSEMBLY));
+    r->ctx->target.assembly_code_count = LINES;
+    r->ctx->machine.machine_code_count = 0;
+}
+
+static void encode(void *arg)
+{
+    convert_to_machine_code(((EncodeRun *)arg)->ctx);
+}
+
+int main(int argc, char *argv[])
+{
+    mb_init(argc, argv);
+
+    EncodeRun r;
+    r.ctx = bai_compiler_new();
+    r.listing = calloc(LINES, sizeof(ASSEMBLY));
+    if (!r.ctx || !r.listing)
+        return 1;
+    trace_set_all(&r.ctx->trace, TRACE_OFF);
+
+    // the listing goes through add_assembly_line() once, which also
+    // sizes the buffer restore() copies it back into
+    long words = 0;
+    for (int i = 0; i < LINES; i++)
+    {
+        const char *line = mix[i % (sizeof(mix) / sizeof(mix[0]))];
+        add_assembly_line(r.ctx, "%s", line);
+        words += line[0] != ';';
+    }
+    memcpy(r.listing, r.ctx->target.assembly_code, LINES * sizeof(ASSEMBLY));
+
+    mb_run("convert_to_machine_code (per line)", restore, encode, &r, LINES);
+    restore(&r);
+    encode(&r);
+    if (r.ctx->machine.machine_code_count != words)
+        fprintf(stderr, "encoded %d words, expected %ld\n", r.ctx->machine.machine_code_count, words);
+
+    bai_compiler_free(r.ctx);
+    free(r.listing);
+    return 0;
+}
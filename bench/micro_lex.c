@@ -0,0 +1,108 @@
+/* Micro-benchmark: tokens through bai_lex()
+ *
+ * Scans a generated 1 MB program to the end, once through the flex
+ * scanner (yylex) and once through scanner.c, with the trace off so the
+ * [LEX] lines cost nothing. The compiler is reset before every run,
+ * outside the timed region. Figures are per token.
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/micro_lex.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c yacc.tab.c \
+ *         symbol_table.c semantic_analyzer.c intermediate_code_generator.c \
+ *         target_code_generator.c machine_code_generator.c compiler.c -o micro_lex
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compiler.h"
+#include "yacc.tab.h"
+#include "microbench.h"
+
+#define SOURCE_BYTES (1 << 20)
+
+int yylex_init_extra(BaiCompiler *user_defined, yyscan_t *scanner);
+struct yy_buffer_state *yy_scan_bytes(const char *bytes, int len, yyscan_t scanner);
+int yylex_destroy(yyscan_t scanner);
+int bai_lex(YYSTYPE *yylval, BaiCompiler *ctx, yyscan_t scanner);
+
+typedef struct
+{
+    BaiCompiler *ctx;
+    const char *src;
+    size_t len;
+    yyscan_t scanner;
+} LexRun;
+
+static char *make_source(size_t *len)
+{
+    size_t cap = SOURCE_BYTES + 256;
+    char *src = malloc(cap);
+    size_t n = 0;
+    if (!src)
+        return NULL;
+
+    for (int i = 0; n < SOURCE_BYTES; i++)
+    {
+        switch (i % 4)
+        {
+        case 0: n += (size_t)snprintf(src + n, cap - n, "ENTEGER value_%d = %d * (counter_total + 12)!\n", i, i); break;
+        case 1: n += (size_t)snprintf(src + n, cap - n, "    counter_total += value_%d / 3! // running sum\n", i - 1); break;
+        case 2: n += (size_t)snprintf(src + n, cap - n, "CHAROT letter_%d = 'x'!\n", i); break;
+        default: n += (size_t)snprintf(src + n, cap - n, "PRENT \"total \", counter_total, letter_%d!\n", i - 1); break;
+        }
+    }
+    *len = n;
+    return src;
+}
+
+static void setup_flex(void *arg)
+{
+    LexRun *r = arg;
+    bai_compiler_reset(r->ctx);
+    r->ctx->fast_lexer = 0;
+    if (r->scanner)
+        yylex_destroy(r->scanner);
+    yylex_init_extra(r->ctx, &r->scanner);
+    yy_scan_bytes(r->src, (int)r->len, r->scanner);
+}
+
+static void setup_scanner(void *arg)
+{
+    LexRun *r = arg;
+    bai_compiler_reset(r->ctx);
+    r->ctx->fast_lexer = 1;
+    scanner_init(&r->ctx->scan, r->src, r->len);
+}
+
+static void lex_all(void *arg)
+{
+    LexRun *r = arg;
+    YYSTYPE value;
+    while (bai_lex(&value, r->ctx, r->scanner) != 0)
+        ;
+}
+
+int main(int argc, char *argv[])
+{
+    mb_init(argc, argv);
+
+    LexRun r = {0};
+    r.ctx = bai_compiler_new();
+    r.src = make_source(&r.len);
+    if (!r.ctx || !r.src)
+        return 1;
+    trace_set_all(&r.ctx->trace, TRACE_OFF);
+
+    // token count for the per-token figures
+    setup_scanner(&r);
+    lex_all(&r);
+    long tokens = r.ctx->stats.tokens;
+
+    mb_run("yylex (flex)", setup_flex, lex_all, &r, tokens);
+    mb_run("scanner.c", setup_scanner, lex_all, &r, tokens);
+
+    if (r.scanner)
+        yylex_destroy(r.scanner);
+    bai_compiler_free(r.ctx);
+    free((char *)r.src);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/* Micro-benchmark: symbol lookups
+ *
+ * Declares N variables through sem_add_var() and times find_symbol()
+ * hits, find_symbol() misses (interned names that were never declared)
+ * and sem_find_var(), the wrapper semantic analysis calls, in a shuffled
+ * order. Figures are per lookup.
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/micro_lookup.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c yacc.tab.c \
+ *         symbol_table.c semantic_analyzer.c intermediate_code_generator.c \
+ *         target_code_generator.c machine_code_generator.c compiler.c -o micro_lookup
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compiler.h"
+#include "microbench.h"
+
+#define LOOKUPS (1 << 20)
+
+typedef struct
+{
+    BaiCompiler *ctx;
+    int *order;         /* LOOKUPS symbol IDs to look up */
+} LookupRun;
+
+static volatile long sink;
+
+static void find_hits(void *arg)
+{
+    LookupRun *r = arg;
+    long found = 0;
+    for (int i = 0; i < LOOKUPS; i++)
+        found += find_symbol(&r->ctx->symbols, r->order[i]) >= 0;
+    sink = found;
+}
+
+static void find_vars(void *arg)
+{
+    LookupRun *r = arg;
+    long found = 0;
+    for (int i = 0; i < LOOKUPS; i++)
+        found += sem_find_var(r->ctx, r->order[i]) != NULL;
+    sink = found;
+}
+
+// order[] of LOOKUPS IDs drawn from ids[0..n)
+static void shuffle_into(int *order, const int *ids, int n, unsigned *seed)
+{
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        *seed = *seed * 1103515245u + 12345u;
+        order[i] = ids[(*seed >> 8) % (unsigned)n];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    mb_init(argc, argv);
+
+    LookupRun r;
+    r.ctx = bai_compiler_new();
+    r.order = malloc(LOOKUPS * sizeof(int));
+    if (!r.ctx || !r.order)
+        return 1;
+
+    for (int n = 1024; n <= 1 << 18; n *= 16)
+    {
+        int *declared = malloc(n * sizeof(int));
+        int *missing = malloc(n * sizeof(int));
+        unsigned seed = 12345;
+        char name[32];
+        char label[64];
+        if (!declared || !missing)
+            return 1;
+
+        bai_compiler_reset(r.ctx);
+        for (int i = 0; i < n; i++)
+        {
+            snprintf(name, sizeof(name), "variable_%d", i);
+            declared[i] = intern_str(&r.ctx->names, &r.ctx->arena, name);
+            sem_add_var(r.ctx, declared[i], SEM_TYPE_INT);
+
+            snprintf(name, sizeof(name), "undeclared_%d", i);
+            missing[i] = intern_str(&r.ctx->names, &r.ctx->arena, name);
+        }
+
+        shuffle_into(r.order, declared, n, &seed);
+        snprintf(label, sizeof(label), "find_symbol hit (%d symbols)", n);
+        mb_run(label, NULL, find_hits, &r, LOOKUPS);
+
+        snprintf(label, sizeof(label), "sem_find_var (%d symbols)", n);
+        mb_run(label, NULL, find_vars, &r, LOOKUPS);
+
+        shuffle_into(r.order, missing, n, &seed);
+        snprintf(label, sizeof(label), "find_symbol miss (%d symbols)", n);
+        mb_run(label, NULL, find_hits, &r, LOOKUPS);
+
+        free(declared);
+        free(missing);
+    }
+
+    bai_compiler_free(r.ctx);
+    free(r.order);
+    return 0;
+}
@@ -0,0 +1,99 @@
+/* Micro-benchmark: register file scans
+ *
+ * Times get_available_register() with 0, 15 and 29 of the 30 registers
+ * busy, and find_temp_reg() looking up temps spread over a full register
+ * file (plus a temp held by no register, the worst case). Figures are
+ * per call.
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/micro_regalloc.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c \
+ *         yacc.tab.c symbol_table.c semantic_analyzer.c intermediate_code_generator.c \
+ *         target_code_generator.c machine_code_generator.c compiler.c -o micro_regalloc
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compiler.h"
+#include "microbench.h"
+
+#define CALLS (1 << 22)
+
+Register *get_available_register(BaiCompiler *ctx);
+Register *find_temp_reg(BaiCompiler *ctx, int temp);
+
+typedef struct
+{
+    BaiCompiler *ctx;
+    int temps[MAX_REGISTERS + 1];   /* the last one is in no register */
+    int pick;                       /* temps[] index to look up, -1 = cycle through all */
+} RegRun;
+
+static volatile long sink;
+
+static void available(void *arg)
+{
+    RegRun *r = arg;
+    long hits = 0;
+    for (int i = 0; i < CALLS; i++)
+        hits += get_available_register(r->ctx) != NULL;
+    sink = hits;
+}
+
+static void lookup(void *arg)
+{
+    RegRun *r = arg;
+    long hits = 0;
+    for (int i = 0; i < CALLS; i++)
+    {
+        int t = r->pick >= 0 ? r->temps[r->pick] : r->temps[i % MAX_REGISTERS];
+        hits += find_temp_reg(r->ctx, t) != NULL;
+    }
+    sink = hits;
+}
+
+static void occupy(RegRun *r, int busy)
+{
+    initialize_registers(r->ctx);
+    for (int i = 0; i < busy; i++)
+    {
+        r->ctx->target.registers[i].used = 1;
+        r->ctx->target.registers[i].assigned_temp = r->temps[i];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    mb_init(argc, argv);
+
+    RegRun r;
+    r.ctx = bai_compiler_new();
+    if (!r.ctx)
+        return 1;
+
+    char name[32];
+    for (int i = 0; i <= MAX_REGISTERS; i++)
+    {
+        snprintf(name, sizeof(name), "temp%d", i);
+        r.temps[i] = intern_str(&r.ctx->names, &r.ctx->arena, name);
+    }
+
+    int busy[] = {0, 15, MAX_REGISTERS - 1};
+    char label[64];
+    for (int i = 0; i < 3; i++)
+    {
+        occupy(&r, busy[i]);
+        snprintf(label, sizeof(label), "get_available_register (%d busy)", busy[i]);
+        mb_run(label, NULL, available, &r, CALLS);
+    }
+
+    occupy(&r, MAX_REGISTERS);
+    r.pick = -1;
+    mb_run("find_temp_reg (round robin)", NULL, lookup, &r, CALLS);
+    r.pick = MAX_REGISTERS - 1;
+    mb_run("find_temp_reg (last register)", NULL, lookup, &r, CALLS);
+    r.pick = MAX_REGISTERS;
+    mb_run("find_temp_reg (not held)", NULL, lookup, &r, CALLS);
+
+    bai_compiler_free(r.ctx);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/* Micro-benchmark: TAC emit() and removeRedundantTemporaries()
+ *
+ * Both are static in intermediate_code_generator.c, so this file includes
+ * it directly (and the build line leaves it out). emit() is timed
+ * appending N instructions to an empty list; removeRedundantTemporaries()
+ * runs over N instructions shaped like generated code ("tempK = a + b"
+ * followed by "x = tempK") and over N temps that are never copied. Sizes
+ * go up to 262144 instructions so growth beyond linear shows up. Figures
+ * are per instruction.
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/micro_tac.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c yacc.tab.c \
+ *         symbol_table.c semantic_analyzer.c target_code_generator.c \
+ *         machine_code_generator.c compiler.c -o micro_tac
+ */
+#include "intermediate_code_generator.c"
+#include "microbench.h"
+
+typedef struct
+{
+    BaiCompiler *ctx;
+    int count;
+    TACOperand a, b, x;
+    TACOperand *temps;
+    TACInstruction *input;      /* list removeRedundantTemporaries() starts from */
+} TacRun;
+
+static void clear_code(void *arg)
+{
+    TacRun *r = arg;
+    free(r->ctx->tac.code);
+    free(r->ctx->tac.optimizedCode);
+    r->ctx->tac.code = NULL;
+    r->ctx->tac.optimizedCode = NULL;
+    r->ctx->tac.codeCount = 0;
+    r->ctx->tac.codeCapacity = 0;
+    r->ctx->tac.optimizedCount = 0;
+}
+
+static void emit_all(void *arg)
+{
+    TacRun *r = arg;
+    for (int i = 0; i < r->count; i++)
+        emit(r->ctx, r->temps[i], r->a, TAC_ADD, r->b);
+}
+
+static void load_input(void *arg)
+{
+    TacRun *r = arg;
+    clear_code(r);
+    r->ctx->tac.code = malloc(r->count * sizeof(TACInstruction));
+    if (!r->ctx->tac.code)
+        exit(1);
+    memcpy(r->ctx->tac.code, r->input, r->count * sizeof(TACInstruction));
+    r->ctx->tac.codeCount = r->count;
+    r->ctx->tac.codeCapacity = r->count;
+}
+
+static void optimize(void *arg)
+{
+    removeRedundantTemporaries(((TacRun *)arg)->ctx);
+}
+
+static void set(TACInstruction *ins, TACOperand result, TACOperand arg1, TACOp op, TACOperand arg2)
+{
+    ins->op = op;
+    ins->result = result;
+    ins->arg1 = arg1;
+    ins->arg2 = arg2;
+}
+
+int main(int argc, char *argv[])
+{
+    mb_init(argc, argv);
+
+    TacRun r = {0};
+    r.ctx = bai_compiler_new();
+    if (!r.ctx)
+        return 1;
+
+    for (int n = 1024; n <= 262144; n *= 4)
+    {
+        char label[64];
+
+        bai_compiler_reset(r.ctx);
+        r.count = n;
+        r.a = variable(intern_str(&r.ctx->names, &r.ctx->arena, "a"));
+        r.b = variable(intern_str(&r.ctx->names, &r.ctx->arena, "b"));
+        r.x = variable(intern_str(&r.ctx->names, &r.ctx->arena, "x"));
+        r.temps = malloc(n * sizeof(TACOperand));
+        r.input = malloc(n * sizeof(TACInstruction));
+        if (!r.temps || !r.input)
+            return 1;
+        for (int i = 0; i < n; i++)
+            r.temps[i] = newTemp(r.ctx);
+
+        snprintf(label, sizeof(label), "emit (%d instructions)", n);
+        mb_run(label, clear_code, emit_all, &r, n);
+
+        // generated shape: each temp is copied into a variable right away
+        for (int i = 0; i + 1 < n; i += 2)
+        {
+            set(&r.input[i], r.temps[i], r.a, TAC_ADD, r.b);
+            set(&r.input[i + 1], r.x, r.temps[i], TAC_COPY, TAC_NO_OPERAND);
+        }
+        if (n % 2)
+            set(&r.input[n - 1], r.x, r.a, TAC_COPY, TAC_NO_OPERAND);
+        snprintf(label, sizeof(label), "removeRedundantTemps copy (%d)", n);
+        mb_run(label, load_input, optimize, &r, n);
+
+        // no temp is ever copied, so nothing is forwarded
+        for (int i = 0; i < n; i++)
+            set(&r.input[i], r.temps[i], r.a, TAC_ADD, r.b);
+        snprintf(label, sizeof(label), "removeRedundantTemps none (%d)", n);
+        mb_run(label, load_input, optimize, &r, n);
+
+        clear_code(&r);
+        free(r.temps);
+        free(r.input);
+    }
+
+    bai_compiler_free(r.ctx);
+    return 0;
+}
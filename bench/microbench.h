@@ -0,0 +1,224 @@
+/* Shared harness for the bench/micro_*.c benchmarks
+ *
+ * mb_run() calls a benchmark function `warmup` times untimed, then `reps`
+ * times timed, and prints min / median / p90 / p99 / max nanoseconds per
+ * operation across the timed runs. A setup function, if given, runs
+ * before every call outside the timed region.
+ *
+ * Common options, parsed by mb_init():
+ *     --reps=N        timed runs per benchmark (default 30)
+ *     --warmup=N      untimed runs first (default 3)
+ *     --perf          also count cycles, cache misses and branch misses
+ *                     per operation with perf_event_open (Linux only)
+ *
+ * Header-only so each benchmark stays a single file on its build line.
+ */
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define MB_MAX_REPS 1000
+
+typedef void (*mb_fn)(void *arg);
+
+static int mb_reps = 30;
+static int mb_warmup = 3;
+static int mb_perf;
+
+static double mb_now_ns(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+/* ----------------------------
+Hardware counters
+---------------------------- */
+
+enum
+{
+    MB_CYCLES,
+    MB_CACHE_MISSES,
+    MB_BRANCH_MISSES,
+    MB_COUNTERS
+};
+
+static int mb_fd[MB_COUNTERS] = {-1, -1, -1};
+
+#ifdef __linux__
+static int mb_open_counter(unsigned long long config, int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
+
+static void mb_perf_open(void)
+{
+#ifdef __linux__
+    mb_fd[MB_CYCLES] = mb_open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (mb_fd[MB_CYCLES] >= 0)
+    {
+        mb_fd[MB_CACHE_MISSES] = mb_open_counter(PERF_COUNT_HW_CACHE_MISSES, mb_fd[MB_CYCLES]);
+        mb_fd[MB_BRANCH_MISSES] = mb_open_counter(PERF_COUNT_HW_BRANCH_MISSES, mb_fd[MB_CYCLES]);
+    }
+    if (mb_fd[MB_CYCLES] < 0 || mb_fd[MB_CACHE_MISSES] < 0 || mb_fd[MB_BRANCH_MISSES] < 0)
+    {
+        fprintf(stderr, "perf counters unavailable (perf_event_open failed); timing only\n");
+        for (int i = 0; i < MB_COUNTERS; i++)
+            if (mb_fd[i] >= 0)
+                close(mb_fd[i]);
+        mb_fd[0] = mb_fd[1] = mb_fd[2] = -1;
+        mb_perf = 0;
+    }
+#else
+    fprintf(stderr, "perf counters are only available on Linux; timing only\n");
+    mb_perf = 0;
+#endif
+}
+
+static void mb_perf_start(void)
+{
+#ifdef __linux__
+    ioctl(mb_fd[MB_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(mb_fd[MB_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+// Adds this run's counts to `total`
+static void mb_perf_stop(unsigned long long total[MB_COUNTERS])
+{
+#ifdef __linux__
+    unsigned long long values[1 + MB_COUNTERS];
+    ioctl(mb_fd[MB_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if (read(mb_fd[MB_CYCLES], values, sizeof(values)) == (ssize_t)sizeof(values))
+        for (int i = 0; i < MB_COUNTERS; i++)
+            total[i] += values[1 + i];
+#else
+    (void)total;
+#endif
+}
+
+/* ----------------------------
+Runner
+---------------------------- */
+
+static void mb_init(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--reps=", 7) == 0)
+            mb_reps = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--warmup=", 9) == 0)
+            mb_warmup = atoi(argv[i] + 9);
+        else if (strcmp(argv[i], "--perf") == 0)
+            mb_perf = 1;
+        else
+            fprintf(stderr, "ignoring unknown option %s\n", argv[i]);
+    }
+    if (mb_reps < 1)
+        mb_reps = 1;
+    if (mb_reps > MB_MAX_REPS)
+        mb_reps = MB_MAX_REPS;
+    if (mb_warmup < 0)
+        mb_warmup = 0;
+    if (mb_perf)
+        mb_perf_open();
+
+    printf("%-36s | %10s | %9s | %9s | %9s | %9s | %9s%s\n", "benchmark", "ops/run", "min ns", "p50 ns",
+           "p90 ns", "p99 ns", "max ns", mb_perf ? " | cycles | cache-miss | branch-miss" : "");
+    printf("-------------------------------------------------------------------------------------------------------%s\n",
+           mb_perf ? "-------------------------------------" : "");
+}
+
+static int mb_compare(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static double mb_percentile(const double *sorted, int n, double pct)
+{
+    int rank = (int)(pct / 100.0 * n + 0.999999);
+    if (rank < 1)
+        rank = 1;
+    if (rank > n)
+        rank = n;
+    return sorted[rank - 1];
+}
+
+/* Time `fn` over `ops` operations per call; all figures are per operation */
+static void mb_run(const char *name, mb_fn setup, mb_fn fn, void *arg, long ops)
+{
+    static double samples[MB_MAX_REPS];
+    unsigned long long counters[MB_COUNTERS] = {0};
+
+    for (int i = 0; i < mb_warmup; i++)
+    {
+        if (setup)
+            setup(arg);
+        fn(arg);
+    }
+
+    for (int i = 0; i < mb_reps; i++)
+    {
+        if (setup)
+            setup(arg);
+        if (mb_perf)
+            mb_perf_start();
+        double t0 = mb_now_ns();
+        fn(arg);
+        double t1 = mb_now_ns();
+        if (mb_perf)
+            mb_perf_stop(counters);
+        samples[i] = (t1 - t0) / (ops > 0 ? ops : 1);
+    }
+
+    qsort(samples, mb_reps, sizeof(double), mb_compare);
+    printf("%-36s | %10ld | %9.2f | %9.2f | %9.2f | %9.2f | %9.2f", name, ops, samples[0],
+           mb_percentile(samples, mb_reps, 50), mb_percentile(samples, mb_reps, 90),
+           mb_percentile(samples, mb_reps, 99), samples[mb_reps - 1]);
+    if (mb_perf)
+    {
+        double per = (double)mb_reps * (ops > 0 ? ops : 1);
+        printf(" | %6.1f | %10.3f | %11.3f", counters[MB_CYCLES] / per, counters[MB_CACHE_MISSES] / per,
+               counters[MB_BRANCH_MISSES] / per);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+#endif /* MICROBENCH_H */
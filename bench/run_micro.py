@@ -0,0 +1,58 @@
+"""
+Build and run every bench/micro_*.c benchmark.
+
+    python bench/run_micro.py [--reps=N] [--warmup=N] [--perf] [only ...]
+
+Run from the repository root. Options are passed on to each benchmark
+(see bench/microbench.h); names such as "lex" or "encode" limit the run
+to those benchmarks. Executables go to bench/build/. The compiler is
+$CC, or gcc.
+"""
+import os
+import subprocess
+import sys
+
+SOURCES = [
+    "arena.c", "intern.c", "trace.c", "stats.c", "ast.c", "lex.yy.c", "scanner.c", "yacc.tab.c",
+    "symbol_table.c", "semantic_analyzer.c", "intermediate_code_generator.c",
+    "target_code_generator.c", "machine_code_generator.c", "compiler.c",
+]
+
+BENCHES = ["lex", "lookup", "tac", "regalloc", "encode"]
+
+# micro_tac.c includes intermediate_code_generator.c itself
+EXCLUDE = {"tac": "intermediate_code_generator.c"}
+
+
+def build(name, cc, out_dir):
+    exe = os.path.join(out_dir, "micro_" + name + (".exe" if os.name == "nt" else ""))
+    sources = [s for s in SOURCES if s != EXCLUDE.get(name)]
+    cmd = [cc, "-O2", "-I.", os.path.join("bench", "micro_" + name + ".c")] + sources + ["-o", exe]
+    subprocess.run(cmd, check=True)
+    return exe
+
+
+def main():
+    options = [a for a in sys.argv[1:] if a.startswith("--")]
+    only = [a for a in sys.argv[1:] if not a.startswith("--")]
+    unknown = [n for n in only if n not in BENCHES]
+    if unknown:
+        sys.exit("unknown benchmark(s): %s (have %s)" % (", ".join(unknown), ", ".join(BENCHES)))
+
+    cc = os.environ.get("CC", "gcc")
+    out_dir = os.path.join("bench", "build")
+    os.makedirs(out_dir, exist_ok=True)
+
+    status = 0
+    for name in BENCHES:
+        if only and name not in only:
+            continue
+        print("== micro_%s ==" % name, flush=True)
+        exe = build(name, cc, out_dir)
+        status |= subprocess.run([exe] + options).returncode
+        print(flush=True)
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
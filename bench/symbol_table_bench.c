@@ -0,0 +1,92 @@
+/* Symbol table lookup benchmark
+ *
+ * Fills a SymbolTable with N symbols and times find_symbol() hits and
+ * misses. With the hash index the cost per lookup should stay flat as N
+ * grows; the "linear" column is the old strcmp scan kept here for
+ * comparison (only run up to 16k symbols, it is quadratic).
+ *
+ * Build from the repository root:
+ *     gcc -O2 -I. bench/symbol_table_bench.c symbol_table.c trace.c -o symbol_table_bench
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "symbol_table.h"
+
+#define LOOKUPS 4000000L
+#define LINEAR_MAX 16384
+
+static volatile long sink;
+
+static double seconds_since(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int linear_find(const SymbolTable *st, char (*names)[16], const char *name)
+{
+    for (size_t i = 0; i < st->count; i++)
+        if (strcmp(names[i], name) == 0)
+            return (int)i;
+    return -1;
+}
+
+int main(void)
+{
+    printf("%10s | %14s | %14s | %14s\n", "symbols", "hit ns/lookup", "miss ns/lookup", "linear ns/hit");
+    printf("--------------------------------------------------------------\n");
+
+    for (int n = 1024; n <= 1 << 20; n *= 4)
+    {
+        SymbolTable st = {0};
+        char (*names)[16] = malloc((size_t)n * sizeof(*names));
+        if (!names)
+            return 1;
+
+        // IDs are dense like the intern table's, but added in a scrambled order
+        for (int i = 0; i < n; i++)
+        {
+            int sym = (int)(((unsigned)i * 40503u) % (unsigned)n);
+            snprintf(names[i], sizeof(names[i]), "v%d", sym);
+            add_symbol(&st, sym, names[i], SYM_TYPE_ENTEGER, 1);
+        }
+
+        unsigned x = 12345;
+        clock_t t0 = clock();
+        for (long k = 0; k < LOOKUPS; k++)
+        {
+            x = x * 1103515245u + 12345u;
+            sink += find_symbol(&st, (int)(x % (unsigned)n));
+        }
+        double hit = seconds_since(t0) * 1e9 / LOOKUPS;
+
+        t0 = clock();
+        for (long k = 0; k < LOOKUPS; k++)
+        {
+            x = x * 1103515245u + 12345u;
+            sink += find_symbol(&st, n + (int)(x % (unsigned)n));
+        }
+        double miss = seconds_since(t0) * 1e9 / LOOKUPS;
+
+        if (n <= LINEAR_MAX)
+        {
+            long reps = LOOKUPS / n;
+            t0 = clock();
+            for (long k = 0; k < reps; k++)
+            {
+                x = x * 1103515245u + 12345u;
+                sink += linear_find(&st, names, names[x % (unsigned)n]);
+            }
+            double linear = seconds_since(t0) * 1e9 / reps;
+            printf("%10d | %14.1f | %14.1f | %14.1f\n", n, hit, miss, linear);
+        }
+        else
+            printf("%10d | %14.1f | %14.1f | %14s\n", n, hit, miss, "-");
+
+        clear_symbol_table(&st);
+        free(names);
+    }
+
+    return 0;
+}
@@ -0,0 +1,571 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compiler.h"
+#include "yacc.tab.h"
+
+/* Reentrant scanner entry points (generated by flex from lex.l) */
+int yylex_init_extra(BaiCompiler *user_defined, yyscan_t *scanner);
+struct yy_buffer_state *yy_scan_bytes(const char *bytes, int len, yyscan_t scanner);
+int yylex_destroy(yyscan_t scanner);
+
+/* ----------------------------
+Context lifetime
+---------------------------- */
+
+BaiCompiler *bai_compiler_new(void)
+{
+    BaiCompiler *ctx = (BaiCompiler *)calloc(1, sizeof(BaiCompiler));
+    if (!ctx)
+        return NULL;
+
+    ctx->lineCount = 1;
+    ctx->machine.current_data_address = 0xFFF8;
+
+    // console logging stays off for library callers; main.c turns it on
+    trace_set_all(&ctx->trace, TRACE_OFF);
+    return ctx;
+}
+
+void bai_compiler_reset(BaiCompiler *ctx)
+{
+    if (!ctx)
+        return;
+
+    arena_reset(&ctx->arena);
+    intern_reset(&ctx->names);
+    ast_reset(&ctx->ast);
+    ctx->root = AST_NULL;
+    ctx->islexerror = 0;
+    ctx->parse_failed = 0;
+    ctx->lineCount = 1;
+
+    clear_symbol_table(&ctx->symbols);
+    sem_cleanup(ctx);
+    tac_cleanup(ctx);
+
+    ctx->target.data_count = 0;
+    ctx->target.assembly_code_count = 0;
+
+    ctx->machine.start_code_counter = 0;
+    ctx->machine.data_symbol_count = 0;
+    ctx->machine.current_data_address = 0xFFF8;
+    ctx->machine.machine_code_count = 0;
+
+    for (int i = 0; i < BAI_OUT_COUNT; i++)
+        bai_output_clear(ctx, (BaiOutput)i);
+
+    for (int i = 0; i < ctx->diagnostic_count; i++)
+        free(ctx->diagnostics[i].message);
+    ctx->diagnostic_count = 0;
+
+    stats_reset(&ctx->stats);
+}
+
+void bai_compiler_free(BaiCompiler *ctx)
+{
+    if (!ctx)
+        return;
+    bai_compiler_reset(ctx);
+    for (int i = 0; i < BAI_OUT_COUNT; i++)
+        free(ctx->outputs[i].data);
+    free(ctx->diagnostics);
+    intern_free(&ctx->names);
+    ast_free(&ctx->ast);
+    target_cleanup(ctx);
+    machine_cleanup(ctx);
+    arena_free(&ctx->arena);
+    trace_free(&ctx->trace);
+    free(ctx);
+}
+
+/* ----------------------------
+Output buffers
+---------------------------- */
+
+static const char *output_names[BAI_OUT_COUNT] = {
+    "output_print.txt",
+    "output_tac.txt",
+    "output_assembly.txt",
+    "output_machine_assembly.txt",
+    "output_machine_bin.txt",
+    "output_machine_hex.txt",
+    "output_machine.txt",
+};
+
+const char *bai_output_name(BaiOutput which)
+{
+    return output_names[which];
+}
+
+static int buffer_reserve(BaiBuffer *buf, size_t extra)
+{
+    size_t need = buf->len + extra + 1;
+    if (need <= buf->cap)
+        return 1;
+
+    size_t cap = buf->cap ? buf->cap : 256;
+    while (cap < need)
+        cap *= 2;
+
+    char *data = (char *)realloc(buf->data, cap);
+    if (!data)
+        return 0;
+    buf->data = data;
+    buf->cap = cap;
+    return 1;
+}
+
+void bai_output_clear(BaiCompiler *ctx, BaiOutput which)
+{
+    BaiBuffer *buf = &ctx->outputs[which];
+    buf->len = 0;
+    if (buf->data)
+        buf->data[0] = '\0';
+}
+
+void bai_output_vprintf(BaiCompiler *ctx, BaiOutput which, const char *fmt, va_list ap)
+{
+    BaiBuffer *buf = &ctx->outputs[which];
+
+    va_list probe;
+    va_copy(probe, ap);
+    int n = vsnprintf(NULL, 0, fmt, probe);
+    va_end(probe);
+
+    if (n < 0 || !buffer_reserve(buf, (size_t)n))
+    {
+        fprintf(stderr, "Error: out of memory writing %s\n", output_names[which]);
+        return;
+    }
+
+    vsnprintf(buf->data + buf->len, (size_t)n + 1, fmt, ap);
+    buf->len += (size_t)n;
+}
+
+void bai_output_printf(BaiCompiler *ctx, BaiOutput which, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    bai_output_vprintf(ctx, which, fmt, ap);
+    va_end(ap);
+}
+
+void bai_write_output(BaiCompiler *ctx, BaiOutput which, const char *msg)
+{
+    bai_output_clear(ctx, which);
+    bai_output_printf(ctx, which, "%s\n", msg);
+}
+
+int bai_save_outputs(BaiCompiler *ctx)
+{
+    int ok = 1;
+
+    for (int i = 0; i < BAI_OUT_COUNT; i++)
+    {
+        FILE *f;
+        if (ctx->output_dir && ctx->output_dir[0])
+        {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s/%s", ctx->output_dir, output_names[i]);
+            f = fopen(path, "w");
+        }
+        else
+            f = fopen(output_names[i], "w");
+
+        if (!f)
+        {
+            perror(output_names[i]);
+            ok = 0;
+            continue;
+        }
+        if (ctx->outputs[i].len > 0)
+            fwrite(ctx->outputs[i].data, 1, ctx->outputs[i].len, f);
+        if (fclose(f) != 0)
+            ok = 0;
+    }
+
+    return ok;
+}
+
+/* ----------------------------
+Diagnostics
+---------------------------- */
+
+void bai_report(BaiCompiler *ctx, BaiSeverity severity, int line, const char *fmt, ...)
+{
+    if (ctx->diagnostic_count == ctx->diagnostic_capacity)
+    {
+        int cap = ctx->diagnostic_capacity ? ctx->diagnostic_capacity * 2 : 8;
+        BaiDiagnostic *d = (BaiDiagnostic *)realloc(ctx->diagnostics, cap * sizeof(BaiDiagnostic));
+        if (!d)
+            return;
+        ctx->diagnostics = d;
+        ctx->diagnostic_capacity = cap;
+    }
+
+    char msg[512];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+
+    // messages are single lines; drop the newline some callers include
+    size_t n = strlen(msg);
+    while (n > 0 && msg[n - 1] == '\n')
+        msg[--n] = '\0';
+
+    // like a failed realloc above, running out of memory drops the diagnostic
+    char *message = strdup(msg);
+    if (!message)
+        return;
+
+    BaiDiagnostic *d = &ctx->diagnostics[ctx->diagnostic_count++];
+    d->severity = severity;
+    d->line = line;
+    d->message = message;
+}
+
+static void write_machine_error_files(BaiCompiler *ctx, const char *error_msg)
+{
+    // Write the same error message to all machine code output files
+    // This ensures the Electron process finds consistent error messages
+    bai_write_output(ctx, BAI_OUT_MACHINE_ASSEMBLY, error_msg);
+    bai_write_output(ctx, BAI_OUT_MACHINE_BIN, error_msg);
+    bai_write_output(ctx, BAI_OUT_MACHINE_HEX, error_msg);
+    // Also write to the legacy single file for backward compatibility
+    bai_write_output(ctx, BAI_OUT_MACHINE, error_msg);
+}
+
+static void write_assembly_error_file(BaiCompiler *ctx, const char *error_msg)
+{
+    bai_write_output(ctx, BAI_OUT_ASSEMBLY, error_msg);
+}
+
+static void write_tac_error_file(BaiCompiler *ctx, const char *error_msg)
+{
+    bai_write_output(ctx, BAI_OUT_TAC, error_msg);
+}
+
+static void initialize_output_files(BaiCompiler *ctx)
+{
+    // Clear all output files at start
+    for (int i = 0; i < BAI_OUT_COUNT; i++)
+        bai_write_output(ctx, (BaiOutput)i, "");
+}
+
+/* ----------------------------
+Pipeline
+---------------------------- */
+
+int bai_compile_source(BaiCompiler *ctx, const char *src, size_t len)
+{
+    int sem_errors = 0;
+
+    TRACE(&ctx->trace, TRACE_PARSE, TRACE_INFO, "=== BaiScript IS PARSING! ===\n\n");
+
+    bai_compiler_reset(ctx);
+
+    // Initialize all output files to empty
+    initialize_output_files(ctx);
+
+    ctx->stats.source_bytes = len;
+    stats_begin(&ctx->stats, STATS_PARSE);
+
+    yyscan_t scanner = NULL;
+    if (ctx->fast_lexer)
+        scanner_init(&ctx->scan, src, len);
+    else
+    {
+        if (yylex_init_extra(ctx, &scanner) != 0)
+        {
+            fprintf(stderr, "Error: unable to create scanner\n");
+            stats_end(&ctx->stats, STATS_PARSE);
+            trace_flush(&ctx->trace);
+            return 1;
+        }
+        yy_scan_bytes(src, (int)len, scanner);
+    }
+
+    int result = yyparse(ctx, scanner);
+
+    if (scanner)
+        yylex_destroy(scanner);
+
+    if (result == 0 && !ctx->parse_failed)
+    {
+        TRACE(&ctx->trace, TRACE_PARSE, TRACE_INFO, "[PARSE] Accepted\n\n");
+        if (trace_on(&ctx->trace, TRACE_PARSE, TRACE_FULL))
+        {
+            trace_printf(&ctx->trace, "== AST ==\n");
+            print_ast(&ctx->trace, &ctx->ast, &ctx->names, ctx->root, 0);
+        }
+    }
+    else
+    {
+        const char *parse_error_msg = "No assembly generated due to parse errors.";
+        TRACE(&ctx->trace, TRACE_PARSE, TRACE_INFO, "[PARSE] Failed - writing error messages to output files\n");
+        write_assembly_error_file(ctx, parse_error_msg);
+        write_machine_error_files(ctx, "No machine code generated due to parse errors.");
+        write_tac_error_file(ctx, "No TAC generated due to parse errors.");
+    }
+
+    TRACE(&ctx->trace, TRACE_PARSE, TRACE_INFO, "\n=== BaiScript IS PARSED! ===\n");
+    stats_end(&ctx->stats, STATS_PARSE);
+    ctx->stats.ast_nodes = ctx->ast.count > 0 ? (long)ctx->ast.count - 1 : 0;
+
+    // === STEP 2: SEMANTIC ANALYSIS ===
+    TRACE(&ctx->trace, TRACE_SEM, TRACE_INFO, "\n=== BaiScript SEMANTIC ANALYSIS ===\n\n");
+
+    if (result == 0 && !ctx->parse_failed)
+    {
+        // analyze AST
+        stats_begin(&ctx->stats, STATS_SEMANTIC);
+        sem_errors = semantic_analyzer(ctx);
+        stats_end(&ctx->stats, STATS_SEMANTIC);
+
+        if (sem_errors == 0)
+        {
+            TRACE(&ctx->trace, TRACE_SEM, TRACE_INFO, "[MAIN] Semantic analysis passed.\n");
+        }
+        else
+        {
+            TRACE(&ctx->trace, TRACE_SEM, TRACE_INFO, "[MAIN] Semantic analysis failed with %d error(s).\n", sem_errors);
+            // Write semantic errors to output files
+            char sem_error_msg[256];
+            snprintf(sem_error_msg, sizeof(sem_error_msg),
+                     "No assembly generated due to %d semantic error(s).", sem_errors);
+            write_assembly_error_file(ctx, sem_error_msg);
+            write_machine_error_files(ctx, "No machine code generated due to semantic errors.");
+            write_tac_error_file(ctx, "No TAC generated due to semantic errors.");
+        }
+    }
+    else
+    {
+        TRACE(&ctx->trace, TRACE_SEM, TRACE_INFO, "[MAIN] Skipping semantic analysis due to parse errors.\n");
+    }
+
+    TRACE(&ctx->trace, TRACE_SEM, TRACE_INFO, "\n=== BaiScript SEMANTIC ANALYSIS ENDED ===\n\n");
+
+    // === STEP 3: INTERMEDIATE CODE GENERATION ===
+    TRACE(&ctx->trace, TRACE_TAC, TRACE_INFO, "\n=== BaiScript INTERMEDIATE CODE GENERATION ===\n\n");
+
+    if (sem_errors > 0)
+    {
+        TRACE(&ctx->trace, TRACE_TAC, TRACE_INFO, "[MAIN] Skipping intermediate code generation due to semantic errors.\n");
+        // Error messages already written in semantic analysis step
+    }
+    else if (result == 0 && !ctx->parse_failed)
+    {
+        stats_begin(&ctx->stats, STATS_TAC);
+        generate_intermediate_code(ctx, ctx->root);
+        stats_end(&ctx->stats, STATS_TAC);
+        ctx->stats.tac_instructions = ctx->tac.codeCount;
+        ctx->stats.tac_optimized = ctx->tac.optimizedCount;
+        ctx->stats.tac_cse_reused = ctx->tac.cseReused;
+        ctx->stats.tac_cse_muldiv = ctx->tac.cseMulDiv;
+        ctx->stats.tac_dead_stores = ctx->tac.deadStores;
+        TRACE(&ctx->trace, TRACE_TAC, TRACE_INFO, "[MAIN] Intermediate code generation completed.\n");
+    }
+    else
+    {
+        TRACE(&ctx->trace, TRACE_TAC, TRACE_INFO, "[MAIN] Skipping intermediate code generation due to parse errors.\n");
+    }
+
+    TRACE(&ctx->trace, TRACE_TAC, TRACE_INFO, "\n=== BaiScript INTERMEDIATE CODE GENERATION ENDED ===\n\n");
+
+    // === STEP 4: TARGET CODE GENERATION ===
+    TRACE(&ctx->trace, TRACE_ASM, TRACE_INFO, "\n=== BaiScript TARGET CODE GENERATION ===\n\n");
+
+    if (sem_errors > 0)
+    {
+        TRACE(&ctx->trace, TRACE_ASM, TRACE_INFO, "[MAIN] Skipping target code generation due to semantic errors.\n");
+        // Error messages already written in semantic analysis step
+    }
+    else if (result == 0 && !ctx->parse_failed)
+    {
+        stats_begin(&ctx->stats, STATS_TARGET);
+        generate_target_code(ctx);
+        stats_end(&ctx->stats, STATS_TARGET);
+        ctx->stats.assembly_lines = ctx->target.assembly_code_count;
+        ctx->stats.data_slots = ctx->target.data_count;
+        ctx->stats.code_cycles = ctx->target.estimated_cycles;
+        ctx->stats.loads_saved = ctx->target.loads_saved;
+        ctx->stats.stores_saved = ctx->target.stores_saved;
+        TRACE(&ctx->trace, TRACE_ASM, TRACE_INFO, "[MAIN] Target code generation completed.\n");
+    }
+    else
+    {
+        TRACE(&ctx->trace, TRACE_ASM, TRACE_INFO, "[MAIN] Skipping target code generation due to parse errors.\n");
+    }
+
+    TRACE(&ctx->trace, TRACE_ASM, TRACE_INFO, "\n=== BaiScript TARGET CODE GENERATION ENDED ===\n\n");
+
+    // === STEP 5: MACHINE CODE GENERATION ===
+    TRACE(&ctx->trace, TRACE_MC, TRACE_INFO, "\n=== BaiScript MACHINE CODE GENERATION ===\n\n");
+
+    if (sem_errors > 0)
+    {
+        TRACE(&ctx->trace, TRACE_MC, TRACE_INFO, "[MAIN] Skipping machine code generation due to semantic errors.\n");
+        // Error messages already written in semantic analysis step
+    }
+    else if (result == 0 && !ctx->parse_failed)
+    {
+        stats_begin(&ctx->stats, STATS_MACHINE);
+        generate_machine_code(ctx);
+        stats_end(&ctx->stats, STATS_MACHINE);
+        ctx->stats.machine_words = ctx->machine.machine_code_count;
+    }
+    else
+    {
+        TRACE(&ctx->trace, TRACE_MC, TRACE_INFO, "[MAIN] Skipping machine code generation due to parse errors.\n");
+    }
+
+    TRACE(&ctx->trace, TRACE_MC, TRACE_INFO, "\n=== BaiScript MACHINE CODE GENERATION ENDED ===\n\n");
+
+    // === SYMBOL TABLE ===
+    stats_begin(&ctx->stats, STATS_REPORT);
+    TRACE(&ctx->trace, TRACE_SYMBOLS, TRACE_INFO, "\n=== BaiScript SYMBOL TABLE ===\n\n");
+    if (trace_on(&ctx->trace, TRACE_SYMBOLS, TRACE_FULL))
+        print_symbol_table(&ctx->trace, &ctx->symbols);
+
+    trace_flush(&ctx->trace);
+    stats_end(&ctx->stats, STATS_REPORT);
+
+    ctx->stats.names = ctx->names.count;
+    ctx->stats.symbols = (long)ctx->symbols.count;
+    return (result != 0 || ctx->parse_failed || sem_errors > 0) ? 1 : 0;
+}
+
+/* ----------------------------
+Drivers
+---------------------------- */
+
+int bai_compile_file(BaiCompiler *ctx, FILE *in)
+{
+    size_t len = 0, cap = 4096;
+    char *src = (char *)malloc(cap);
+    size_t n;
+
+    while (src && (n = fread(src + len, 1, cap - len, in)) > 0)
+    {
+        len += n;
+        if (len == cap)
+        {
+            char *grown = (char *)realloc(src, cap * 2);
+            if (!grown)
+            {
+                free(src);
+                src = NULL;
+                break;
+            }
+            src = grown;
+            cap *= 2;
+        }
+    }
+
+    if (!src)
+    {
+        fprintf(stderr, "Error: out of memory reading source\n");
+        return 1;
+    }
+
+    int failed = bai_compile_source(ctx, src, len);
+    free(src);
+
+    bai_save_outputs(ctx);
+    return failed;
+}
+
+void bai_take_artifacts(BaiCompiler *ctx, int failed, BaiArtifacts *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->failed = failed;
+
+    // output buffers change hands; ctx starts the next compile empty
+    for (int i = 0; i < BAI_OUT_COUNT; i++)
+    {
+        BaiBuffer *buf = &ctx->outputs[i];
+        out->outputs[i] = buf->data ? buf->data : strdup("");
+        out->output_lengths[i] = buf->len;
+        buf->data = NULL;
+        buf->len = buf->cap = 0;
+    }
+
+    out->diagnostics = ctx->diagnostics;
+    out->diagnostic_count = ctx->diagnostic_count;
+    ctx->diagnostics = NULL;
+    ctx->diagnostic_count = ctx->diagnostic_capacity = 0;
+
+    out->tac = ctx->tac.optimizedCode;
+    out->tac_count = ctx->tac.optimizedCode ? ctx->tac.optimizedCount : 0;
+    ctx->tac.optimizedCode = NULL;
+    ctx->tac.optimizedCount = 0;
+
+    // TAC operands are IDs into the intern table, which lives in the arena;
+    // copy the spellings into one block the caller can free
+    if (ctx->names.count > 0)
+    {
+        size_t bytes = ctx->names.count * sizeof(char *);
+        for (int i = 0; i < ctx->names.count; i++)
+            bytes += strlen(ctx->names.entries[i].name) + 1;
+
+        out->names = (char **)malloc(bytes);
+        if (out->names)
+        {
+            char *text = (char *)(out->names + ctx->names.count);
+            for (int i = 0; i < ctx->names.count; i++)
+            {
+                size_t n = strlen(ctx->names.entries[i].name) + 1;
+                memcpy(text, ctx->names.entries[i].name, n);
+                out->names[i] = text;
+                text += n;
+            }
+            out->name_count = ctx->names.count;
+        }
+    }
+
+    if (ctx->machine.machine_code_count > 0)
+    {
+        size_t bytes = ctx->machine.machine_code_count * sizeof(MachineCodeEntry);
+        out->machine_code = (MachineCodeEntry *)malloc(bytes);
+        if (out->machine_code)
+        {
+            memcpy(out->machine_code, ctx->machine.machine_code_list, bytes);
+            out->machine_code_count = ctx->machine.machine_code_count;
+        }
+    }
+}
+
+int bai_compile(const char *src, size_t len, BaiArtifacts *out)
+{
+    BaiCompiler *ctx = bai_compiler_new();
+    if (!ctx)
+    {
+        memset(out, 0, sizeof(*out));
+        out->failed = 1;
+        return 1;
+    }
+
+    int failed = bai_compile_source(ctx, src, len);
+    bai_take_artifacts(ctx, failed, out);
+    bai_compiler_free(ctx);
+    return failed;
+}
+
+void bai_artifacts_free(BaiArtifacts *out)
+{
+    if (!out)
+        return;
+
+    for (int i = 0; i < BAI_OUT_COUNT; i++)
+        free(out->outputs[i]);
+    for (int i = 0; i < out->diagnostic_count; i++)
+        free(out->diagnostics[i].message);
+    free(out->diagnostics);
+    free(out->tac);
+    free(out->names);
+    free(out->machine_code);
+    memset(out, 0, sizeof(*out));
+}
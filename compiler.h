@@ -0,0 +1,164 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "ast.h"
+#include "intern.h"
+#include "scanner.h"
+#include "trace.h"
+#include "stats.h"
+#include "symbol_table.h"
+#include "semantic_analyzer.h"
+#include "intermediate_code_generator.h"
+#include "target_code_generator.h"
+#include "machine_code_generator.h"
+
+/* ----------------------------
+Outputs
+
+Each phase writes into an in-memory buffer named after the output_*.txt
+file it used to write. bai_compile_file() saves them to disk afterwards;
+bai_compile() hands them back to the caller instead.
+---------------------------- */
+typedef enum
+{
+    BAI_OUT_PRINT,            /* output_print.txt: PRENT output, errors, warnings */
+    BAI_OUT_TAC,              /* output_tac.txt */
+    BAI_OUT_ASSEMBLY,         /* output_assembly.txt */
+    BAI_OUT_MACHINE_ASSEMBLY, /* output_machine_assembly.txt */
+    BAI_OUT_MACHINE_BIN,      /* output_machine_bin.txt */
+    BAI_OUT_MACHINE_HEX,      /* output_machine_hex.txt */
+    BAI_OUT_MACHINE,          /* output_machine.txt (legacy) */
+    BAI_OUT_COUNT
+} BaiOutput;
+
+typedef struct
+{
+    char *data;               /* always NUL-terminated once written */
+    size_t len;
+    size_t cap;
+} BaiBuffer;
+
+typedef enum
+{
+    BAI_DIAG_ERROR,
+    BAI_DIAG_WARNING
+} BaiSeverity;
+
+typedef struct
+{
+    BaiSeverity severity;
+    int line;                 /* 0 when the message has no source line */
+    char *message;
+} BaiDiagnostic;
+
+/* ----------------------------
+Compiler context
+
+Everything one compilation touches lives here: the scanner/parser flags,
+the AST, the symbol table and the state of every later phase. Nothing in
+the pipeline keeps file-scope state, so separate BaiCompiler objects can
+compile different programs on different threads at the same time.
+---------------------------- */
+typedef struct BaiCompiler
+{
+    /* lexer / parser */
+    Arena arena;         /* owns every interned spelling; reset per compile */
+    InternTable names;   /* identifier, literal, temp and constant IDs used by every phase */
+    AstTree ast;
+    AstRef root;
+    int islexerror;      /* first lexical/syntax error already reported */
+    int parse_failed;
+    int lineCount;       /* real line number per input line */
+    int fast_lexer;      /* scan with scanner.c instead of lex.l; kept across resets */
+    Scanner scan;        /* scanner.c state when fast_lexer is set */
+
+    /* console logging of every phase; levels survive resets */
+    BaiTrace trace;
+
+    /* per-phase timings and counters; stats.enabled survives resets */
+    BaiStats stats;
+
+    /* directory for the output_*.txt files (NULL or "" = current directory) */
+    const char *output_dir;
+
+    BaiBuffer outputs[BAI_OUT_COUNT];
+    BaiDiagnostic *diagnostics;
+    int diagnostic_count;
+    int diagnostic_capacity;
+
+    SymbolTable symbols;
+    SemanticState sem;
+    TACState tac;
+    TargetState target;
+    MachineState machine;
+} BaiCompiler;
+
+/* ----------------------------
+In-memory results of one compilation (see bai_compile)
+---------------------------- */
+typedef struct
+{
+    int failed;                          /* 1 on lexical/syntax/semantic errors */
+
+    char *outputs[BAI_OUT_COUNT];        /* text of each output_*.txt file */
+    size_t output_lengths[BAI_OUT_COUNT];
+
+    BaiDiagnostic *diagnostics;          /* errors and warnings, in report order */
+    int diagnostic_count;
+
+    TACInstruction *tac;                 /* optimized three-address code */
+    int tac_count;
+    char **names;                        /* spelling of each intern ID; TAC_VAR and TAC_IMM
+                                            operands index it, TAC_TEMP ones are "tempN" */
+    int name_count;
+
+    MachineCodeEntry *machine_code;      /* assembly line, binary and hex per instruction */
+    int machine_code_count;
+} BaiArtifacts;
+
+/* Allocate a zeroed context ready for bai_compile_file(), console trace off */
+BaiCompiler *bai_compiler_new(void);
+
+/* Release everything the last compilation allocated and make ctx reusable */
+void bai_compiler_reset(BaiCompiler *ctx);
+
+void bai_compiler_free(BaiCompiler *ctx);
+
+/* Run every phase over `len` bytes of source, keeping all results in ctx.
+   Returns 0 when the program compiled, 1 on lexical/syntax/semantic errors. */
+int bai_compile_source(BaiCompiler *ctx, const char *src, size_t len);
+
+/* Compile the source read from `in` and write the output_*.txt files */
+int bai_compile_file(BaiCompiler *ctx, FILE *in);
+
+/* Compile a source buffer without touching the filesystem. On return `out`
+   owns copies of every artifact; release them with bai_artifacts_free(). */
+int bai_compile(const char *src, size_t len, BaiArtifacts *out);
+
+/* Move the results of the last compilation in ctx into `out` */
+void bai_take_artifacts(BaiCompiler *ctx, int failed, BaiArtifacts *out);
+
+void bai_artifacts_free(BaiArtifacts *out);
+
+/* File name of an output buffer, e.g. "output_print.txt" */
+const char *bai_output_name(BaiOutput which);
+
+/* Output buffers: clear = reopen with "w", printf = append */
+void bai_output_clear(BaiCompiler *ctx, BaiOutput which);
+void bai_output_printf(BaiCompiler *ctx, BaiOutput which, const char *fmt, ...);
+void bai_output_vprintf(BaiCompiler *ctx, BaiOutput which, const char *fmt, va_list ap);
+
+/* Overwrite an output buffer with a single line */
+void bai_write_output(BaiCompiler *ctx, BaiOutput which, const char *msg);
+
+/* Write every output buffer to its file under ctx->output_dir */
+int bai_save_outputs(BaiCompiler *ctx);
+
+/* Record a structured error/warning next to the text written to BAI_OUT_PRINT */
+void bai_report(BaiCompiler *ctx, BaiSeverity severity, int line, const char *fmt, ...);
+
+#endif /* COMPILER_H */
@@ -205,101 +205,87 @@ app.on('window-all-closed', () => {
   if (process.platform !== 'darwin') app.quit();
 });
 
-// --------------------- IPC Handlers ---------------------
+// ----------------- Compiler server -----------------
+// main.exe --serve stays alive for the whole session. Each Run writes one
+// "<length>\n<source>" frame to its stdin and reads back one
+// "<length>\n<json>" frame, so there is no process start-up or temp-file I/O
+// per compile. Responses arrive in request order.
 
-ipcMain.handle('run-compiler', async (event, sourceCode) => {
-  return new Promise((resolve, reject) => {
-    try {
-      const isDev = process.env.NODE_ENV === 'development' || !app.isPackaged;
-
-      // Compiler executable path
-      const exePath = isDev
-        ? path.join(__dirname, '../main.exe')
-        : path.join(process.resourcesPath, 'main.exe');
-
-      console.log('Compiler executable path:', exePath);
-      console.log('File exists:', fs.existsSync(exePath));
-
-      // Folder to store input/output files
-      const tempDir = isDev ? path.join(__dirname, '..') : app.getPath('userData');
-
-      // File paths
-      const inputPath = path.join(tempDir, 'input.txt');
-      const outputPrintPath = path.join(tempDir, 'output_print.txt');
-      const outputAssemblyPath = path.join(tempDir, 'output_assembly.txt');
-      const outputMachineAssemblyPath = path.join(tempDir, 'output_machine_assembly.txt');
-      const outputMachineBinaryPath = path.join(tempDir, 'output_machine_bin.txt');
-      const outputMachineHexPath = path.join(tempDir, 'output_machine_hex.txt');
-
-      // Clean up previous output files before new compilation
-      const outputFiles = [
-        outputPrintPath,
-        outputAssemblyPath,
-        outputMachineAssemblyPath,
-        outputMachineBinaryPath,
-        outputMachineHexPath
-      ];
-
-      outputFiles.forEach(filePath => {
-        try {
-          if (fs.existsSync(filePath)) {
-            fs.unlinkSync(filePath);
-            console.log(`Cleaned up: ${filePath}`);
-          }
-        } catch (err) {
-          console.warn(`Could not delete ${filePath}:`, err.message);
-        }
-      });
-
-      // Write source code
-      fs.writeFileSync(inputPath, sourceCode, 'utf-8');
-
-      // Run compiler
-      const compilerProcess = spawn(exePath, [], {
-        cwd: tempDir,
-        stdio: ['pipe', 'pipe', 'pipe'],
-      });
-
-      let stdout = '';
-      let stderr = '';
-
-      compilerProcess.stdout.on('data', (data) => (stdout += data.toString()));
-      compilerProcess.stderr.on('data', (data) => (stderr += data.toString()));
-
-      compilerProcess.on('close', (code) => {
-        const safeRead = (filePath) => {
-          try {
-            return fs.existsSync(filePath) ? fs.readFileSync(filePath, 'utf-8') : '';
-          } catch (err) {
-            console.error(`Error reading ${filePath}:`, err);
-            return '';
-          }
-        };
-
-        resolve({
-          success: code === 0,
-          exitCode: code,
-          stdout,
-          stderr,
-          outputs: {
-            print: safeRead(outputPrintPath),
-            assembly: safeRead(outputAssemblyPath),
-            machine: {
-              assembly: safeRead(outputMachineAssemblyPath),
-              binary: safeRead(outputMachineBinaryPath),
-              hex: safeRead(outputMachineHexPath),
-            },
-          },
-        });
-      });
+let compilerServer = null;
+
+function getCompilerPath() {
+  const isDev = process.env.NODE_ENV === 'development' || !app.isPackaged;
+  return isDev
+    ? path.join(__dirname, '../main.exe')
+    : path.join(process.resourcesPath, 'main.exe');
+}
+
+function startCompilerServer() {
+  const exePath = getCompilerPath();
+  console.log('Starting compiler server:', exePath);
+
+  // stderr carries the compiler's phase logging; nothing reads it here
+  const proc = spawn(exePath, ['--serve'], { stdio: ['pipe', 'pipe', 'ignore'] });
+  const server = { proc, buffer: Buffer.alloc(0), pending: [] };
+
+  const failAll = (message) => {
+    if (compilerServer === server) compilerServer = null;
+    server.pending.splice(0).forEach(({ reject }) => reject({ success: false, error: message }));
+  };
+
+  proc.stdout.on('data', (chunk) => {
+    server.buffer = Buffer.concat([server.buffer, chunk]);
+
+    for (;;) {
+      const newline = server.buffer.indexOf(0x0a);
+      if (newline < 0) return;
+
+      const length = parseInt(server.buffer.subarray(0, newline).toString('ascii'), 10);
+      if (server.buffer.length < newline + 1 + length) return;
 
-      compilerProcess.on('error', (error) => {
-        reject({ success: false, error: error.message });
-      });
-    } catch (error) {
-      reject({ success: false, error: error.message });
+      const body = server.buffer.subarray(newline + 1, newline + 1 + length).toString('utf-8');
+      server.buffer = server.buffer.subarray(newline + 1 + length);
+
+      const request = server.pending.shift();
+      if (!request) continue;
+      try {
+        request.resolve(JSON.parse(body));
+      } catch (err) {
+        request.reject({ success: false, error: `Bad compiler response: ${err.message}` });
+      }
     }
   });
+
+  proc.on('error', (error) => failAll(error.message));
+  proc.on('exit', (code) => failAll(`Compiler server exited with code ${code}`));
+  proc.stdin.on('error', (error) => failAll(error.message));
+
+  return server;
+}
+
+function compileWithServer(sourceCode) {
+  if (!compilerServer) compilerServer = startCompilerServer();
+  const server = compilerServer;
+  const payload = Buffer.from(sourceCode, 'utf-8');
+
+  return new Promise((resolve, reject) => {
+    server.pending.push({ resolve, reject });
+    server.proc.stdin.write(`${payload.length}\n`);
+    server.proc.stdin.write(payload);
+  });
+}
+
+app.on('will-quit', () => {
+  if (compilerServer) {
+    compilerServer.proc.stdin.end();
+    compilerServer = null;
+  }
+});
+
+// --------------------- IPC Handlers ---------------------
+
+ipcMain.handle('run-compiler', async (event, sourceCode) => {
+  return compileWithServer(sourceCode);
 });
 
 // ----------------- Window Controls -----------------
@@ -5,369 +5,1009 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
 #include "intermediate_code_generator.h"
-
-static TACInstruction *code = NULL;
-TACInstruction *optimizedCode = NULL;
-static int codeCount = 0;
-int optimizedCount = 0;
-static int tempCount = 0;
+#include "compiler.h"
 
 // === Utilities ===
-TACInstruction *getOptimizedCode(int *count)
+TACInstruction *getOptimizedCode(BaiCompiler *ctx, int *count)
 {
     if (count)
-        *count = optimizedCount;
-    return optimizedCode;
+        *count = ctx->tac.optimizedCount;
+    return ctx->tac.optimizedCode;
 }
 
-static int is_char_literal(const char *s, char *out)
+static TACOperand newTemp(BaiCompiler *ctx)
 {
-    if (!s || !out)
-        return 0;
-    size_t len = strlen(s);
-    if (len >= 3 && s[0] == '\'' && s[len - 1] == '\'')
+    return tac_operand(TAC_TEMP, ctx->tac.tempCount++);
+}
+
+static TACOperand constant(BaiCompiler *ctx, long value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%ld", value);
+    return tac_operand(TAC_IMM, intern_str(&ctx->names, &ctx->arena, buf));
+}
+
+static TACOperand variable(int sym)
+{
+    return sym == INTERN_NONE ? TAC_NO_OPERAND : tac_operand(TAC_VAR, sym);
+}
+
+// Identifiers are variables; integer literals are constants
+static TACOperand leaf_operand(BaiCompiler *ctx, AstRef node)
+{
+    const AstTree *ast = &ctx->ast;
+    if (ast_kind(ast, node) == AST_LIT_CHAR)
+        return constant(ctx, (char)ast_lit(ast, node));
+
+    int sym = ast_sym(ast, node);
+    if (ast_type(ast, node) != NODE_IDENTIFIER && (intern_flags(&ctx->names, sym) & INTERN_NUMBER))
+        return tac_operand(TAC_IMM, sym);
+    return variable(sym);
+}
+
+static TACOp binary_op(AstOp op)
+{
+    switch (op)
     {
-        if (len == 3)
-        {
-            *out = s[1];
-            return 1;
-        }
-        if (len == 4 && s[1] == '\\')
-        {
-            switch (s[2])
-            {
-            case 'n':
-                *out = '\n';
-                return 1;
-            case 't':
-                *out = '\t';
-                return 1;
-            case 'r':
-                *out = '\r';
-                return 1;
-            case '0':
-                *out = '\0';
-                return 1;
-            case '\\':
-                *out = '\\';
-                return 1;
-            case '\'':
-                *out = '\'';
-                return 1;
-            case '"':
-                *out = '"';
-                return 1;
-            default:
-                return 0;
-            }
-        }
+    case AST_OP_ADD: return TAC_ADD;
+    case AST_OP_SUB: return TAC_SUB;
+    case AST_OP_MUL: return TAC_MUL;
+    case AST_OP_DIV: return TAC_DIV;
+    default:         return TAC_NOP;
     }
-    return 0;
 }
 
-static char *newTemp()
+static void emit(BaiCompiler *ctx, TACOperand result, TACOperand arg1, TACOp op, TACOperand arg2)
 {
-    char buf[32];
-    snprintf(buf, sizeof(buf), "temp%d", tempCount++);
-    return strdup(buf);
+    if (ctx->tac.codeCount == ctx->tac.codeCapacity)
+    {
+        int cap = ctx->tac.codeCapacity ? ctx->tac.codeCapacity * 2 : 256;
+        TACInstruction *tmp = realloc(ctx->tac.code, sizeof(TACInstruction) * cap);
+        if (!tmp)
+        {
+            fprintf(stderr, "Memory allocation failed in emit()\n");
+            exit(1);
+        }
+        ctx->tac.code = tmp;
+        ctx->tac.codeCapacity = cap;
+    }
+    TACInstruction *ins = &ctx->tac.code[ctx->tac.codeCount++];
+    ins->op = op;
+    ins->result = result;
+    ins->arg1 = arg1;
+    ins->arg2 = arg2;
 }
 
-static void emit(const char *result, const char *arg1, const char *op, const char *arg2)
+static void push_operand(BaiCompiler *ctx, TACOperand o)
 {
-    TACInstruction *tmp = realloc(code, sizeof(TACInstruction) * (codeCount + 1));
-    if (!tmp)
+    if (ctx->tac.operandCount == ctx->tac.operandCapacity)
     {
-        fprintf(stderr, "Memory allocation failed in emit()\n");
-        exit(1);
+        int cap = ctx->tac.operandCapacity ? ctx->tac.operandCapacity * 2 : 256;
+        TACOperand *tmp = realloc(ctx->tac.operands, cap * sizeof(TACOperand));
+        if (!tmp)
+        {
+            fprintf(stderr, "Memory allocation failed in push_operand()\n");
+            exit(1);
+        }
+        ctx->tac.operands = tmp;
+        ctx->tac.operandCapacity = cap;
     }
-    code = tmp;
-    snprintf(code[codeCount].result, sizeof(code[codeCount].result), "%s", result ? result : "");
-    snprintf(code[codeCount].arg1, sizeof(code[codeCount].arg1), "%s", arg1 ? arg1 : "");
-    snprintf(code[codeCount].op, sizeof(code[codeCount].op), "%s", op ? op : "");
-    snprintf(code[codeCount].arg2, sizeof(code[codeCount].arg2), "%s", arg2 ? arg2 : "");
-    codeCount++;
+    ctx->tac.operands[ctx->tac.operandCount++] = o;
 }
 
-static char *generateExpression(ASTNode *node, int used_in_expr)
+static TACOperand pop_operand(BaiCompiler *ctx)
 {
-    if (!node)
-        return NULL;
+    return ctx->tac.operands[--ctx->tac.operandCount];
+}
 
-    // Leaf node
-    if (!node->left && !node->right)
+// Progress through an expression node on the walk stack
+enum
+{
+    EXPR_ENTER,     // nothing generated yet
+    EXPR_LEFT,      // left (or only) operand is on the operand stack
+    EXPR_RIGHT      // both operands are on the operand stack
+};
+
+// Generates TAC for the expression at `root` and returns the operand
+// holding its value. The tree is walked with ctx->tac.walk instead of
+// recursion; each finished subexpression leaves its operand on
+// ctx->tac.operands for its parent.
+static TACOperand generateExpression(BaiCompiler *ctx, AstRef root, int used_in_expr)
+{
+    const AstTree *ast = &ctx->ast;
+    AstStack *walk = &ctx->tac.walk;
+    size_t base = walk->count;
+
+    ast_push(walk, root, EXPR_ENTER, used_in_expr);
+
+    while (walk->count > base)
     {
-        if (node->value)
+        AstFrame *f = &walk->frames[walk->count - 1];
+        AstRef node = f->node;
+        AstRef left = node ? ast_left(ast, node) : AST_NULL;
+        AstRef right = node ? ast_right(ast, node) : AST_NULL;
+        TACOperand result;
+
+        if (node == AST_NULL)
+            result = TAC_NO_OPERAND;
+
+        // Leaf node: identifiers and literals were interned by the scanner
+        else if (ast_is_leaf(ast, node))
+            result = leaf_operand(ctx, node);
+
+        // Assignment / compound assignment
+        else if (ast_type(ast, node) == NODE_ASSIGNMENT && left && right)
         {
-            char cval;
-            if (is_char_literal(node->value, &cval))
+            if (f->state == EXPR_ENTER)
             {
-                char buf[32];
-                snprintf(buf, sizeof(buf), "%d", (int)cval);
-                return strdup(buf);
+                f->state = EXPR_LEFT;
+                ast_push(walk, right, EXPR_ENTER, 1);
+                continue;
             }
-            return strdup(node->value);
+
+            TACOperand lhs = variable(ast_sym(ast, left));
+            TACOperand rhs = pop_operand(ctx);
+            if (rhs == TAC_NO_OPERAND)
+                rhs = constant(ctx, 0);
+
+            switch (ast_op(ast, node))
+            {
+            case AST_OP_ADD_ASSIGN:
+                emit(ctx, lhs, lhs, TAC_ADD, rhs);
+                break;
+            case AST_OP_SUB_ASSIGN:
+                emit(ctx, lhs, lhs, TAC_SUB, rhs);
+                break;
+            case AST_OP_MUL_ASSIGN:
+                emit(ctx, lhs, lhs, TAC_MUL, rhs);
+                break;
+            case AST_OP_DIV_ASSIGN:
+                emit(ctx, lhs, lhs, TAC_DIV, rhs);
+                break;
+            default:
+                emit(ctx, lhs, rhs, TAC_COPY, TAC_NO_OPERAND);
+                break;
+            }
+
+            result = lhs;
+        }
+
+        // Postfix ++ / --
+        else if (ast_type(ast, node) == NODE_POSTFIX_OP && left)
+        {
+            if (f->state == EXPR_ENTER)
+            {
+                f->state = EXPR_LEFT;
+                ast_push(walk, left, EXPR_ENTER, 1);
+                continue;
+            }
+
+            TACOperand var = pop_operand(ctx);
+
+            TACOperand tmp = f->aux ? newTemp(ctx) : var;
+
+            if (f->aux)
+                emit(ctx, tmp, var, TAC_COPY, TAC_NO_OPERAND);
+            if (ast_op(ast, node) == AST_OP_INC)
+                emit(ctx, var, var, TAC_ADD, constant(ctx, 1));
+            else if (ast_op(ast, node) == AST_OP_DEC)
+                emit(ctx, var, var, TAC_SUB, constant(ctx, 1));
+
+            result = tmp;
+        }
+
+        // Unary / prefix ++ / -- / + / -
+        else if (ast_type(ast, node) == NODE_UNARY_OP && left)
+        {
+            if (f->state == EXPR_ENTER)
+            {
+                f->state = EXPR_LEFT;
+                ast_push(walk, left, EXPR_ENTER, 1);
+                continue;
+            }
+
+            TACOperand opnd = pop_operand(ctx);
+
+            switch (ast_op(ast, node))
+            {
+            case AST_OP_INC:
+                emit(ctx, opnd, opnd, TAC_ADD, constant(ctx, 1));
+                result = opnd;
+                break;
+            case AST_OP_DEC:
+                emit(ctx, opnd, opnd, TAC_SUB, constant(ctx, 1));
+                result = opnd;
+                break;
+            case AST_OP_SUB:
+                result = newTemp(ctx);
+                emit(ctx, result, constant(ctx, 0), TAC_SUB, opnd);
+                break;
+            default:
+                result = opnd;
+                break;
+            }
+        }
+
+        // Binary operation
+        else if (left && right)
+        {
+            if (f->state == EXPR_ENTER)
+            {
+                f->state = EXPR_LEFT;
+                ast_push(walk, left, EXPR_ENTER, 1);
+                continue;
+            }
+            if (f->state == EXPR_LEFT)
+            {
+                f->state = EXPR_RIGHT;
+                ast_push(walk, right, EXPR_ENTER, 1);
+                continue;
+            }
+
+            TACOperand right_val = pop_operand(ctx);
+            TACOperand left_val = pop_operand(ctx);
+            result = newTemp(ctx);
+            emit(ctx, result, left_val, binary_op(ast_op(ast, node)), right_val);
         }
-        return strdup("");
-    }
 
-    // Assignment / compound assignment
-    if (node->type == NODE_ASSIGNMENT && node->left && node->right)
-    {
-        char *lhs = strdup(node->left->value);
-        char *rhs = generateExpression(node->right, 1);
-        if (!rhs)
-            rhs = strdup("0");
-
-        if (strcmp(node->value, "+=") == 0)
-            emit(lhs, lhs, "+", rhs);
-        else if (strcmp(node->value, "-=") == 0)
-            emit(lhs, lhs, "-", rhs);
-        else if (strcmp(node->value, "*=") == 0)
-            emit(lhs, lhs, "*", rhs);
-        else if (strcmp(node->value, "/=") == 0)
-            emit(lhs, lhs, "/", rhs);
         else
-            emit(lhs, rhs, "=", NULL);
+            result = TAC_NO_OPERAND;
 
-        free(lhs);
-        free(rhs);
-        return strdup(node->left->value);
+        walk->count--;
+        push_operand(ctx, result);
     }
 
-    // Postfix ++ / --
-    if (node->type == NODE_POSTFIX_OP && node->left)
+    return pop_operand(ctx);
+}
+
+// === Declaration List Generator ===
+static void generateDeclarationList(BaiCompiler *ctx, AstRef root)
+{
+    const AstTree *ast = &ctx->ast;
+    AstStack *walk = &ctx->tac.walk;
+    size_t base = walk->count;
+
+    ast_push(walk, root, 0, 0);
+
+    while (walk->count > base)
     {
-        char *var = generateExpression(node->left, 1);
+        AstRef node = walk->frames[--walk->count].node;
 
-        char *tmp = used_in_expr ? newTemp() : strdup(var);
+        if (node == AST_NULL)
+            continue;
 
-        if (used_in_expr)
-            emit(tmp, var, "=", NULL);
-        if (strcmp(node->value, "++") == 0)
-            emit(var, var, "+", "1");
-        else if (strcmp(node->value, "--") == 0)
-            emit(var, var, "-", "1");
+        if (ast_type(ast, node) == NODE_DECLARATION && ast_kind(ast, node) == AST_DECL_INIT)
+        {
+            AstRef init = ast_right(ast, node);
+            TACOperand rhs = init ? generateExpression(ctx, init, 1) : constant(ctx, 0);
+            emit(ctx, variable(ast_sym(ast, ast_left(ast, node))), rhs, TAC_COPY, TAC_NO_OPERAND);
+            continue;
+        }
 
-        free(var);
-        return tmp;
+        ast_push(walk, ast_right(ast, node), 0, 0);
+        ast_push(walk, ast_left(ast, node), 0, 0);
     }
+}
+
+// Walks the statement list front to back; declarations inside statements
+// go through generateDeclarationList
+static void generateCode(BaiCompiler *ctx, AstRef root)
+{
+    const AstTree *ast = &ctx->ast;
+    AstStack *walk = &ctx->tac.walk;
+    size_t base = walk->count;
+
+    ast_push(walk, root, 0, 0);
 
-    // Unary / prefix ++ / -- / + / -
-    if (node->type == NODE_UNARY_OP && node->left)
+    while (walk->count > base)
     {
-        char *opnd = generateExpression(node->left, 1);
+        AstRef node = walk->frames[--walk->count].node;
 
-        if (strcmp(node->value, "++") == 0)
+        if (node == AST_NULL)
+            continue;
+
+        switch (ast_type(ast, node))
         {
-            emit(opnd, opnd, "+", "1");
-            return used_in_expr ? opnd : strdup(opnd);
-        }
-        if (strcmp(node->value, "--") == 0)
+        case NODE_START:
+            ast_push(walk, ast_left(ast, node), 0, 0);
+            break;
+
+        case NODE_STATEMENT_LIST:
+            ast_push(walk, ast_right(ast, node), 0, 0);
+            ast_push(walk, ast_left(ast, node), 0, 0);
+            break;
+
+        case NODE_STATEMENT:
         {
-            emit(opnd, opnd, "-", "1");
-            return used_in_expr ? opnd : strdup(opnd);
+            AstRef stmt = ast_left(ast, node);
+            if (stmt == AST_NULL)
+                break;
+
+            // If the statement is a declaration, generate it
+            if (ast_type(ast, stmt) == NODE_DECLARATION)
+                generateDeclarationList(ctx, stmt);
+            else
+                generateExpression(ctx, stmt, 0); // normal expression/assignment
+            break;
         }
-        if (strcmp(node->value, "-") == 0)
+
+        case NODE_DECLARATION:
+            generateDeclarationList(ctx, node);
+            break;
+
+        case NODE_ASSIGNMENT:
+        case NODE_EXPRESSION:
+        case NODE_POSTFIX_OP:
+        case NODE_UNARY_OP:
+            generateExpression(ctx, node, 1);
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+// === Optimization ===
+#define SOURCE_SELF (-1)     // instruction is kept as it is
+#define SOURCE_DROPPED (-2)  // temp definition folded into its copy
+
+// Folds "tempN = a op b" into a later "x = tempN" when that copy is the
+// temp's only use and neither a nor b is written in between, giving
+// "x = a op b" where the copy was. Three linear passes: def/use counts
+// per temp, the forwarding decisions (with the last write of every
+// variable so far), then the rewrite.
+static void removeRedundantTemporaries(BaiCompiler *ctx)
+{
+    int n = ctx->tac.codeCount;
+    int temps = ctx->tac.tempCount;
+    int names = ctx->names.count;
+
+    if (n == 0)
+    {
+        ctx->tac.optimizedCode = NULL;
+        ctx->tac.optimizedCount = 0;
+        return;
+    }
+    ctx->tac.optimizedCode = malloc(sizeof(TACInstruction) * n);
+    int *scratch = malloc(sizeof(int) * ((size_t)temps * 3 + (size_t)names + (size_t)n));
+    if (!ctx->tac.optimizedCode || !scratch)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    int *uses = scratch;                // reads of each temp
+    int *defs = uses + temps;           // writes of each temp
+    int *def_at = defs + temps;         // index of the last write
+    int *last_write = def_at + temps;   // per variable: last instruction writing it so far
+    int *source = last_write + names;   // per instruction: SOURCE_* or the definition it takes over
+
+    memset(uses, 0, sizeof(int) * (size_t)temps * 2);
+    for (int v = 0; v < names; v++)
+        last_write[v] = -1;
+
+    const TACInstruction *code = ctx->tac.code;
+    for (int i = 0; i < n; i++)
+    {
+        if (tac_kind(code[i].result) == TAC_TEMP)
         {
-            char *tmp = newTemp();
-            emit(tmp, "0", "-", opnd);
-            free(opnd);
-            return tmp;
+            defs[tac_id(code[i].result)]++;
+            def_at[tac_id(code[i].result)] = i;
         }
-        if (strcmp(node->value, "+") == 0)
+        if (tac_kind(code[i].arg1) == TAC_TEMP)
+            uses[tac_id(code[i].arg1)]++;
+        if (tac_kind(code[i].arg2) == TAC_TEMP)
+            uses[tac_id(code[i].arg2)]++;
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        const TACInstruction *copy = &code[k];
+        source[k] = SOURCE_SELF;
+
+        if (copy->op == TAC_COPY && tac_kind(copy->arg1) == TAC_TEMP)
         {
-            return opnd;
+            int t = tac_id(copy->arg1);
+            int d = def_at[t];
+
+            if (uses[t] == 1 && defs[t] == 1 && d < k && source[d] == SOURCE_SELF &&
+                (tac_kind(code[d].arg1) != TAC_VAR || last_write[tac_id(code[d].arg1)] < d) &&
+                (tac_kind(code[d].arg2) != TAC_VAR || last_write[tac_id(code[d].arg2)] < d))
+            {
+                source[k] = d;
+                source[d] = SOURCE_DROPPED;
+            }
         }
-        return opnd;
+
+        if (tac_kind(copy->result) == TAC_VAR)
+            last_write[tac_id(copy->result)] = k;
     }
 
-    // Binary operation
-    if (node->left && node->right)
+    int j = 0;
+    for (int i = 0; i < n; i++)
     {
-        char *left_val = generateExpression(node->left, 1);
-        char *right_val = generateExpression(node->right, 1);
-        char *tmp = newTemp();
-        emit(tmp, left_val, node->value, right_val);
-        free(left_val);
-        free(right_val);
-        return tmp;
+        if (source[i] == SOURCE_DROPPED)
+            continue;
+        if (source[i] == SOURCE_SELF)
+            ctx->tac.optimizedCode[j++] = code[i];
+        else
+        {
+            ctx->tac.optimizedCode[j] = code[source[i]];
+            ctx->tac.optimizedCode[j++].result = code[i].result;
+        }
     }
+    ctx->tac.optimizedCount = j;
+    free(scratch);
+}
 
-    return strdup(node->value ? node->value : "");
+// === Constant propagation ===
+// BaiScript has no branches, so the TAC is one basic block and its SSA
+// form needs no phi nodes: renaming a name at each assignment amounts to
+// linking every use to the one definition that reaches it. reaching[]
+// holds that definition (an instruction index) for each variable and
+// temp as the walk goes, and every instruction gets one lattice cell for
+// the value it defines, constant or varying. Nothing is ever undefined
+// along the single path, so one forward pass reaches the fixed point.
+//
+// Constants are folded the way the target computes them, and folding is
+// skipped where that would trap or overflow. A constant is only written
+// back into an instruction when daddiu can load it (16-bit signed).
+
+#define REACH_ENTRY (-1)    // no definition yet: the value at program start
+
+typedef struct
+{
+    int known;
+    int64_t value;
+} TACValue;
+
+static int fits_immediate(int64_t v)
+{
+    return v >= -32768 && v <= 32767;
 }
 
-// === Declaration List Generator ===
-static void generateDeclarationList(ASTNode *node)
+static int immediate_value(BaiCompiler *ctx, TACOperand o, int64_t *out)
 {
-    if (!node)
-        return;
+    const char *text = intern_name(&ctx->names, tac_id(o));
+    char *end;
+
+    errno = 0;
+    long long v = strtoll(text, &end, 10);
+    if (errno || end == text || *end)
+        return 0;
+    *out = v;
+    return 1;
+}
 
-    if (node->type == NODE_DECLARATION && node->value && strcmp(node->value, "INIT_DECL") == 0)
+static int fold(TACOp op, int64_t a, int64_t b, int64_t *out)
+{
+    switch (op)
     {
-        char *ident = strdup(node->left->value);
-        char *rhs = node->right ? generateExpression(node->right, 1) : strdup("0");
-        emit(ident, rhs, "=", NULL);
-        free(rhs);
-        free(ident);
-        return;
+    case TAC_ADD:
+        if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b))
+            return 0;
+        *out = a + b;
+        return 1;
+    case TAC_SUB:
+        if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b))
+            return 0;
+        *out = a - b;
+        return 1;
+    case TAC_MUL:
+        if (a > 0 ? (b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a)
+                  : (b > 0 ? a < INT64_MIN / b : (a != 0 && b < INT64_MAX / a)))
+            return 0;
+        *out = a * b;
+        return 1;
+    case TAC_DIV:
+        if (b == 0 || (a == INT64_MIN && b == -1))
+            return 0;
+        *out = a / b;   // truncates toward zero, as ddiv does
+        return 1;
+    default:
+        return 0;
     }
-
-    generateDeclarationList(node->left);
-    generateDeclarationList(node->right);
 }
 
-// Updated generateCode to correctly handle declarations inside statements
-static void generateCode(ASTNode *node)
+static void propagateConstants(BaiCompiler *ctx)
 {
-    if (!node)
+    int n = ctx->tac.optimizedCount;
+    int temps = ctx->tac.tempCount;
+    int names = ctx->names.count;
+    TACInstruction *code = ctx->tac.optimizedCode;
+
+    if (n == 0)
         return;
 
-    switch (node->type)
+    TACValue *values = malloc(sizeof(TACValue) * n);
+    int *scratch = malloc(sizeof(int) * ((size_t)names + (size_t)temps * 3));
+    if (!values || !scratch)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    int *reaching_var = scratch;                // per variable: its current definition
+    int *reaching_temp = reaching_var + names;  // per temp: its definition
+    int *uses_before = reaching_temp + temps;   // reads of each temp before and after rewriting
+    int *uses_after = uses_before + temps;
+
+    for (int v = 0; v < names; v++)
+        reaching_var[v] = REACH_ENTRY;
+    for (int t = 0; t < temps; t++)
+        reaching_temp[t] = REACH_ENTRY;
+    memset(uses_before, 0, sizeof(int) * (size_t)temps * 2);
+
+    for (int i = 0; i < n; i++)
     {
-    case NODE_START:
-        generateCode(node->left);
-        break;
+        TACInstruction *ins = &code[i];
+        TACOperand *args[2] = {&ins->arg1, &ins->arg2};
+        TACValue arg[2] = {{0, 0}, {0, 0}};
 
-    case NODE_STATEMENT_LIST:
-        generateCode(node->left);
-        generateCode(node->right);
-        break;
+        for (int k = 0; k < 2; k++)
+        {
+            TACOperand o = *args[k];
+            int def = REACH_ENTRY;
 
-    case NODE_STATEMENT:
-        if (!node->left)
-            break;
+            if (tac_kind(o) == TAC_TEMP)
+            {
+                uses_before[tac_id(o)]++;
+                def = reaching_temp[tac_id(o)];
+            }
+            else if (tac_kind(o) == TAC_VAR)
+                def = reaching_var[tac_id(o)];
+            else if (tac_kind(o) == TAC_IMM)
+                arg[k].known = immediate_value(ctx, o, &arg[k].value);
 
-        // If the statement is a declaration, generate it
-        if (node->left->type == NODE_DECLARATION)
-            generateDeclarationList(node->left);
-        else
-            generateExpression(node->left, 0); // normal expression/assignment
-        break;
+            if (def != REACH_ENTRY && values[def].known)
+            {
+                arg[k] = values[def];
+                if (fits_immediate(arg[k].value))
+                    *args[k] = constant(ctx, (long)arg[k].value);
+            }
+        }
 
-    case NODE_DECLARATION:
-        generateDeclarationList(node);
-        break;
+        values[i].known = 0;
+        if (ins->op == TAC_COPY)
+            values[i] = arg[0];
+        else if (arg[0].known && arg[1].known && fold(ins->op, arg[0].value, arg[1].value, &values[i].value))
+        {
+            values[i].known = 1;
+            if (fits_immediate(values[i].value))
+            {
+                ins->op = TAC_COPY;
+                ins->arg1 = constant(ctx, (long)values[i].value);
+                ins->arg2 = TAC_NO_OPERAND;
+            }
+        }
 
-    case NODE_ASSIGNMENT:
-    case NODE_EXPRESSION:
-    case NODE_POSTFIX_OP:
-    case NODE_UNARY_OP:
-    {
-        char *res = generateExpression(node, 1);
-        if (res)
-            free(res);
+        if (tac_kind(ins->result) == TAC_TEMP)
+            reaching_temp[tac_id(ins->result)] = i;
+        else if (tac_kind(ins->result) == TAC_VAR)
+            reaching_var[tac_id(ins->result)] = i;
     }
-    break;
 
-    default:
-        break;
+    // A temp whose every read became a constant is no longer needed
+    for (int i = 0; i < n; i++)
+    {
+        if (tac_kind(code[i].arg1) == TAC_TEMP)
+            uses_after[tac_id(code[i].arg1)]++;
+        if (tac_kind(code[i].arg2) == TAC_TEMP)
+            uses_after[tac_id(code[i].arg2)]++;
     }
+    int j = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int t = tac_id(code[i].result);
+        if (tac_kind(code[i].result) == TAC_TEMP && uses_before[t] > 0 && uses_after[t] == 0)
+            continue;
+        code[j++] = code[i];
+    }
+    ctx->tac.optimizedCount = j;
+
+    free(values);
+    free(scratch);
 }
 
-// === Optimization ===
-static void removeRedundantTemporaries()
+// === Value numbering ===
+// Gives every computed value a number, so that "a * b" computed twice
+// with the same numbers for a and b is recognised. Writes to a variable
+// (plain, compound, ++ and --) give it a new number, which is what stops
+// a stale match. A repeated computation becomes a copy from a variable
+// that still holds the value or, failing that, a read of the temp that
+// computed it. Keeping a temp for longer keeps its register busy, so that
+// is only done within CSE_WINDOW instructions of the temp's definition
+// and while fewer than CSE_MAX_LIVE_TEMPS temps are live.
+
+#define CSE_WINDOW 64
+#define CSE_MAX_LIVE_TEMPS 16
+
+typedef struct
+{
+    TACOp op;
+    int left, right;    // value numbers of the operands
+    int value;          // -1 = empty slot
+} ValueEntry;
+
+static int value_of(int *numbers, int id, int *next, int *holder_var, int is_var)
 {
-    if (codeCount == 0)
+    if (numbers[id] < 0)
     {
-        optimizedCode = NULL;
-        optimizedCount = 0;
-        return;
+        numbers[id] = (*next)++;
+        if (is_var)
+            holder_var[numbers[id]] = id;   // a variable holds its own initial value
     }
-    optimizedCode = malloc(sizeof(TACInstruction) * codeCount);
-    if (!optimizedCode)
+    return numbers[id];
+}
+
+static void numberValues(BaiCompiler *ctx)
+{
+    int n = ctx->tac.optimizedCount;
+    int temps = ctx->tac.tempCount;
+    int names = ctx->names.count;
+    TACInstruction *code = ctx->tac.optimizedCode;
+
+    ctx->tac.cseReused = 0;
+    ctx->tac.cseMulDiv = 0;
+    if (n == 0)
+        return;
+
+    size_t slots = 16;
+    while (slots < (size_t)n * 2)
+        slots *= 2;
+    int max_values = names + n + 1;
+
+    int *scratch = malloc(sizeof(int) * ((size_t)names + (size_t)temps * 4 + (size_t)max_values * 2 + (size_t)n + 1));
+    ValueEntry *table = malloc(sizeof(ValueEntry) * slots);
+    char *removed = calloc(n, 1);
+    if (!scratch || !table || !removed)
     {
         fprintf(stderr, "Out of memory\n");
         exit(1);
     }
+    int *name_value = scratch;                  // per variable or constant: its current value number
+    int *temp_value = name_value + names;       // per temp: its value number
+    int *rename = temp_value + temps;           // per temp: the temp to read instead, or -1
+    int *def_at = rename + temps;               // per temp: its definition
+    int *end_at = def_at + temps;               // per temp: its last read (n - 1 if never read)
+    int *holder_var = end_at + temps;           // per value: last variable given it
+    int *holder_temp = holder_var + max_values; // per value: the temp that computed it
+    int *live = holder_temp + max_values;       // per instruction: temps live across it
+
+    for (int v = 0; v < names; v++)
+        name_value[v] = -1;
+    for (int t = 0; t < temps; t++)
+        temp_value[t] = rename[t] = def_at[t] = end_at[t] = -1;
+    for (int v = 0; v < max_values; v++)
+        holder_var[v] = holder_temp[v] = -1;
+    for (size_t s = 0; s < slots; s++)
+        table[s].value = -1;
+
+    // Temp lifetimes as generated: live after the definition up to the
+    // last read, or to the end when never read (its register is not freed)
+    memset(live, 0, sizeof(int) * ((size_t)n + 1));
+    for (int i = 0; i < n; i++)
+    {
+        if (tac_kind(code[i].result) == TAC_TEMP)
+            def_at[tac_id(code[i].result)] = i;
+        if (tac_kind(code[i].arg1) == TAC_TEMP)
+            end_at[tac_id(code[i].arg1)] = i;
+        if (tac_kind(code[i].arg2) == TAC_TEMP)
+            end_at[tac_id(code[i].arg2)] = i;
+    }
+    for (int t = 0; t < temps; t++)
+    {
+        if (def_at[t] < 0)
+            continue;
+        if (end_at[t] < def_at[t])
+            end_at[t] = n - 1;
+        live[def_at[t] + 1]++;
+        live[end_at[t] + 1]--;
+    }
+    for (int i = 1; i <= n; i++)
+        live[i] += live[i - 1];
 
-    int j = 0;
-    for (int i = 0; i < codeCount; i++)
+    int next = 0;
+    for (int i = 0; i < n; i++)
     {
-        TACInstruction *cur = &code[i];
-        int inlined = 0;
+        TACInstruction *ins = &code[i];
+        int operand_value[2] = {-1, -1};
+        TACOperand *args[2] = {&ins->arg1, &ins->arg2};
+
+        for (int k = 0; k < 2; k++)
+        {
+            TACOperand o = *args[k];
+            if (tac_kind(o) == TAC_TEMP && rename[tac_id(o)] >= 0)
+                *args[k] = o = tac_operand(TAC_TEMP, rename[tac_id(o)]);
+
+            if (tac_kind(o) == TAC_TEMP)
+                operand_value[k] = value_of(temp_value, tac_id(o), &next, holder_var, 0);
+            else if (tac_kind(o) != TAC_NONE)
+                operand_value[k] = value_of(name_value, tac_id(o), &next, holder_var, tac_kind(o) == TAC_VAR);
+        }
 
-        // Only consider temp assignments
-        if (strncmp(cur->result, "temp", 4) == 0)
+        int value;
+        if (ins->op == TAC_COPY)
+            value = operand_value[0];
+        else if (ins->op == TAC_NOP)
+            value = next++;
+        else
         {
-            // Look ahead for single-use assignment of this temp
-            for (int k = i + 1; k < codeCount; k++)
+            int left = operand_value[0], right = operand_value[1];
+            if ((ins->op == TAC_ADD || ins->op == TAC_MUL) && left > right)
+            {
+                int swap = left;
+                left = right;
+                right = swap;
+            }
+
+            size_t s = ((unsigned)ins->op * 0x9E3779B1u ^ (unsigned)left * 0x85EBCA77u ^ (unsigned)right * 0xC2B2AE3Du) & (slots - 1);
+            while (table[s].value >= 0 && !(table[s].op == ins->op && table[s].left == left && table[s].right == right))
+                s = (s + 1) & (slots - 1);
+
+            if (table[s].value < 0)
+            {
+                table[s].op = ins->op;
+                table[s].left = left;
+                table[s].right = right;
+                table[s].value = value = next++;
+            }
+            else
             {
-                TACInstruction *next = &code[k];
+                value = table[s].value;
+
+                int var = holder_var[value];
+                int temp = holder_temp[value];
+                int reused = 0;
 
-                // Pattern: next->arg1 uses tempX, and next is simple assignment
-                if (strcmp(next->arg1, cur->result) == 0 && strcmp(next->op, "=") == 0)
+                if (var >= 0 && name_value[var] == value)
                 {
-                    // Replace next instruction: target = original temp expression
-                    snprintf(optimizedCode[j].result, sizeof(optimizedCode[j].result), "%s", next->result);
-                    snprintf(optimizedCode[j].arg1, sizeof(optimizedCode[j].arg1), "%s", cur->arg1);
-                    snprintf(optimizedCode[j].op, sizeof(optimizedCode[j].op), "%s", cur->op);
-                    snprintf(optimizedCode[j].arg2, sizeof(optimizedCode[j].arg2), "%s", cur->arg2);
-
-                    j++;
-                    inlined = 1;
-                    i = k; // skip temp and next assignment
-                    break;
+                    ins->op = TAC_COPY;
+                    ins->arg1 = variable(var);
+                    ins->arg2 = TAC_NO_OPERAND;
+                    reused = 1;
+                }
+                else if (temp >= 0)
+                {
+                    int result_temp = tac_kind(ins->result) == TAC_TEMP ? tac_id(ins->result) : -1;
+                    int until = result_temp >= 0 ? end_at[result_temp] : i;
+                    int fits = until - def_at[temp] <= CSE_WINDOW;
+
+                    for (int p = end_at[temp] + 1; fits && p <= until; p++)
+                        fits = live[p] < CSE_MAX_LIVE_TEMPS;
+                    if (fits)
+                    {
+                        for (int p = end_at[temp] + 1; p <= until; p++)
+                            live[p]++;
+                        if (until > end_at[temp])
+                            end_at[temp] = until;
+
+                        // a temp result is read through the earlier temp instead
+                        if (result_temp >= 0)
+                        {
+                            rename[result_temp] = temp;
+                            removed[i] = 1;
+                        }
+                        else
+                        {
+                            ins->op = TAC_COPY;
+                            ins->arg1 = tac_operand(TAC_TEMP, temp);
+                            ins->arg2 = TAC_NO_OPERAND;
+                        }
+                        reused = 1;
+                    }
+                }
+
+                if (reused)
+                {
+                    ctx->tac.cseReused++;
+                    if (table[s].op == TAC_MUL || table[s].op == TAC_DIV)
+                        ctx->tac.cseMulDiv++;
                 }
             }
         }
 
-        if (!inlined)
-            optimizedCode[j++] = *cur;
+        if (removed[i])
+            continue;
+        if (tac_kind(ins->result) == TAC_VAR)
+        {
+            name_value[tac_id(ins->result)] = value;
+            holder_var[value] = tac_id(ins->result);
+        }
+        else if (tac_kind(ins->result) == TAC_TEMP)
+        {
+            temp_value[tac_id(ins->result)] = value;
+            if (holder_temp[value] < 0)
+                holder_temp[value] = tac_id(ins->result);
+        }
     }
-    optimizedCount = j;
+
+    int j = 0;
+    for (int i = 0; i < n; i++)
+        if (!removed[i])
+            code[j++] = code[i];
+    ctx->tac.optimizedCount = j;
+
+    free(scratch);
+    free(table);
+    free(removed);
+}
+
+// === Dead stores ===
+// Backward liveness over the block. When the program ends, every
+// variable that keeps a .data slot is live: the ones the analyzer marks
+// `used` (PRENT items set it too) and every one the code reads anywhere,
+// which covers ++x and --x since they do not set `used`. Their final
+// values stay in memory. A write to a variable or temp that is not live
+// at that point is never read and is deleted; TAC has no other effects.
+static void eliminateDeadStores(BaiCompiler *ctx)
+{
+    int n = ctx->tac.optimizedCount;
+    int temps = ctx->tac.tempCount;
+    int names = ctx->names.count;
+    TACInstruction *code = ctx->tac.optimizedCode;
+
+    ctx->tac.deadStores = 0;
+    if (n == 0)
+        return;
+
+    char *live = malloc((size_t)names + (size_t)temps + (size_t)n);
+    if (!live)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    char *live_temp = live + names;
+    char *dead = live_temp + temps;
+
+    memset(live, 0, (size_t)names + (size_t)temps);
+    for (size_t s = 0; s < ctx->symbols.count; s++)
+        live[ctx->symbols.entries[s].sym] = ctx->symbols.entries[s].used;
+    for (int i = 0; i < n; i++)
+    {
+        if (tac_kind(code[i].arg1) == TAC_VAR)
+            live[tac_id(code[i].arg1)] = 1;
+        if (tac_kind(code[i].arg2) == TAC_VAR)
+            live[tac_id(code[i].arg2)] = 1;
+    }
+
+    for (int i = n - 1; i >= 0; i--)
+    {
+        const TACInstruction *ins = &code[i];
+        char *written = tac_kind(ins->result) == TAC_VAR    ? &live[tac_id(ins->result)]
+                        : tac_kind(ins->result) == TAC_TEMP ? &live_temp[tac_id(ins->result)]
+                                                            : NULL;
+
+        dead[i] = written && !*written;
+        if (dead[i])
+        {
+            ctx->tac.deadStores++;
+            continue;
+        }
+        if (written)
+            *written = 0;
+
+        const TACOperand args[2] = {ins->arg1, ins->arg2};
+        for (int k = 0; k < 2; k++)
+        {
+            if (tac_kind(args[k]) == TAC_VAR)
+                live[tac_id(args[k])] = 1;
+            else if (tac_kind(args[k]) == TAC_TEMP)
+                live_temp[tac_id(args[k])] = 1;
+        }
+    }
+
+    int j = 0;
+    for (int i = 0; i < n; i++)
+        if (!dead[i])
+            code[j++] = code[i];
+    ctx->tac.optimizedCount = j;
+
+    free(live);
 }
 
 // === Display ===
-static void displayTAC()
+const char *tac_op_text(TACOp op)
 {
-    printf("===== INTERMEDIATE CODE (TAC) =====\n");
-    for (int i = 0; i < codeCount; i++)
+    switch (op)
     {
-        TACInstruction *inst = &code[i];
-        if (strcmp(inst->op, "=") == 0 && strlen(inst->arg2) == 0)
-            printf("%s = %s\n", inst->result, inst->arg1);
-        else if (strlen(inst->op) == 0)
-            printf("%s = %s\n", inst->result, inst->arg1);
-        else
-            printf("%s = %s %s %s\n", inst->result, inst->arg1, inst->op, inst->arg2);
+    case TAC_COPY: return "=";
+    case TAC_ADD:  return "+";
+    case TAC_SUB:  return "-";
+    case TAC_MUL:  return "*";
+    case TAC_DIV:  return "/";
+    default:       return "";
+    }
+}
+
+const char *tac_operand_text(BaiCompiler *ctx, TACOperand o, char *buf, size_t size)
+{
+    switch (tac_kind(o))
+    {
+    case TAC_NONE:
+        return "";
+    case TAC_TEMP:
+        snprintf(buf, size, "temp%d", tac_id(o));
+        return buf;
+    default:
+        return intern_name(&ctx->names, tac_id(o));
     }
-    printf("===== INTERMEDIATE CODE (TAC) END =====\n\n");
 }
 
-static void displayOptimizedTAC()
+static void displayInstructions(BaiCompiler *ctx, const TACInstruction *code, int count)
 {
-    printf("===== OPTIMIZED CODE =====\n");
-    for (int i = 0; i < optimizedCount; i++)
+    char result_buf[16], arg1_buf[16], arg2_buf[16];
+
+    for (int i = 0; i < count; i++)
     {
-        TACInstruction *inst = &optimizedCode[i];
-        if (strcmp(inst->op, "=") == 0 && strlen(inst->arg2) == 0)
-            printf("%s = %s\n", inst->result, inst->arg1);
-        else if (strlen(inst->op) == 0)
-            printf("%s = %s\n", inst->result, inst->arg1);
+        const TACInstruction *inst = &code[i];
+        const char *result = tac_operand_text(ctx, inst->result, result_buf, sizeof(result_buf));
+        const char *arg1 = tac_operand_text(ctx, inst->arg1, arg1_buf, sizeof(arg1_buf));
+        if (inst->op == TAC_COPY || inst->op == TAC_NOP)
+            trace_printf(&ctx->trace, "%s = %s\n", result, arg1);
         else
-            printf("%s = %s %s %s\n", inst->result, inst->arg1, inst->op, inst->arg2);
+            trace_printf(&ctx->trace, "%s = %s %s %s\n", result, arg1, tac_op_text(inst->op),
+                         tac_operand_text(ctx, inst->arg2, arg2_buf, sizeof(arg2_buf)));
     }
-    printf("===== OPTIMIZED CODE END =====\n\n");
+}
+
+static void displayTAC(BaiCompiler *ctx)
+{
+    trace_printf(&ctx->trace, "===== INTERMEDIATE CODE (TAC) =====\n");
+    displayInstructions(ctx, ctx->tac.code, ctx->tac.codeCount);
+    trace_printf(&ctx->trace, "===== INTERMEDIATE CODE (TAC) END =====\n\n");
+}
+
+static void displayOptimizedTAC(BaiCompiler *ctx)
+{
+    trace_printf(&ctx->trace, "===== OPTIMIZED CODE =====\n");
+    displayInstructions(ctx, ctx->tac.optimizedCode, ctx->tac.optimizedCount);
+    if (ctx->tac.cseReused)
+        trace_printf(&ctx->trace, "; value numbering: %d computation(s) reused, %d multiply/divide\n",
+                     ctx->tac.cseReused, ctx->tac.cseMulDiv);
+    if (ctx->tac.deadStores)
+        trace_printf(&ctx->trace, "; dead stores: %d removed\n", ctx->tac.deadStores);
+    trace_printf(&ctx->trace, "===== OPTIMIZED CODE END =====\n\n");
 }
 
 // === Public Interface ===
-void generate_intermediate_code(ASTNode *root)
+void tac_cleanup(BaiCompiler *ctx)
+{
+    if (ctx->tac.code)
+        free(ctx->tac.code);
+    if (ctx->tac.optimizedCode)
+        free(ctx->tac.optimizedCode);
+    ctx->tac.code = NULL;
+    ctx->tac.optimizedCode = NULL;
+    ctx->tac.codeCount = 0;
+    ctx->tac.codeCapacity = 0;
+    ctx->tac.optimizedCount = 0;
+    ctx->tac.tempCount = 0;
+    ctx->tac.cseReused = 0;
+    ctx->tac.cseMulDiv = 0;
+    ctx->tac.deadStores = 0;
+
+    ast_stack_free(&ctx->tac.walk);
+    free(ctx->tac.operands);
+    ctx->tac.operands = NULL;
+    ctx->tac.operandCount = 0;
+    ctx->tac.operandCapacity = 0;
+}
+
+void generate_intermediate_code(BaiCompiler *ctx, AstRef root)
 {
-    if (code)
-        free(code);
-    if (optimizedCode)
-        free(optimizedCode);
-    code = NULL;
-    optimizedCode = NULL;
-    codeCount = 0;
-    optimizedCount = 0;
-    tempCount = 0;
-
-    if (root)
-        generateCode(root);
-
-    displayTAC();
-    removeRedundantTemporaries();
-    displayOptimizedTAC();
+    tac_cleanup(ctx);
+
+    if (root != AST_NULL)
+        generateCode(ctx, root);
+
+    if (trace_on(&ctx->trace, TRACE_TAC, TRACE_FULL))
+        displayTAC(ctx);
+    removeRedundantTemporaries(ctx);
+    propagateConstants(ctx);
+    numberValues(ctx);
+    eliminateDeadStores(ctx);
+    if (trace_on(&ctx->trace, TRACE_TAC, TRACE_FULL))
+        displayOptimizedTAC(ctx);
 }
@@ -5,24 +5,85 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
 #include "ast.h"
+#include "intern.h"
 #include "symbol_table.h"
 
+// Operation of a TAC instruction
+typedef enum
+{
+    TAC_NOP,        // result = arg1 with an operator the generator does not know
+    TAC_COPY,       // result = arg1
+    TAC_ADD,        // result = arg1 + arg2
+    TAC_SUB,
+    TAC_MUL,
+    TAC_DIV
+} TACOp;
+
+// What an operand refers to
+typedef enum
+{
+    TAC_NONE,       // empty operand
+    TAC_VAR,        // a variable (or string literal); id is its intern ID
+    TAC_TEMP,       // a generated temporary; id is its number N, printed "tempN"
+    TAC_IMM         // a constant; id is the intern ID of its spelling, kept as written
+} TACKind;
+
+// Kind in the top two bits, id in the other 30; 0 is the empty operand
+typedef uint32_t TACOperand;
+
+#define TAC_NO_OPERAND 0u
+
+static inline TACOperand tac_operand(TACKind kind, int id) { return ((uint32_t)kind << 30) | ((uint32_t)id & 0x3FFFFFFFu); }
+static inline TACKind tac_kind(TACOperand o) { return (TACKind)(o >> 30); }
+static inline int tac_id(TACOperand o) { return (int)(o & 0x3FFFFFFFu); }
+
+// 16 bytes
 typedef struct
 {
-    char result[64];
-    char arg1[64];
-    char op[16];
-    char arg2[64];
+    TACOp op;
+    TACOperand result;
+    TACOperand arg1;
+    TACOperand arg2;
 } TACInstruction;
 
-extern TACInstruction *optimizedCode;
-extern int optimizedCount;
+// TAC buffers for one compilation (owned by BaiCompiler)
+typedef struct
+{
+    TACInstruction *code;
+    int codeCount;
+    int codeCapacity;
+    TACInstruction *optimizedCode;
+    int optimizedCount;
+    int tempCount;
+
+    // value numbering: repeated computations replaced, and how many of
+    // those were multiplies or divides
+    int cseReused;
+    int cseMulDiv;
+
+    // writes liveness found are never read
+    int deadStores;
+
+    // expression walk: pending nodes and finished operands
+    AstStack walk;
+    TACOperand *operands;
+    int operandCount;
+    int operandCapacity;
+} TACState;
+
+typedef struct BaiCompiler BaiCompiler;
+
+void generate_intermediate_code(BaiCompiler *ctx, AstRef root);
+TACInstruction *getOptimizedCode(BaiCompiler *ctx, int *count);
+void tac_cleanup(BaiCompiler *ctx);
 
-// Forward declare ASTNode to avoid circular includes
-typedef struct ASTNode ASTNode;
+// "+", "-", ... as printed in TAC listings; "=" for a copy
+const char *tac_op_text(TACOp op);
 
-void generate_intermediate_code(ASTNode *root);
-TACInstruction *getOptimizedCode(int *count);
+// Spelling of an operand: a variable or constant as written, "tempN" for
+// temps, "" for none. `buf` (at least 16 bytes) holds temp names.
+const char *tac_operand_text(BaiCompiler *ctx, TACOperand o, char *buf, size_t size);
 
 #endif // INTERMEDIATE_CODE_GENERATOR_H
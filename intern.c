@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "intern.h"
+
+static unsigned hash_bytes(const char *s, size_t len)
+{
+    // FNV-1a
+    unsigned h = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int all_digits(const char *s)
+{
+    if (!*s)
+        return 0;
+    for (; *s; s++)
+        if (!isdigit((unsigned char)*s))
+            return 0;
+    return 1;
+}
+
+static int classify(const char *s)
+{
+    return all_digits(*s == '-' ? s + 1 : s) ? INTERN_NUMBER : 0;
+}
+
+static void out_of_memory(void)
+{
+    fprintf(stderr, "Memory allocation failed for intern table.\n");
+    exit(EXIT_FAILURE);
+}
+
+static void rebuild_slots(InternTable *t, size_t slot_count)
+{
+    int *slots = (int *)malloc(slot_count * sizeof(int));
+    if (!slots)
+        out_of_memory();
+    memset(slots, 0xff, slot_count * sizeof(int));
+
+    for (int id = 0; id < t->count; id++)
+    {
+        size_t i = t->entries[id].hash & (slot_count - 1);
+        while (slots[i] != INTERN_NONE)
+            i = (i + 1) & (slot_count - 1);
+        slots[i] = id;
+    }
+
+    free(t->slots);
+    t->slots = slots;
+    t->slot_count = slot_count;
+}
+
+int intern(InternTable *t, Arena *arena, const char *s, size_t len)
+{
+    unsigned h = hash_bytes(s, len);
+
+    if (t->slot_count)
+    {
+        size_t i = h & (t->slot_count - 1);
+        for (int id; (id = t->slots[i]) != INTERN_NONE; i = (i + 1) & (t->slot_count - 1))
+        {
+            const InternEntry *e = &t->entries[id];
+            if (e->hash == h && strncmp(e->name, s, len) == 0 && e->name[len] == '\0')
+                return id;
+        }
+    }
+
+    if (t->count >= t->capacity)
+    {
+        int cap = t->capacity ? t->capacity * 2 : 256;
+        InternEntry *entries = (InternEntry *)realloc(t->entries, cap * sizeof(InternEntry));
+        if (!entries)
+            out_of_memory();
+        t->entries = entries;
+        t->capacity = cap;
+    }
+
+    int id = t->count++;
+    InternEntry *e = &t->entries[id];
+    e->name = arena_strndup(arena, s, len);
+    e->hash = h;
+    e->flags = classify(e->name);
+
+    // keep the load factor at or below one half
+    if ((size_t)t->count * 2 > t->slot_count)
+        rebuild_slots(t, t->slot_count ? t->slot_count * 2 : 512);
+    else
+    {
+        size_t i = h & (t->slot_count - 1);
+        while (t->slots[i] != INTERN_NONE)
+            i = (i + 1) & (t->slot_count - 1);
+        t->slots[i] = id;
+    }
+
+    return id;
+}
+
+int intern_str(InternTable *t, Arena *arena, const char *s)
+{
+    return intern(t, arena, s, strlen(s));
+}
+
+const char *intern_name(const InternTable *t, int id)
+{
+    return id == INTERN_NONE ? "" : t->entries[id].name;
+}
+
+int intern_flags(const InternTable *t, int id)
+{
+    return id == INTERN_NONE ? 0 : t->entries[id].flags;
+}
+
+void intern_reset(InternTable *t)
+{
+    t->count = 0;
+    if (t->slots)
+        memset(t->slots, 0xff, t->slot_count * sizeof(int));
+}
+
+void intern_free(InternTable *t)
+{
+    free(t->entries);
+    free(t->slots);
+    t->entries = NULL;
+    t->slots = NULL;
+    t->count = t->capacity = 0;
+    t->slot_count = 0;
+}
@@ -0,0 +1,51 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include "arena.h"
+
+/* ----------------------------
+Name intern table
+
+Maps each distinct spelling to a dense integer ID (0, 1, 2, ...). The
+scanner interns every identifier as it is read, and the TAC generator
+interns the temps and constants it creates. From then on every phase
+compares and indexes by ID; the text is only looked up for printing.
+Strings live in the compiler's arena, so the table is dropped with it.
+---------------------------- */
+
+#define INTERN_NONE (-1)
+
+/* Spelling classes, worked out once when a name is first interned */
+#define INTERN_NUMBER 0x1  /* optional '-' followed by digits only */
+
+typedef struct
+{
+    const char *name;   /* arena-owned, NUL-terminated */
+    unsigned hash;
+    int flags;          /* INTERN_* classes */
+} InternEntry;
+
+typedef struct
+{
+    InternEntry *entries;   /* indexed by ID */
+    int count;
+    int capacity;
+
+    int *slots;             /* open-addressing index of entry IDs, -1 = empty */
+    size_t slot_count;      /* power of two */
+} InternTable;
+
+/* Returns the ID for s[0..len), adding it on first sight */
+int intern(InternTable *t, Arena *arena, const char *s, size_t len);
+int intern_str(InternTable *t, Arena *arena, const char *s);
+
+/* Text and classes of an ID; INTERN_NONE reads as "" with no classes */
+const char *intern_name(const InternTable *t, int id);
+int intern_flags(const InternTable *t, int id);
+
+/* Forget every name (the strings go with the arena); keeps the buffers */
+void intern_reset(InternTable *t);
+void intern_free(InternTable *t);
+
+#endif /* INTERN_H */
@@ -1,66 +1,26 @@
+
 /* A lexical scanner generated by flex */
 
 /* Scanner skeleton version:
  * $Header: /home/daffy/u0/vern/flex/RCS/flex.skl,v 2.91 96/09/10 16:58:48 vern Exp $
+ *
+ * Reentrant variant (%option reentrant bison-bridge): every piece of scanner
+ * state lives in struct yyguts_t and is reached through the yyscan_t handle,
+ * so independent scanners can run on separate threads.
  */
 
 #define FLEX_SCANNER
 #define YY_FLEX_MAJOR_VERSION 2
 #define YY_FLEX_MINOR_VERSION 5
+#define YY_REENTRANT 1
+#define YY_BISON_BRIDGE 1
 
 #include <stdio.h>
-
-
-/* cfront 1.2 defines "c_plusplus" instead of "__cplusplus" */
-#ifdef c_plusplus
-#ifndef __cplusplus
-#define __cplusplus
-#endif
-#endif
-
-
-#ifdef __cplusplus
-
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
-/* Use prototypes in function declarations. */
-#define YY_USE_PROTOS
-
-/* The "const" storage-class-modifier is valid. */
-#define YY_USE_CONST
-
-#else	/* ! __cplusplus */
-
-#if __STDC__
-
-#define YY_USE_PROTOS
-#define YY_USE_CONST
-
-#endif	/* __STDC__ */
-#endif	/* ! __cplusplus */
-
-#ifdef __TURBOC__
- #pragma warn -rch
- #pragma warn -use
-#include <io.h>
-#include <stdlib.h>
-#define YY_USE_CONST
-#define YY_USE_PROTOS
-#endif
-
-#ifdef YY_USE_CONST
 #define yyconst const
-#else
-#define yyconst
-#endif
-
-
-#ifdef YY_USE_PROTOS
-#define YY_PROTO(proto) proto
-#else
-#define YY_PROTO(proto) ()
-#endif
 
 /* Returned upon end-of-file. */
 #define YY_NULL 0
@@ -72,34 +32,51 @@
  */
 #define YY_SC_TO_UI(c) ((unsigned int) (unsigned char) c)
 
+/* An opaque pointer to the scanner state. */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+/* For convenience, these vars (plus the bison vars far below)
+ * are macros in the reentrant scanner.
+ */
+#define yyin yyg->yyin_r
+#define yyout yyg->yyout_r
+#define yyextra yyg->yyextra_r
+#define yyleng yyg->yyleng_r
+#define yytext yyg->yytext_r
+#define yylineno yyg->yylineno_r
+
 /* Enter a start condition.  This macro really ought to take a parameter,
  * but we do it the disgusting crufty way forced on us by the ()-less
  * definition of BEGIN.
  */
-#define BEGIN yy_start = 1 + 2 *
+#define BEGIN yyg->yy_start = 1 + 2 *
 
 /* Translate the current start state into a value that can be later handed
  * to BEGIN to return to the state.  The YYSTATE alias is for lex
  * compatibility.
  */
-#define YY_START ((yy_start - 1) / 2)
+#define YY_START ((yyg->yy_start - 1) / 2)
 #define YYSTATE YY_START
 
 /* Action number for EOF rule of a given start state. */
 #define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
 
 /* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE yyrestart( yyin )
+#define YY_NEW_FILE yyrestart( yyin, yyscanner )
 
 #define YY_END_OF_BUFFER_CHAR 0
 
 /* Size of default input buffer. */
 #define YY_BUF_SIZE 16384
 
-typedef struct yy_buffer_state *YY_BUFFER_STATE;
+/* The state buf must be large enough to hold one state per character in the main buffer.
+ */
+#define YY_STATE_BUF_SIZE   ((YY_BUF_SIZE + 2) * sizeof(yy_state_type))
 
-extern int yyleng;
-extern FILE *yyin, *yyout;
+typedef struct yy_buffer_state *YY_BUFFER_STATE;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -125,20 +102,16 @@ extern FILE *yyin, *yyout;
 	do \
 		{ \
 		/* Undo effects of setting up yytext. */ \
-		*yy_cp = yy_hold_char; \
+		*yy_cp = yyg->yy_hold_char; \
 		YY_RESTORE_YY_MORE_OFFSET \
-		yy_c_buf_p = yy_cp = yy_bp + n - YY_MORE_ADJ; \
+		yyg->yy_c_buf_p = yy_cp = yy_bp + n - YY_MORE_ADJ; \
 		YY_DO_BEFORE_ACTION; /* set up yytext again */ \
 		} \
 	while ( 0 )
 
-#define unput(c) yyunput( c, yytext_ptr )
+#define unput(c) yyunput( c, yyg->yytext_ptr, yyscanner )
 
-/* The following is because we cannot portably get our hands on size_t
- * (without autoconf's help, which isn't available because we want
- * flex-generated scanners to compile on their own).
- */
-typedef unsigned int yy_size_t;
+typedef size_t yy_size_t;
 
 
 struct yy_buffer_state
@@ -198,96 +171,71 @@ struct yy_buffer_state
 #define YY_BUFFER_EOF_PENDING 2
 	};
 
-static YY_BUFFER_STATE yy_current_buffer = 0;
-
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
  * "scanner state".
  */
-#define YY_CURRENT_BUFFER yy_current_buffer
-
-
-/* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-
-
-int yyleng;
-
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 1;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
-
-/* Flag which is used to allow yywrap()'s to do buffer switches
- * instead of setting up a fresh yyin.  A bit of a hack ...
- */
-static int yy_did_buffer_switch_on_eof;
+#define YY_CURRENT_BUFFER yyg->yy_current_buffer
 
-void yyrestart YY_PROTO(( FILE *input_file ));
+void yyrestart ( FILE *input_file , yyscan_t yyscanner );
 
-void yy_switch_to_buffer YY_PROTO(( YY_BUFFER_STATE new_buffer ));
-void yy_load_buffer_state YY_PROTO(( void ));
-YY_BUFFER_STATE yy_create_buffer YY_PROTO(( FILE *file, int size ));
-void yy_delete_buffer YY_PROTO(( YY_BUFFER_STATE b ));
-void yy_init_buffer YY_PROTO(( YY_BUFFER_STATE b, FILE *file ));
-void yy_flush_buffer YY_PROTO(( YY_BUFFER_STATE b ));
-#define YY_FLUSH_BUFFER yy_flush_buffer( yy_current_buffer )
+void yy_switch_to_buffer ( YY_BUFFER_STATE new_buffer , yyscan_t yyscanner );
+void yy_load_buffer_state ( yyscan_t yyscanner );
+YY_BUFFER_STATE yy_create_buffer ( FILE *file, int size , yyscan_t yyscanner );
+void yy_delete_buffer ( YY_BUFFER_STATE b , yyscan_t yyscanner );
+void yy_init_buffer ( YY_BUFFER_STATE b, FILE *file , yyscan_t yyscanner );
+void yy_flush_buffer ( YY_BUFFER_STATE b , yyscan_t yyscanner );
+#define YY_FLUSH_BUFFER yy_flush_buffer( yyg->yy_current_buffer , yyscanner )
 
-YY_BUFFER_STATE yy_scan_buffer YY_PROTO(( char *base, yy_size_t size ));
-YY_BUFFER_STATE yy_scan_string YY_PROTO(( yyconst char *yy_str ));
-YY_BUFFER_STATE yy_scan_bytes YY_PROTO(( yyconst char *bytes, int len ));
+YY_BUFFER_STATE yy_scan_buffer ( char *base, yy_size_t size , yyscan_t yyscanner );
+YY_BUFFER_STATE yy_scan_string ( yyconst char *yy_str , yyscan_t yyscanner );
+YY_BUFFER_STATE yy_scan_bytes ( yyconst char *bytes, int len , yyscan_t yyscanner );
 
-static void *yy_flex_alloc YY_PROTO(( yy_size_t ));
-static void *yy_flex_realloc YY_PROTO(( void *, yy_size_t ));
-static void yy_flex_free YY_PROTO(( void * ));
+static void *yy_flex_alloc ( yy_size_t , yyscan_t yyscanner );
+static void *yy_flex_realloc ( void *, yy_size_t , yyscan_t yyscanner );
+static void yy_flex_free ( void * , yyscan_t yyscanner );
 
 #define yy_new_buffer yy_create_buffer
 
 #define yy_set_interactive(is_interactive) \
 	{ \
-	if ( ! yy_current_buffer ) \
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	yy_current_buffer->yy_is_interactive = is_interactive; \
+	if ( ! yyg->yy_current_buffer ) \
+		yyg->yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner ); \
+	yyg->yy_current_buffer->yy_is_interactive = is_interactive; \
 	}
 
 #define yy_set_bol(at_bol) \
 	{ \
-	if ( ! yy_current_buffer ) \
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	yy_current_buffer->yy_at_bol = at_bol; \
+	if ( ! yyg->yy_current_buffer ) \
+		yyg->yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner ); \
+	yyg->yy_current_buffer->yy_at_bol = at_bol; \
 	}
 
-#define YY_AT_BOL() (yy_current_buffer->yy_at_bol)
+#define YY_AT_BOL() (yyg->yy_current_buffer->yy_at_bol)
 
 
 #define YY_USES_REJECT
 
-#define yywrap() 1
+#define yywrap(yyscanner) 1
 #define YY_SKIP_YYWRAP
 typedef unsigned char YY_CHAR;
-FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
 typedef int yy_state_type;
-extern int yylineno;
-int yylineno = 1;
-extern char *yytext;
-#define yytext_ptr yytext
+#define yytext_ptr yytext_r
 
-static yy_state_type yy_get_previous_state YY_PROTO(( void ));
-static yy_state_type yy_try_NUL_trans YY_PROTO(( yy_state_type current_state ));
-static int yy_get_next_buffer YY_PROTO(( void ));
-static void yy_fatal_error YY_PROTO(( yyconst char msg[] ));
+static yy_state_type yy_get_previous_state ( yyscan_t yyscanner );
+static yy_state_type yy_try_NUL_trans ( yy_state_type current_state , yyscan_t yyscanner );
+static int yy_get_next_buffer ( yyscan_t yyscanner );
+static void yy_fatal_error ( yyconst char msg[] , yyscan_t yyscanner );
 
 /* Done after the current pattern has been matched and before the
  * corresponding action - sets up yytext.
  */
 #define YY_DO_BEFORE_ACTION \
-	yytext_ptr = yy_bp; \
+	yyg->yytext_ptr = yy_bp; \
 	yyleng = (int) (yy_cp - yy_bp); \
-	yy_hold_char = *yy_cp; \
+	yyg->yy_hold_char = *yy_cp; \
 	*yy_cp = '\0'; \
-	yy_c_buf_p = yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
 
 #define YY_NUM_RULES 33
 #define YY_END_OF_BUFFER 34
@@ -415,20 +363,16 @@ static yyconst short int yy_chk[114] =
        66,   66,   66
     } ;
 
-static yy_state_type yy_state_buf[YY_BUF_SIZE + 2], *yy_state_ptr;
-static char *yy_full_match;
-static int yy_lp;
 #define REJECT \
 { \
-*yy_cp = yy_hold_char; /* undo effects of setting up yytext */ \
-yy_cp = yy_full_match; /* restore poss. backed-over text */ \
-++yy_lp; \
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */ \
+yy_cp = yyg->yy_full_match; /* restore poss. backed-over text */ \
+++yyg->yy_lp; \
 goto find_rule; \
 }
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
 #line 1 "lex.l"
 #define INITIAL 0
 #line 2 "lex.l"
@@ -436,60 +380,116 @@ char *yytext;
 #include <stdlib.h>
 #include <string.h>
 #include "ast.h"
+#include "compiler.h"
 #include "yacc.tab.h"
 
-// Add this line so lex knows about the global parse_failed
-extern int parse_failed;
-extern int lineCount;
-extern void yyerror(const char *s);
+/* one line per token on the lex trace channel */
+#define LEX_TRACE(...) TRACE(&yyextra->trace, TRACE_LEX, TRACE_FULL, __VA_ARGS__)
 #define COMMENT 1
+#line 390 "lex.yy.c"
+
+#define YY_EXTRA_TYPE BaiCompiler *
+
+/* Holds the entire state of the reentrant scanner. */
+struct yyguts_t
+	{
+
+	/* User-defined. Not touched by flex. */
+	YY_EXTRA_TYPE yyextra_r;
+
+	/* The rest are the same as the globals declared in the non-reentrant scanner. */
+	FILE *yyin_r, *yyout_r;
+	YY_BUFFER_STATE yy_current_buffer;
+	char yy_hold_char;
+	int yy_n_chars;			/* number of characters read into yy_ch_buf */
+	int yyleng_r;
+	char *yy_c_buf_p;		/* points to current character in buffer */
+	int yy_init;			/* whether we need to initialize */
+	int yy_start;			/* start state number */
+
+	/* Flag which is used to allow yywrap()'s to do buffer switches
+	 * instead of setting up a fresh yyin.  A bit of a hack ...
+	 */
+	int yy_did_buffer_switch_on_eof;
+
+	int yy_start_stack_ptr;
+	int yy_start_stack_depth;
+	int *yy_start_stack;
+
+	yy_state_type *yy_state_buf;
+	yy_size_t yy_state_buf_max;	/* number of states yy_state_buf holds */
+	yy_state_type *yy_state_ptr;
+	char *yy_full_match;
+	int yy_lp;
+
+	int yylineno_r;
+
+	char *yytext_r;
+
+	YYSTYPE * yylval_r;
+
+	}; /* end struct yyguts_t */
+
+static int yy_init_globals ( yyscan_t yyscanner );
+
+    /* This must go here because YYSTYPE and YYLTYPE are included
+     * from bison output in section 1.*/
+    #    define yylval yyg->yylval_r
+
+int yylex_init ( yyscan_t* scanner );
 
-#line 448 "lex.yy.c"
+int yylex_init_extra ( YY_EXTRA_TYPE user_defined, yyscan_t* scanner );
+
+/* Accessor methods to globals.
+   These are made visible to non-reentrant scanners for convenience. */
+
+int yylex_destroy ( yyscan_t yyscanner );
+
+YY_EXTRA_TYPE yyget_extra ( yyscan_t yyscanner );
+
+void yyset_extra ( YY_EXTRA_TYPE user_defined , yyscan_t yyscanner );
+
+FILE *yyget_in ( yyscan_t yyscanner );
+
+void yyset_in  ( FILE * _in_str , yyscan_t yyscanner );
+
+FILE *yyget_out ( yyscan_t yyscanner );
+
+void yyset_out  ( FILE * _out_str , yyscan_t yyscanner );
+
+int yyget_leng ( yyscan_t yyscanner );
+
+char *yyget_text ( yyscan_t yyscanner );
+
+int yyget_lineno ( yyscan_t yyscanner );
+
+void yyset_lineno ( int _line_number , yyscan_t yyscanner );
+
+YYSTYPE * yyget_lval ( yyscan_t yyscanner );
+
+void yyset_lval ( YYSTYPE * yylval_param , yyscan_t yyscanner );
 
 /* Macros after this point can all be overridden by user definitions in
  * section 1.
  */
 
-#ifndef YY_SKIP_YYWRAP
-#ifdef __cplusplus
-extern "C" int yywrap YY_PROTO(( void ));
-#else
-extern int yywrap YY_PROTO(( void ));
-#endif
-#endif
-
 #ifndef YY_NO_UNPUT
-static void yyunput YY_PROTO(( int c, char *buf_ptr ));
-#endif
-
-#ifndef yytext_ptr
-static void yy_flex_strncpy YY_PROTO(( char *, yyconst char *, int ));
-#endif
-
-#ifdef YY_NEED_STRLEN
-static int yy_flex_strlen YY_PROTO(( yyconst char * ));
+static void yyunput ( int c, char *buf_ptr , yyscan_t yyscanner );
 #endif
 
 #ifndef YY_NO_INPUT
-#ifdef __cplusplus
-static int yyinput YY_PROTO(( void ));
-#else
-static int input YY_PROTO(( void ));
-#endif
+static int input ( yyscan_t yyscanner );
 #endif
 
 #if YY_STACK_USED
-static int yy_start_stack_ptr = 0;
-static int yy_start_stack_depth = 0;
-static int *yy_start_stack = 0;
 #ifndef YY_NO_PUSH_STATE
-static void yy_push_state YY_PROTO(( int new_state ));
+static void yy_push_state ( int new_state , yyscan_t yyscanner );
 #endif
 #ifndef YY_NO_POP_STATE
-static void yy_pop_state YY_PROTO(( void ));
+static void yy_pop_state ( yyscan_t yyscanner );
 #endif
 #ifndef YY_NO_TOP_STATE
-static int yy_top_state YY_PROTO(( void ));
+static int yy_top_state ( yyscan_t yyscanner );
 #endif
 
 #else
@@ -498,21 +498,6 @@ static int yy_top_state YY_PROTO(( void ));
 #define YY_NO_TOP_STATE 1
 #endif
 
-#ifdef YY_MALLOC_DECL
-YY_MALLOC_DECL
-#else
-#if __STDC__
-#ifndef __cplusplus
-#include <stdlib.h>
-#endif
-#else
-/* Just try to get by without declaring the routines.  This will fail
- * miserably on non-ANSI systems for which sizeof(size_t) != sizeof(int)
- * or sizeof(void*) != sizeof(int).
- */
-#endif
-#endif
-
 /* Amount of stuff to slurp up with each read. */
 #ifndef YY_READ_BUF_SIZE
 #define YY_READ_BUF_SIZE 8192
@@ -532,7 +517,7 @@ YY_MALLOC_DECL
  */
 #ifndef YY_INPUT
 #define YY_INPUT(buf,result,max_size) \
-	if ( yy_current_buffer->yy_is_interactive ) \
+	if ( yyg->yy_current_buffer->yy_is_interactive ) \
 		{ \
 		int c = '*', n; \
 		for ( n = 0; n < max_size && \
@@ -564,15 +549,21 @@ YY_MALLOC_DECL
 
 /* Report a fatal error. */
 #ifndef YY_FATAL_ERROR
-#define YY_FATAL_ERROR(msg) yy_fatal_error( msg )
+#define YY_FATAL_ERROR(msg) yy_fatal_error( msg , yyscanner )
 #endif
 
 /* Default declaration of generated scanner - a define so the user can
  * easily add parameters.
  */
 #ifndef YY_DECL
-#define YY_DECL int yylex YY_PROTO(( void ))
-#endif
+#define YY_DECL_IS_OURS 1
+
+extern int yylex \
+               (YYSTYPE * yylval_param , yyscan_t yyscanner);
+
+#define YY_DECL int yylex \
+               (YYSTYPE * yylval_param , yyscan_t yyscanner)
+#endif /* !YY_DECL */
 
 /* Code executed at the beginning of each rule, after yytext and yyleng
  * have been set up.
@@ -594,22 +585,34 @@ YY_DECL
 	register yy_state_type yy_current_state;
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+#line 21 "lex.l"
 
-#line 19 "lex.l"
 
+#line 594 "lex.yy.c"
 
-#line 602 "lex.yy.c"
+	yylval = yylval_param;
 
-	if ( yy_init )
+	if ( yyg->yy_init )
 		{
-		yy_init = 0;
+		yyg->yy_init = 0;
 
 #ifdef YY_USER_INIT
 		YY_USER_INIT;
 #endif
 
-		if ( ! yy_start )
-			yy_start = 1;	/* first start state */
+		/* Create the reject buffer large enough to save one state per allowed character. */
+		if ( ! yyg->yy_state_buf )
+			{
+			yyg->yy_state_buf = (yy_state_type *)yy_flex_alloc( YY_STATE_BUF_SIZE , yyscanner );
+			yyg->yy_state_buf_max = YY_BUF_SIZE + 2;
+			}
+		if ( ! yyg->yy_state_buf )
+			YY_FATAL_ERROR( "out of dynamic memory in yylex()" );
+
+		if ( ! yyg->yy_start )
+			yyg->yy_start = 1;	/* first start state */
 
 		if ( ! yyin )
 			yyin = stdin;
@@ -617,28 +620,28 @@ YY_DECL
 		if ( ! yyout )
 			yyout = stdout;
 
-		if ( ! yy_current_buffer )
-			yy_current_buffer =
-				yy_create_buffer( yyin, YY_BUF_SIZE );
+		if ( ! yyg->yy_current_buffer )
+			yyg->yy_current_buffer =
+				yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner );
 
-		yy_load_buffer_state();
+		yy_load_buffer_state( yyscanner );
 		}
 
 	while ( 1 )		/* loops until end-of-file is reached */
 		{
-		yy_cp = yy_c_buf_p;
+		yy_cp = yyg->yy_c_buf_p;
 
 		/* Support of yytext. */
-		*yy_cp = yy_hold_char;
+		*yy_cp = yyg->yy_hold_char;
 
 		/* yy_bp points to the position in yy_ch_buf of the start of
 		 * the current run.
 		 */
 		yy_bp = yy_cp;
 
-		yy_current_state = yy_start;
-		yy_state_ptr = yy_state_buf;
-		*yy_state_ptr++ = yy_current_state;
+		yy_current_state = yyg->yy_start;
+		yyg->yy_state_ptr = yyg->yy_state_buf;
+		*yyg->yy_state_ptr++ = yy_current_state;
 yy_match:
 		do
 			{
@@ -650,28 +653,28 @@ yy_match:
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-			*yy_state_ptr++ = yy_current_state;
+			*yyg->yy_state_ptr++ = yy_current_state;
 			++yy_cp;
 			}
 		while ( yy_base[yy_current_state] != 84 );
 
 yy_find_action:
-		yy_current_state = *--yy_state_ptr;
-		yy_lp = yy_accept[yy_current_state];
+		yy_current_state = *--yyg->yy_state_ptr;
+		yyg->yy_lp = yy_accept[yy_current_state];
 find_rule: /* we branch to this label when backing up */
 		for ( ; ; ) /* until we find what rule we matched */
 			{
-			if ( yy_lp && yy_lp < yy_accept[yy_current_state + 1] )
+			if ( yyg->yy_lp && yyg->yy_lp < yy_accept[yy_current_state + 1] )
 				{
-				yy_act = yy_acclist[yy_lp];
+				yy_act = yy_acclist[yyg->yy_lp];
 					{
-					yy_full_match = yy_cp;
+					yyg->yy_full_match = yy_cp;
 					break;
 					}
 				}
 			--yy_cp;
-			yy_current_state = *--yy_state_ptr;
-			yy_lp = yy_accept[yy_current_state];
+			yy_current_state = *--yyg->yy_state_ptr;
+			yyg->yy_lp = yy_accept[yy_current_state];
 			}
 
 		YY_DO_BEFORE_ACTION;
@@ -691,196 +694,192 @@ do_action:	/* This label is used only to access EOF actions. */
 	{ /* beginning of action switch */
 case 1:
 YY_RULE_SETUP
-#line 21 "lex.l"
+#line 22 "lex.l"
 ;  // skip whitespace
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 23 "lex.l"
-{ printf("[LEX] COMMENT LINE\n"); }
+#line 24 "lex.l"
+{ LEX_TRACE("[LEX] COMMENT LINE\n"); }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 24 "lex.l"
-{ printf("[LEX] COMMENT START\n"); BEGIN(COMMENT); }
+#line 25 "lex.l"
+{ LEX_TRACE("[LEX] COMMENT START\n"); BEGIN(COMMENT); }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 25 "lex.l"
-{ printf("[LEX] COMMENT END\n"); BEGIN(INITIAL); }
+#line 26 "lex.l"
+{ LEX_TRACE("[LEX] COMMENT END\n"); BEGIN(INITIAL); }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 26 "lex.l"
+#line 27 "lex.l"
 { yylineno++; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 27 "lex.l"
+#line 28 "lex.l"
 ;  // ignore other comment chars
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 30 "lex.l"
-{ printf("[LEX] KUAN\n"); return KUAN; }
+#line 31 "lex.l"
+{ LEX_TRACE("[LEX] KUAN\n"); return KUAN; }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 31 "lex.l"
-{ printf("[LEX] ENTEGER\n"); return ENTEGER; }
+#line 32 "lex.l"
+{ LEX_TRACE("[LEX] ENTEGER\n"); return ENTEGER; }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 32 "lex.l"
-{ printf("[LEX] CHAROT\n"); return CHAROT; }
+#line 33 "lex.l"
+{ LEX_TRACE("[LEX] CHAROT\n"); return CHAROT; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 33 "lex.l"
-{ printf("[LEX] PRENT\n"); return PRENT; }
+#line 34 "lex.l"
+{ LEX_TRACE("[LEX] PRENT\n"); return PRENT; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 36 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] PLUS_EQUAL (+=)\n"); return PLUS_EQUAL; }
+#line 37 "lex.l"
+{ LEX_TRACE("[LEX] PLUS_EQUAL (+=)\n"); return PLUS_EQUAL; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 37 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] MINUS_EQUAL (-=)\n"); return MINUS_EQUAL; }
+#line 38 "lex.l"
+{ LEX_TRACE("[LEX] MINUS_EQUAL (-=)\n"); return MINUS_EQUAL; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 38 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] DIV_EQUAL (/=)\n"); return DIV_EQUAL; }
+#line 39 "lex.l"
+{ LEX_TRACE("[LEX] DIV_EQUAL (/=)\n"); return DIV_EQUAL; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 39 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] MUL_EQUAL (*=)\n"); return MUL_EQUAL; }
+#line 40 "lex.l"
+{ LEX_TRACE("[LEX] MUL_EQUAL (*=)\n"); return MUL_EQUAL; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 40 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] PLUSPLUS (++)\n"); return PLUSPLUS; }
+#line 41 "lex.l"
+{ LEX_TRACE("[LEX] PLUSPLUS (++)\n"); return PLUSPLUS; }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 41 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] MINUSMINUS (--)\n"); return MINUSMINUS; }
+#line 42 "lex.l"
+{ LEX_TRACE("[LEX] MINUSMINUS (--)\n"); return MINUSMINUS; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 44 "lex.l"
-{ printf("[LEX] PLUS (+)\n"); return PLUS; }
+#line 45 "lex.l"
+{ LEX_TRACE("[LEX] PLUS (+)\n"); return PLUS; }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 45 "lex.l"
-{ printf("[LEX] MINUS (-)\n"); return MINUS; }
+#line 46 "lex.l"
+{ LEX_TRACE("[LEX] MINUS (-)\n"); return MINUS; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 46 "lex.l"
-{ printf("[LEX] MUL (*)\n"); return MUL; }
+#line 47 "lex.l"
+{ LEX_TRACE("[LEX] MUL (*)\n"); return MUL; }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 47 "lex.l"
-{ printf("[LEX] DIV (/)\n"); return DIV; }
+#line 48 "lex.l"
+{ LEX_TRACE("[LEX] DIV (/)\n"); return DIV; }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 48 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] EQUAL (=)\n"); return EQUAL; }
+#line 49 "lex.l"
+{ LEX_TRACE("[LEX] EQUAL (=)\n"); return EQUAL; }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 49 "lex.l"
-{ printf("[LEX] EXCLAM (!)\n"); return EXCLAM; }
+#line 50 "lex.l"
+{ LEX_TRACE("[LEX] EXCLAM (!)\n"); return EXCLAM; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 50 "lex.l"
-{ printf("[LEX] LPAREN\n"); return LPAREN; }
+#line 51 "lex.l"
+{ LEX_TRACE("[LEX] LPAREN\n"); return LPAREN; }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 51 "lex.l"
-{ printf("[LEX] RPAREN\n"); return RPAREN; }
+#line 52 "lex.l"
+{ LEX_TRACE("[LEX] RPAREN\n"); return RPAREN; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 52 "lex.l"
-{ printf("[LEX] COMMA\n"); return COMMA; }
+#line 53 "lex.l"
+{ LEX_TRACE("[LEX] COMMA\n"); return COMMA; }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 55 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] INT_LITERAL (%s)\n", yytext); return INT_LITERAL; }
+#line 56 "lex.l"
+{ yylval->sym = intern(&yyextra->names, &yyextra->arena, yytext, yyleng); LEX_TRACE("[LEX] INT_LITERAL (%s)\n", yytext); return INT_LITERAL; }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 56 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] CHAR_LITERAL (%s)\n", yytext); return CHAR_LITERAL; }
+#line 57 "lex.l"
+{ yylval->sym = intern(&yyextra->names, &yyextra->arena, yytext, yyleng); LEX_TRACE("[LEX] CHAR_LITERAL (%s)\n", yytext); return CHAR_LITERAL; }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 57 "lex.l"
-{ yylval.str = strdup(yytext); printf("[LEX] STRING_LITERAL (%s)\n", yytext); return STRING_LITERAL; }
+#line 58 "lex.l"
+{ yylval->sym = intern(&yyextra->names, &yyextra->arena, yytext, yyleng); LEX_TRACE("[LEX] STRING_LITERAL (%s)\n", yytext); return STRING_LITERAL; }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 60 "lex.l"
+#line 61 "lex.l"
 {
-    yylval.str = strdup(yytext);
-    printf("[LEX] IDENTIFIER (%s)\n", yytext);
+    yylval->sym = intern(&yyextra->names, &yyextra->arena, yytext, yyleng);
+    LEX_TRACE("[LEX] IDENTIFIER (%s)\n", yytext);
     return IDENTIFIER;
 }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 67 "lex.l"
-{ lineCount++; printf("[LEX] NEWLINE\n"); }
+#line 68 "lex.l"
+{ yyextra->lineCount++; LEX_TRACE("[LEX] NEWLINE\n"); }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 71 "lex.l"
+#line 72 "lex.l"
 {
 
-    if (islexerror == 0) {                                              // only log the first error
-        FILE *out = fopen("output_print.txt", "w");                     // overwrite the file
-        if(out) {
-            fprintf(out, "Invalid Empty Character [line:%d]\n", lineCount);
-            fclose(out);
-        }
-        islexerror = 1;                                                 // mark that an error was logged
+    if (yyextra->islexerror == 0) {                                     // only log the first error
+        bai_output_clear(yyextra, BAI_OUT_PRINT);                       // overwrite the file
+        bai_output_printf(yyextra, BAI_OUT_PRINT, "Invalid Empty Character [line:%d]\n", yyextra->lineCount);
+        bai_report(yyextra, BAI_DIAG_ERROR, yyextra->lineCount, "Invalid Empty Character");
+        yyextra->islexerror = 1;                                        // mark that an error was logged
     }
-    parse_failed = 1;
+    yyextra->parse_failed = 1;
 }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 84 "lex.l"
+#line 83 "lex.l"
 {
-                        if (islexerror == 0) {                                                              // only log the first error
-                            FILE *out = fopen("output_print.txt", "w");                                     // overwrite the file
-                            if(out) {
-                                /* fprintf(out, "[LEX] Invalid (%s) [line:%d]\n", yytext, lineCount); */
-                                fprintf(out, "Invalid Character (%s) [line:%d]\n", yytext, lineCount);
-                                fclose(out);
-                            }
-                            islexerror = 1;                                                                 // mark that an error was logged
+                        if (yyextra->islexerror == 0) {                                                     // only log the first error
+                            bai_output_clear(yyextra, BAI_OUT_PRINT);                                       // overwrite the file
+                            /* bai_output_printf(yyextra, BAI_OUT_PRINT, "[LEX] Invalid (%s) [line:%d]\n", yytext, yyextra->lineCount); */
+                            bai_output_printf(yyextra, BAI_OUT_PRINT, "Invalid Character (%s) [line:%d]\n", yytext, yyextra->lineCount);
+                            bai_report(yyextra, BAI_DIAG_ERROR, yyextra->lineCount, "Invalid Character (%s)", yytext);
+                            yyextra->islexerror = 1;                                                        // mark that an error was logged
                         }
-                        parse_failed = 1;
+                        yyextra->parse_failed = 1;
                       }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 98 "lex.l"
+#line 95 "lex.l"
 ECHO;
 	YY_BREAK
-#line 884 "lex.yy.c"
+#line 883 "lex.yy.c"
 			case YY_STATE_EOF(INITIAL):
 			case YY_STATE_EOF(COMMENT):
 				yyterminate();
@@ -888,13 +887,13 @@ ECHO;
 	case YY_END_OF_BUFFER:
 		{
 		/* Amount of text matched not including the EOB char. */
-		int yy_amount_of_matched_text = (int) (yy_cp - yytext_ptr) - 1;
+		int yy_amount_of_matched_text = (int) (yy_cp - yyg->yytext_ptr) - 1;
 
 		/* Undo the effects of YY_DO_BEFORE_ACTION. */
-		*yy_cp = yy_hold_char;
+		*yy_cp = yyg->yy_hold_char;
 		YY_RESTORE_YY_MORE_OFFSET
 
-		if ( yy_current_buffer->yy_buffer_status == YY_BUFFER_NEW )
+		if ( yyg->yy_current_buffer->yy_buffer_status == YY_BUFFER_NEW )
 			{
 			/* We're scanning a new file or input source.  It's
 			 * possible that this happened because the user
@@ -905,9 +904,9 @@ ECHO;
 			 * this is the first action (other than possibly a
 			 * back-up) that will match for the new input source.
 			 */
-			yy_n_chars = yy_current_buffer->yy_n_chars;
-			yy_current_buffer->yy_input_file = yyin;
-			yy_current_buffer->yy_buffer_status = YY_BUFFER_NORMAL;
+			yyg->yy_n_chars = yyg->yy_current_buffer->yy_n_chars;
+			yyg->yy_current_buffer->yy_input_file = yyin;
+			yyg->yy_current_buffer->yy_buffer_status = YY_BUFFER_NORMAL;
 			}
 
 		/* Note that here we test for yy_c_buf_p "<=" to the position
@@ -917,13 +916,13 @@ ECHO;
 		 * end-of-buffer state).  Contrast this with the test
 		 * in input().
 		 */
-		if ( yy_c_buf_p <= &yy_current_buffer->yy_ch_buf[yy_n_chars] )
+		if ( yyg->yy_c_buf_p <= &yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars] )
 			{ /* This was really a NUL. */
 			yy_state_type yy_next_state;
 
-			yy_c_buf_p = yytext_ptr + yy_amount_of_matched_text;
+			yyg->yy_c_buf_p = yyg->yytext_ptr + yy_amount_of_matched_text;
 
-			yy_current_state = yy_get_previous_state();
+			yy_current_state = yy_get_previous_state( yyscanner );
 
 			/* Okay, we're now positioned to make the NUL
 			 * transition.  We couldn't have
@@ -934,32 +933,32 @@ ECHO;
 			 * will run more slowly).
 			 */
 
-			yy_next_state = yy_try_NUL_trans( yy_current_state );
+			yy_next_state = yy_try_NUL_trans( yy_current_state , yyscanner );
 
-			yy_bp = yytext_ptr + YY_MORE_ADJ;
+			yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 
 			if ( yy_next_state )
 				{
 				/* Consume the NUL. */
-				yy_cp = ++yy_c_buf_p;
+				yy_cp = ++yyg->yy_c_buf_p;
 				yy_current_state = yy_next_state;
 				goto yy_match;
 				}
 
 			else
 				{
-				yy_cp = yy_c_buf_p;
+				yy_cp = yyg->yy_c_buf_p;
 				goto yy_find_action;
 				}
 			}
 
-		else switch ( yy_get_next_buffer() )
+		else switch ( yy_get_next_buffer( yyscanner ) )
 			{
 			case EOB_ACT_END_OF_FILE:
 				{
-				yy_did_buffer_switch_on_eof = 0;
+				yyg->yy_did_buffer_switch_on_eof = 0;
 
-				if ( yywrap() )
+				if ( yywrap( yyscanner ) )
 					{
 					/* Note: because we've taken care in
 					 * yy_get_next_buffer() to have set up
@@ -970,7 +969,7 @@ ECHO;
 					 * YY_NULL, it'll still work - another
 					 * YY_NULL will get returned.
 					 */
-					yy_c_buf_p = yytext_ptr + YY_MORE_ADJ;
+					yyg->yy_c_buf_p = yyg->yytext_ptr + YY_MORE_ADJ;
 
 					yy_act = YY_STATE_EOF(YY_START);
 					goto do_action;
@@ -978,30 +977,30 @@ ECHO;
 
 				else
 					{
-					if ( ! yy_did_buffer_switch_on_eof )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
 					}
 				break;
 				}
 
 			case EOB_ACT_CONTINUE_SCAN:
-				yy_c_buf_p =
-					yytext_ptr + yy_amount_of_matched_text;
+				yyg->yy_c_buf_p =
+					yyg->yytext_ptr + yy_amount_of_matched_text;
 
-				yy_current_state = yy_get_previous_state();
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = yy_c_buf_p;
-				yy_bp = yytext_ptr + YY_MORE_ADJ;
+				yy_cp = yyg->yy_c_buf_p;
+				yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 				goto yy_match;
 
 			case EOB_ACT_LAST_MATCH:
-				yy_c_buf_p =
-				&yy_current_buffer->yy_ch_buf[yy_n_chars];
+				yyg->yy_c_buf_p =
+				&yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars];
 
-				yy_current_state = yy_get_previous_state();
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = yy_c_buf_p;
-				yy_bp = yytext_ptr + YY_MORE_ADJ;
+				yy_cp = yyg->yy_c_buf_p;
+				yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 				goto yy_find_action;
 			}
 		break;
@@ -1023,20 +1022,21 @@ ECHO;
  *	EOB_ACT_END_OF_FILE - end of file
  */
 
-static int yy_get_next_buffer()
+static int yy_get_next_buffer( yyscan_t yyscanner )
 	{
-	register char *dest = yy_current_buffer->yy_ch_buf;
-	register char *source = yytext_ptr;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	register char *dest = yyg->yy_current_buffer->yy_ch_buf;
+	register char *source = yyg->yytext_ptr;
 	register int number_to_move, i;
 	int ret_val;
 
-	if ( yy_c_buf_p > &yy_current_buffer->yy_ch_buf[yy_n_chars + 1] )
+	if ( yyg->yy_c_buf_p > &yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars + 1] )
 		YY_FATAL_ERROR(
 		"fatal flex scanner internal error--end of buffer missed" );
 
-	if ( yy_current_buffer->yy_fill_buffer == 0 )
+	if ( yyg->yy_current_buffer->yy_fill_buffer == 0 )
 		{ /* Don't try to fill the buffer, so this is an EOF. */
-		if ( yy_c_buf_p - yytext_ptr - YY_MORE_ADJ == 1 )
+		if ( yyg->yy_c_buf_p - yyg->yytext_ptr - YY_MORE_ADJ == 1 )
 			{
 			/* We matched a single character, the EOB, so
 			 * treat this as a final EOF.
@@ -1056,86 +1056,50 @@ static int yy_get_next_buffer()
 	/* Try to read more data. */
 
 	/* First move last chars to start of buffer. */
-	number_to_move = (int) (yy_c_buf_p - yytext_ptr) - 1;
+	number_to_move = (int) (yyg->yy_c_buf_p - yyg->yytext_ptr) - 1;
 
 	for ( i = 0; i < number_to_move; ++i )
 		*(dest++) = *(source++);
 
-	if ( yy_current_buffer->yy_buffer_status == YY_BUFFER_EOF_PENDING )
+	if ( yyg->yy_current_buffer->yy_buffer_status == YY_BUFFER_EOF_PENDING )
 		/* don't do the read, it's not guaranteed to return an EOF,
 		 * just force an EOF
 		 */
-		yy_current_buffer->yy_n_chars = yy_n_chars = 0;
+		yyg->yy_current_buffer->yy_n_chars = yyg->yy_n_chars = 0;
 
 	else
 		{
 		int num_to_read =
-			yy_current_buffer->yy_buf_size - number_to_move - 1;
+			yyg->yy_current_buffer->yy_buf_size - number_to_move - 1;
 
 		while ( num_to_read <= 0 )
 			{ /* Not enough room in the buffer - grow it. */
-#ifdef YY_USES_REJECT
 			YY_FATAL_ERROR(
 "input buffer overflow, can't enlarge buffer because scanner uses REJECT" );
-#else
-
-			/* just a shorter name for the current buffer */
-			YY_BUFFER_STATE b = yy_current_buffer;
-
-			int yy_c_buf_p_offset =
-				(int) (yy_c_buf_p - b->yy_ch_buf);
-
-			if ( b->yy_is_our_buffer )
-				{
-				int new_size = b->yy_buf_size * 2;
-
-				if ( new_size <= 0 )
-					b->yy_buf_size += b->yy_buf_size / 8;
-				else
-					b->yy_buf_size *= 2;
-
-				b->yy_ch_buf = (char *)
-					/* Include room in for 2 EOB chars. */
-					yy_flex_realloc( (void *) b->yy_ch_buf,
-							 b->yy_buf_size + 2 );
-				}
-			else
-				/* Can't grow it, we don't own it. */
-				b->yy_ch_buf = 0;
-
-			if ( ! b->yy_ch_buf )
-				YY_FATAL_ERROR(
-				"fatal error - scanner input buffer overflow" );
-
-			yy_c_buf_p = &b->yy_ch_buf[yy_c_buf_p_offset];
-
-			num_to_read = yy_current_buffer->yy_buf_size -
-						number_to_move - 1;
-#endif
 			}
 
 		if ( num_to_read > YY_READ_BUF_SIZE )
 			num_to_read = YY_READ_BUF_SIZE;
 
 		/* Read in more data. */
-		YY_INPUT( (&yy_current_buffer->yy_ch_buf[number_to_move]),
-			yy_n_chars, num_to_read );
+		YY_INPUT( (&yyg->yy_current_buffer->yy_ch_buf[number_to_move]),
+			yyg->yy_n_chars, num_to_read );
 
-		yy_current_buffer->yy_n_chars = yy_n_chars;
+		yyg->yy_current_buffer->yy_n_chars = yyg->yy_n_chars;
 		}
 
-	if ( yy_n_chars == 0 )
+	if ( yyg->yy_n_chars == 0 )
 		{
 		if ( number_to_move == YY_MORE_ADJ )
 			{
 			ret_val = EOB_ACT_END_OF_FILE;
-			yyrestart( yyin );
+			yyrestart( yyin , yyscanner );
 			}
 
 		else
 			{
 			ret_val = EOB_ACT_LAST_MATCH;
-			yy_current_buffer->yy_buffer_status =
+			yyg->yy_current_buffer->yy_buffer_status =
 				YY_BUFFER_EOF_PENDING;
 			}
 		}
@@ -1143,11 +1107,11 @@ static int yy_get_next_buffer()
 	else
 		ret_val = EOB_ACT_CONTINUE_SCAN;
 
-	yy_n_chars += number_to_move;
-	yy_current_buffer->yy_ch_buf[yy_n_chars] = YY_END_OF_BUFFER_CHAR;
-	yy_current_buffer->yy_ch_buf[yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
+	yyg->yy_n_chars += number_to_move;
+	yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars] = YY_END_OF_BUFFER_CHAR;
+	yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
 
-	yytext_ptr = &yy_current_buffer->yy_ch_buf[0];
+	yyg->yytext_ptr = &yyg->yy_current_buffer->yy_ch_buf[0];
 
 	return ret_val;
 	}
@@ -1155,16 +1119,17 @@ static int yy_get_next_buffer()
 
 /* yy_get_previous_state - get the state just before the EOB char was reached */
 
-static yy_state_type yy_get_previous_state()
+static yy_state_type yy_get_previous_state( yyscan_t yyscanner )
 	{
 	register yy_state_type yy_current_state;
 	register char *yy_cp;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
-	yy_current_state = yy_start;
-	yy_state_ptr = yy_state_buf;
-	*yy_state_ptr++ = yy_current_state;
+	yy_current_state = yyg->yy_start;
+	yyg->yy_state_ptr = yyg->yy_state_buf;
+	*yyg->yy_state_ptr++ = yy_current_state;
 
-	for ( yy_cp = yytext_ptr + YY_MORE_ADJ; yy_cp < yy_c_buf_p; ++yy_cp )
+	for ( yy_cp = yyg->yytext_ptr + YY_MORE_ADJ; yy_cp < yyg->yy_c_buf_p; ++yy_cp )
 		{
 		register YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 1);
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
@@ -1174,7 +1139,7 @@ static yy_state_type yy_get_previous_state()
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-		*yy_state_ptr++ = yy_current_state;
+		*yyg->yy_state_ptr++ = yy_current_state;
 		}
 
 	return yy_current_state;
@@ -1187,14 +1152,10 @@ static yy_state_type yy_get_previous_state()
  *	next_state = yy_try_NUL_trans( current_state );
  */
 
-#ifdef YY_USE_PROTOS
-static yy_state_type yy_try_NUL_trans( yy_state_type yy_current_state )
-#else
-static yy_state_type yy_try_NUL_trans( yy_current_state )
-yy_state_type yy_current_state;
-#endif
+static yy_state_type yy_try_NUL_trans( yy_state_type yy_current_state , yyscan_t yyscanner )
 	{
 	register int yy_is_jam;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
 	register YY_CHAR yy_c = 1;
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
@@ -1206,44 +1167,41 @@ yy_state_type yy_current_state;
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 	yy_is_jam = (yy_current_state == 66);
 	if ( ! yy_is_jam )
-		*yy_state_ptr++ = yy_current_state;
+		*yyg->yy_state_ptr++ = yy_current_state;
 
 	return yy_is_jam ? 0 : yy_current_state;
 	}
 
 
 #ifndef YY_NO_UNPUT
-#ifdef YY_USE_PROTOS
-static void yyunput( int c, register char *yy_bp )
-#else
-static void yyunput( c, yy_bp )
-int c;
-register char *yy_bp;
-#endif
+static void yyunput( int c, register char *yy_bp , yyscan_t yyscanner )
 	{
-	register char *yy_cp = yy_c_buf_p;
+	register char *yy_cp;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	yy_cp = yyg->yy_c_buf_p;
 
 	/* undo effects of setting up yytext */
-	*yy_cp = yy_hold_char;
+	*yy_cp = yyg->yy_hold_char;
 
-	if ( yy_cp < yy_current_buffer->yy_ch_buf + 2 )
+	if ( yy_cp < yyg->yy_current_buffer->yy_ch_buf + 2 )
 		{ /* need to shift things up to make room */
 		/* +2 for EOB chars. */
-		register int number_to_move = yy_n_chars + 2;
-		register char *dest = &yy_current_buffer->yy_ch_buf[
-					yy_current_buffer->yy_buf_size + 2];
+		register int number_to_move = yyg->yy_n_chars + 2;
+		register char *dest = &yyg->yy_current_buffer->yy_ch_buf[
+					yyg->yy_current_buffer->yy_buf_size + 2];
 		register char *source =
-				&yy_current_buffer->yy_ch_buf[number_to_move];
+				&yyg->yy_current_buffer->yy_ch_buf[number_to_move];
 
-		while ( source > yy_current_buffer->yy_ch_buf )
+		while ( source > yyg->yy_current_buffer->yy_ch_buf )
 			*--dest = *--source;
 
 		yy_cp += (int) (dest - source);
 		yy_bp += (int) (dest - source);
-		yy_current_buffer->yy_n_chars =
-			yy_n_chars = yy_current_buffer->yy_buf_size;
+		yyg->yy_current_buffer->yy_n_chars =
+			yyg->yy_n_chars = yyg->yy_current_buffer->yy_buf_size;
 
-		if ( yy_cp < yy_current_buffer->yy_ch_buf + 2 )
+		if ( yy_cp < yyg->yy_current_buffer->yy_ch_buf + 2 )
 			YY_FATAL_ERROR( "flex scanner push-back overflow" );
 		}
 
@@ -1252,39 +1210,37 @@ register char *yy_bp;
 	if ( c == '\n' )
 		--yylineno;
 
-	yytext_ptr = yy_bp;
-	yy_hold_char = *yy_cp;
-	yy_c_buf_p = yy_cp;
+	yyg->yytext_ptr = yy_bp;
+	yyg->yy_hold_char = *yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
 	}
 #endif	/* ifndef YY_NO_UNPUT */
 
 
-#ifdef __cplusplus
-static int yyinput()
-#else
-static int input()
-#endif
+#ifndef YY_NO_INPUT
+static int input( yyscan_t yyscanner )
 	{
 	int c;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
-	*yy_c_buf_p = yy_hold_char;
+	*yyg->yy_c_buf_p = yyg->yy_hold_char;
 
-	if ( *yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
+	if ( *yyg->yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
 		{
 		/* yy_c_buf_p now points to the character we want to return.
 		 * If this occurs *before* the EOB characters, then it's a
 		 * valid NUL; if not, then we've hit the end of the buffer.
 		 */
-		if ( yy_c_buf_p < &yy_current_buffer->yy_ch_buf[yy_n_chars] )
+		if ( yyg->yy_c_buf_p < &yyg->yy_current_buffer->yy_ch_buf[yyg->yy_n_chars] )
 			/* This was really a NUL. */
-			*yy_c_buf_p = '\0';
+			*yyg->yy_c_buf_p = '\0';
 
 		else
 			{ /* need more input */
-			int offset = yy_c_buf_p - yytext_ptr;
-			++yy_c_buf_p;
+			int offset = yyg->yy_c_buf_p - yyg->yytext_ptr;
+			++yyg->yy_c_buf_p;
 
-			switch ( yy_get_next_buffer() )
+			switch ( yy_get_next_buffer( yyscanner ) )
 				{
 				case EOB_ACT_LAST_MATCH:
 					/* This happens because yy_g_n_b()
@@ -1298,111 +1254,94 @@ static int input()
 					 */
 
 					/* Reset buffer status. */
-					yyrestart( yyin );
+					yyrestart( yyin , yyscanner );
 
 					/* fall through */
 
 				case EOB_ACT_END_OF_FILE:
 					{
-					if ( yywrap() )
+					if ( yywrap( yyscanner ) )
 						return EOF;
 
-					if ( ! yy_did_buffer_switch_on_eof )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
-#ifdef __cplusplus
-					return yyinput();
-#else
-					return input();
-#endif
+					return input( yyscanner );
 					}
 
 				case EOB_ACT_CONTINUE_SCAN:
-					yy_c_buf_p = yytext_ptr + offset;
+					yyg->yy_c_buf_p = yyg->yytext_ptr + offset;
 					break;
 				}
 			}
 		}
 
-	c = *(unsigned char *) yy_c_buf_p;	/* cast for 8-bit char's */
-	*yy_c_buf_p = '\0';	/* preserve yytext */
-	yy_hold_char = *++yy_c_buf_p;
+	c = *(unsigned char *) yyg->yy_c_buf_p;	/* cast for 8-bit char's */
+	*yyg->yy_c_buf_p = '\0';	/* preserve yytext */
+	yyg->yy_hold_char = *++yyg->yy_c_buf_p;
 
 	if ( c == '\n' )
 		++yylineno;
 
 	return c;
 	}
+#endif	/* ifndef YY_NO_INPUT */
 
 
-#ifdef YY_USE_PROTOS
-void yyrestart( FILE *input_file )
-#else
-void yyrestart( input_file )
-FILE *input_file;
-#endif
+void yyrestart( FILE *input_file , yyscan_t yyscanner )
 	{
-	if ( ! yy_current_buffer )
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE );
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if ( ! yyg->yy_current_buffer )
+		yyg->yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner );
 
-	yy_init_buffer( yy_current_buffer, input_file );
-	yy_load_buffer_state();
+	yy_init_buffer( yyg->yy_current_buffer, input_file , yyscanner );
+	yy_load_buffer_state( yyscanner );
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_switch_to_buffer( YY_BUFFER_STATE new_buffer )
-#else
-void yy_switch_to_buffer( new_buffer )
-YY_BUFFER_STATE new_buffer;
-#endif
+void yy_switch_to_buffer( YY_BUFFER_STATE new_buffer , yyscan_t yyscanner )
 	{
-	if ( yy_current_buffer == new_buffer )
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if ( yyg->yy_current_buffer == new_buffer )
 		return;
 
-	if ( yy_current_buffer )
+	if ( yyg->yy_current_buffer )
 		{
 		/* Flush out information for old buffer. */
-		*yy_c_buf_p = yy_hold_char;
-		yy_current_buffer->yy_buf_pos = yy_c_buf_p;
-		yy_current_buffer->yy_n_chars = yy_n_chars;
+		*yyg->yy_c_buf_p = yyg->yy_hold_char;
+		yyg->yy_current_buffer->yy_buf_pos = yyg->yy_c_buf_p;
+		yyg->yy_current_buffer->yy_n_chars = yyg->yy_n_chars;
 		}
 
-	yy_current_buffer = new_buffer;
-	yy_load_buffer_state();
+	yyg->yy_current_buffer = new_buffer;
+	yy_load_buffer_state( yyscanner );
 
 	/* We don't actually know whether we did this switch during
 	 * EOF (yywrap()) processing, but the only time this flag
 	 * is looked at is after yywrap() is called, so it's safe
 	 * to go ahead and always set it.
 	 */
-	yy_did_buffer_switch_on_eof = 1;
+	yyg->yy_did_buffer_switch_on_eof = 1;
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_load_buffer_state( void )
-#else
-void yy_load_buffer_state()
-#endif
+void yy_load_buffer_state( yyscan_t yyscanner )
 	{
-	yy_n_chars = yy_current_buffer->yy_n_chars;
-	yytext_ptr = yy_c_buf_p = yy_current_buffer->yy_buf_pos;
-	yyin = yy_current_buffer->yy_input_file;
-	yy_hold_char = *yy_c_buf_p;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	yyg->yy_n_chars = yyg->yy_current_buffer->yy_n_chars;
+	yyg->yytext_ptr = yyg->yy_c_buf_p = yyg->yy_current_buffer->yy_buf_pos;
+	yyin = yyg->yy_current_buffer->yy_input_file;
+	yyg->yy_hold_char = *yyg->yy_c_buf_p;
 	}
 
 
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_create_buffer( FILE *file, int size )
-#else
-YY_BUFFER_STATE yy_create_buffer( file, size )
-FILE *file;
-int size;
-#endif
+YY_BUFFER_STATE yy_create_buffer( FILE *file, int size , yyscan_t yyscanner )
 	{
 	YY_BUFFER_STATE b;
 
-	b = (YY_BUFFER_STATE) yy_flex_alloc( sizeof( struct yy_buffer_state ) );
+	b = (YY_BUFFER_STATE) yy_flex_alloc( sizeof( struct yy_buffer_state ) , yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
 
@@ -1411,55 +1350,38 @@ int size;
 	/* yy_ch_buf has to be 2 characters longer than the size given because
 	 * we need to put in 2 end-of-buffer characters.
 	 */
-	b->yy_ch_buf = (char *) yy_flex_alloc( b->yy_buf_size + 2 );
+	b->yy_ch_buf = (char *) yy_flex_alloc( b->yy_buf_size + 2 , yyscanner );
 	if ( ! b->yy_ch_buf )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
 
 	b->yy_is_our_buffer = 1;
 
-	yy_init_buffer( b, file );
+	yy_init_buffer( b, file , yyscanner );
 
 	return b;
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_delete_buffer( YY_BUFFER_STATE b )
-#else
-void yy_delete_buffer( b )
-YY_BUFFER_STATE b;
-#endif
+void yy_delete_buffer( YY_BUFFER_STATE b , yyscan_t yyscanner )
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	if ( ! b )
 		return;
 
-	if ( b == yy_current_buffer )
-		yy_current_buffer = (YY_BUFFER_STATE) 0;
+	if ( b == yyg->yy_current_buffer )
+		yyg->yy_current_buffer = (YY_BUFFER_STATE) 0;
 
 	if ( b->yy_is_our_buffer )
-		yy_flex_free( (void *) b->yy_ch_buf );
+		yy_flex_free( (void *) b->yy_ch_buf , yyscanner );
 
-	yy_flex_free( (void *) b );
+	yy_flex_free( (void *) b , yyscanner );
 	}
 
 
-#ifndef YY_ALWAYS_INTERACTIVE
-#ifndef YY_NEVER_INTERACTIVE
-extern int isatty YY_PROTO(( int ));
-#endif
-#endif
-
-#ifdef YY_USE_PROTOS
-void yy_init_buffer( YY_BUFFER_STATE b, FILE *file )
-#else
-void yy_init_buffer( b, file )
-YY_BUFFER_STATE b;
-FILE *file;
-#endif
-
-
+void yy_init_buffer( YY_BUFFER_STATE b, FILE *file , yyscan_t yyscanner )
 	{
-	yy_flush_buffer( b );
+	yy_flush_buffer( b , yyscanner );
 
 	b->yy_input_file = file;
 	b->yy_fill_buffer = 1;
@@ -1476,14 +1398,10 @@ FILE *file;
 	}
 
 
-#ifdef YY_USE_PROTOS
-void yy_flush_buffer( YY_BUFFER_STATE b )
-#else
-void yy_flush_buffer( b )
-YY_BUFFER_STATE b;
-#endif
-
+void yy_flush_buffer( YY_BUFFER_STATE b , yyscan_t yyscanner )
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	if ( ! b )
 		return;
 
@@ -1501,20 +1419,15 @@ YY_BUFFER_STATE b;
 	b->yy_at_bol = 1;
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
-	if ( b == yy_current_buffer )
-		yy_load_buffer_state();
+	if ( b == yyg->yy_current_buffer )
+		yy_load_buffer_state( yyscanner );
 	}
 
 
 #ifndef YY_NO_SCAN_BUFFER
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_buffer( char *base, yy_size_t size )
-#else
-YY_BUFFER_STATE yy_scan_buffer( base, size )
-char *base;
-yy_size_t size;
-#endif
+YY_BUFFER_STATE yy_scan_buffer( char *base, yy_size_t size , yyscan_t yyscanner )
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 	YY_BUFFER_STATE b;
 
 	if ( size < 2 ||
@@ -1523,7 +1436,7 @@ yy_size_t size;
 		/* They forgot to leave room for the EOB's. */
 		return 0;
 
-	b = (YY_BUFFER_STATE) yy_flex_alloc( sizeof( struct yy_buffer_state ) );
+	b = (YY_BUFFER_STATE) yy_flex_alloc( sizeof( struct yy_buffer_state ) , yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_buffer()" );
 
@@ -1537,7 +1450,21 @@ yy_size_t size;
 	b->yy_fill_buffer = 0;
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
-	yy_switch_to_buffer( b );
+	/* REJECT keeps one state per matched character, and a token may now
+	 * span the whole in-memory buffer - size the state buffer to match.
+	 */
+	if ( size > yyg->yy_state_buf_max || ! yyg->yy_state_buf )
+		{
+		yy_size_t states = size > YY_BUF_SIZE + 2 ? size : YY_BUF_SIZE + 2;
+
+		yyg->yy_state_buf = (yy_state_type *) yy_flex_realloc(
+			(void *) yyg->yy_state_buf, states * sizeof( yy_state_type ) , yyscanner );
+		if ( ! yyg->yy_state_buf )
+			YY_FATAL_ERROR( "out of dynamic memory in yy_scan_buffer()" );
+		yyg->yy_state_buf_max = states;
+		}
+
+	yy_switch_to_buffer( b , yyscanner );
 
 	return b;
 	}
@@ -1545,30 +1472,19 @@ yy_size_t size;
 
 
 #ifndef YY_NO_SCAN_STRING
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_string( yyconst char *yy_str )
-#else
-YY_BUFFER_STATE yy_scan_string( yy_str )
-yyconst char *yy_str;
-#endif
+YY_BUFFER_STATE yy_scan_string( yyconst char *yy_str , yyscan_t yyscanner )
 	{
 	int len;
 	for ( len = 0; yy_str[len]; ++len )
 		;
 
-	return yy_scan_bytes( yy_str, len );
+	return yy_scan_bytes( yy_str, len , yyscanner );
 	}
 #endif
 
 
 #ifndef YY_NO_SCAN_BYTES
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_bytes( yyconst char *bytes, int len )
-#else
-YY_BUFFER_STATE yy_scan_bytes( bytes, len )
-yyconst char *bytes;
-int len;
-#endif
+YY_BUFFER_STATE yy_scan_bytes( yyconst char *bytes, int len , yyscan_t yyscanner )
 	{
 	YY_BUFFER_STATE b;
 	char *buf;
@@ -1577,7 +1493,7 @@ int len;
 
 	/* Get memory for full buffer, including space for trailing EOB's. */
 	n = len + 2;
-	buf = (char *) yy_flex_alloc( n );
+	buf = (char *) yy_flex_alloc( n , yyscanner );
 	if ( ! buf )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_bytes()" );
 
@@ -1586,7 +1502,7 @@ int len;
 
 	buf[len] = buf[len+1] = YY_END_OF_BUFFER_CHAR;
 
-	b = yy_scan_buffer( buf, n );
+	b = yy_scan_buffer( buf, n , yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "bad buffer in yy_scan_bytes()" );
 
@@ -1601,33 +1517,30 @@ int len;
 
 
 #ifndef YY_NO_PUSH_STATE
-#ifdef YY_USE_PROTOS
-static void yy_push_state( int new_state )
-#else
-static void yy_push_state( new_state )
-int new_state;
-#endif
+static void yy_push_state( int new_state , yyscan_t yyscanner )
 	{
-	if ( yy_start_stack_ptr >= yy_start_stack_depth )
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if ( yyg->yy_start_stack_ptr >= yyg->yy_start_stack_depth )
 		{
 		yy_size_t new_size;
 
-		yy_start_stack_depth += YY_START_STACK_INCR;
-		new_size = yy_start_stack_depth * sizeof( int );
+		yyg->yy_start_stack_depth += YY_START_STACK_INCR;
+		new_size = yyg->yy_start_stack_depth * sizeof( int );
 
-		if ( ! yy_start_stack )
-			yy_start_stack = (int *) yy_flex_alloc( new_size );
+		if ( ! yyg->yy_start_stack )
+			yyg->yy_start_stack = (int *) yy_flex_alloc( new_size , yyscanner );
 
 		else
-			yy_start_stack = (int *) yy_flex_realloc(
-					(void *) yy_start_stack, new_size );
+			yyg->yy_start_stack = (int *) yy_flex_realloc(
+					(void *) yyg->yy_start_stack, new_size , yyscanner );
 
-		if ( ! yy_start_stack )
+		if ( ! yyg->yy_start_stack )
 			YY_FATAL_ERROR(
 			"out of memory expanding start-condition stack" );
 		}
 
-	yy_start_stack[yy_start_stack_ptr++] = YY_START;
+	yyg->yy_start_stack[yyg->yy_start_stack_ptr++] = YY_START;
 
 	BEGIN(new_state);
 	}
@@ -1635,20 +1548,24 @@ int new_state;
 
 
 #ifndef YY_NO_POP_STATE
-static void yy_pop_state()
+static void yy_pop_state( yyscan_t yyscanner )
 	{
-	if ( --yy_start_stack_ptr < 0 )
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if ( --yyg->yy_start_stack_ptr < 0 )
 		YY_FATAL_ERROR( "start-condition stack underflow" );
 
-	BEGIN(yy_start_stack[yy_start_stack_ptr]);
+	BEGIN(yyg->yy_start_stack[yyg->yy_start_stack_ptr]);
 	}
 #endif
 
 
 #ifndef YY_NO_TOP_STATE
-static int yy_top_state()
+static int yy_top_state( yyscan_t yyscanner )
 	{
-	return yy_start_stack[yy_start_stack_ptr - 1];
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	return yyg->yy_start_stack[yyg->yy_start_stack_ptr - 1];
 	}
 #endif
 
@@ -1656,13 +1573,9 @@ static int yy_top_state()
 #define YY_EXIT_FAILURE 2
 #endif
 
-#ifdef YY_USE_PROTOS
-static void yy_fatal_error( yyconst char msg[] )
-#else
-static void yy_fatal_error( msg )
-char msg[];
-#endif
+static void yy_fatal_error( yyconst char msg[] , yyscan_t yyscanner )
 	{
+	(void) yyscanner;
 	(void) fprintf( stderr, "%s\n", msg );
 	exit( YY_EXIT_FAILURE );
 	}
@@ -1676,68 +1589,199 @@ char msg[];
 	do \
 		{ \
 		/* Undo effects of setting up yytext. */ \
-		yytext[yyleng] = yy_hold_char; \
-		yy_c_buf_p = yytext + n; \
-		yy_hold_char = *yy_c_buf_p; \
-		*yy_c_buf_p = '\0'; \
+		yytext[yyleng] = yyg->yy_hold_char; \
+		yyg->yy_c_buf_p = yytext + n; \
+		yyg->yy_hold_char = *yyg->yy_c_buf_p; \
+		*yyg->yy_c_buf_p = '\0'; \
 		yyleng = n; \
 		} \
 	while ( 0 )
 
 
-/* Internal utility routines. */
+/* Accessor methods (get/set functions) to struct members. */
 
-#ifndef yytext_ptr
-#ifdef YY_USE_PROTOS
-static void yy_flex_strncpy( char *s1, yyconst char *s2, int n )
-#else
-static void yy_flex_strncpy( s1, s2, n )
-char *s1;
-yyconst char *s2;
-int n;
-#endif
+YY_EXTRA_TYPE yyget_extra( yyscan_t yyscanner )
 	{
-	register int i;
-	for ( i = 0; i < n; ++i )
-		s1[i] = s2[i];
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyextra;
 	}
-#endif
 
-#ifdef YY_NEED_STRLEN
-#ifdef YY_USE_PROTOS
-static int yy_flex_strlen( yyconst char *s )
-#else
-static int yy_flex_strlen( s )
-yyconst char *s;
-#endif
+void yyset_extra( YY_EXTRA_TYPE user_defined , yyscan_t yyscanner )
 	{
-	register int n;
-	for ( n = 0; s[n]; ++n )
-		;
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyextra = user_defined;
+	}
 
-	return n;
+FILE *yyget_in( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyin;
 	}
-#endif
 
+void yyset_in( FILE * _in_str , yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyin = _in_str;
+	}
 
-#ifdef YY_USE_PROTOS
-static void *yy_flex_alloc( yy_size_t size )
-#else
-static void *yy_flex_alloc( size )
-yy_size_t size;
-#endif
+FILE *yyget_out( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyout;
+	}
+
+void yyset_out( FILE * _out_str , yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyout = _out_str;
+	}
+
+int yyget_leng( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yyleng;
+	}
+
+char *yyget_text( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yytext;
+	}
+
+int yyget_lineno( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yylineno;
+	}
+
+void yyset_lineno( int _line_number , yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yylineno = _line_number;
+	}
+
+YYSTYPE * yyget_lval( yyscan_t yyscanner )
 	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	return yylval;
+	}
+
+void yyset_lval( YYSTYPE * yylval_param , yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yylval = yylval_param;
+	}
+
+
+/* Scanner construction and destruction. */
+
+int yylex_init( yyscan_t* ptr_yy_globals )
+	{
+	return yylex_init_extra( (YY_EXTRA_TYPE) 0, ptr_yy_globals );
+	}
+
+/* yylex_init_extra has the same functionality as yylex_init, but follows the
+ * convention of taking the scanner as the last argument. Note however, that
+ * this is a *pointer* to a scanner, as it will be allocated by this call (and
+ * is the reason, too, why this function also must handle its own
+ * initialization).  The user defined value in the first argument will be
+ * available to yyalloc in the yyextra field.
+ */
+int yylex_init_extra( YY_EXTRA_TYPE yy_user_defined, yyscan_t* ptr_yy_globals )
+	{
+	struct yyguts_t * yyg;
+
+	if ( ptr_yy_globals == NULL )
+		return 1;
+
+	*ptr_yy_globals = (yyscan_t) yy_flex_alloc( sizeof( struct yyguts_t ), 0 );
+
+	if ( *ptr_yy_globals == NULL )
+		return 1;
+
+	/* By setting to 0xAA, we expose bugs in yy_init_globals. Leave at 0x00 for releases. */
+	memset( *ptr_yy_globals, 0x00, sizeof( struct yyguts_t ) );
+
+	yyg = (struct yyguts_t*) *ptr_yy_globals;
+	yyextra = yy_user_defined;
+
+	return yy_init_globals( *ptr_yy_globals );
+	}
+
+static int yy_init_globals( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	/* Initialization is the same as for the non-reentrant scanner.
+	 * This function is called from yylex_destroy(), so don't allocate here.
+	 */
+	yyg->yy_current_buffer = 0;
+	yyg->yy_c_buf_p = (char *) 0;
+	yyg->yy_init = 1;
+	yyg->yy_start = 0;
+
+	yyg->yy_start_stack_ptr = 0;
+	yyg->yy_start_stack_depth = 0;
+	yyg->yy_start_stack = NULL;
+
+	yyg->yy_state_buf = 0;
+	yyg->yy_state_buf_max = 0;
+	yyg->yy_state_ptr = 0;
+	yyg->yy_full_match = 0;
+	yyg->yy_lp = 0;
+
+	yyg->yylineno_r = 1;
+
+	yyin = (FILE *) 0;
+	yyout = (FILE *) 0;
+
+	/* For future reference: Set errno on error, since we are called by
+	 * yylex_init()
+	 */
+	return 0;
+	}
+
+/* yylex_destroy is for both reentrant and non-reentrant scanners. */
+int yylex_destroy( yyscan_t yyscanner )
+	{
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if ( ! yyg )
+		return 0;
+
+	/* Destroy the current (main) buffer. */
+	if ( yyg->yy_current_buffer )
+		yy_delete_buffer( yyg->yy_current_buffer , yyscanner );
+
+	/* Destroy the start condition stack. */
+	yy_flex_free( yyg->yy_start_stack , yyscanner );
+	yyg->yy_start_stack = NULL;
+
+	yy_flex_free( yyg->yy_state_buf , yyscanner );
+	yyg->yy_state_buf = NULL;
+
+	/* Reset the globals. This is important in a non-reentrant scanner so the next time
+	 * yylex() is called, initialization will occur. */
+	yy_init_globals( yyscanner );
+
+	/* Destroy the main struct (reentrant only). */
+	yy_flex_free( yyscanner , yyscanner );
+	yyscanner = NULL;
+	return 0;
+	}
+
+
+/* Internal utility routines. */
+
+static void *yy_flex_alloc( yy_size_t size , yyscan_t yyscanner )
+	{
+	(void) yyscanner;
 	return (void *) malloc( size );
 	}
 
-#ifdef YY_USE_PROTOS
-static void *yy_flex_realloc( void *ptr, yy_size_t size )
-#else
-static void *yy_flex_realloc( ptr, size )
-void *ptr;
-yy_size_t size;
-#endif
+static void *yy_flex_realloc( void *ptr, yy_size_t size , yyscan_t yyscanner )
 	{
+	(void) yyscanner;
 	/* The cast to (char *) in the following accommodates both
 	 * implementations that use char* generic pointers, and those
 	 * that use void* generic pointers.  It works with the latter
@@ -1748,23 +1792,24 @@ yy_size_t size;
 	return (void *) realloc( (char *) ptr, size );
 	}
 
-#ifdef YY_USE_PROTOS
-static void yy_flex_free( void *ptr )
-#else
-static void yy_flex_free( ptr )
-void *ptr;
-#endif
+static void yy_flex_free( void *ptr , yyscan_t yyscanner )
 	{
+	(void) yyscanner;
 	free( ptr );
 	}
 
 #if YY_MAIN
 int main()
 	{
-	yylex();
+	yyscan_t scanner;
+	YYSTYPE lval;
+
+	yylex_init( &scanner );
+	while ( yylex( &lval, scanner ) )
+		;
+	yylex_destroy( scanner );
 	return 0;
 	}
 #endif
-#line 98 "lex.l"
-
+#line 95 "lex.l"
 
@@ -3,35 +3,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include "compiler.h"
 
-int start_code_counter = 0;
-
-const char *R_TYPE[R_TYPE_COUNT] = {"daddu", "dsub", "dmult", "ddiv", "mflo"};
-const char *I_TYPE[I_TYPE_COUNT] = {"daddiu", "ld", "sd"};
-
-/* ===================== DATA SYMBOLS ===================== */
-
-typedef struct
-{
-    char label[32];
-    int address;
-} DataSymbol;
-
-DataSymbol data_symbols[100];
-int data_symbol_count = 0;
-int current_data_address = 0xFFF8;
-
-/* ===================== MACHINE CODE STORAGE ===================== */
-
-typedef struct
-{
-    char assembly[64];
-    char machine_bin[64];
-    unsigned int machine_hex;
-} MachineCodeEntry;
-
-MachineCodeEntry machine_code_list[9999];
-int machine_code_count = 0;
+const char *R_TYPE[R_TYPE_COUNT] = {"daddu", "dsub", "dsubu", "dmult", "ddiv", "mflo", "mfhi",
+                                   "dsll", "dsrl", "dsra", "dsll32", "dsrl32", "dsra32"};
+const char *I_TYPE[I_TYPE_COUNT] = {"daddiu", "ld", "sd", "lui", "ori"};
 
 /* ===================== HELPERS ===================== */
 
@@ -58,6 +34,25 @@ void convert_to_binary(int num, int bits, char *output)
     }
 }
 
+/* Reentrant replacement for strtok(operands, ", "): splits on commas and spaces */
+static char *next_operand(char **cursor)
+{
+    char *s = *cursor;
+    if (!s)
+        return NULL;
+    s += strspn(s, ", ");
+    if (*s == '\0')
+    {
+        *cursor = NULL;
+        return NULL;
+    }
+    char *end = s + strcspn(s, ", ");
+    if (*end)
+        *end++ = '\0';
+    *cursor = end;
+    return s;
+}
+
 int parse_register(const char *token)
 {
     if (token[0] == 'r' || token[0] == 'R')
@@ -83,6 +78,10 @@ int get_opcode(const char *mnemonic)
         return 0x37;
     if (!strcmp(mnemonic, "sd"))
         return 0x3F;
+    if (!strcmp(mnemonic, "lui"))
+        return 0x0F;
+    if (!strcmp(mnemonic, "ori"))
+        return 0x0D;
     return 0;
 }
 
@@ -98,103 +97,155 @@ int get_funct(const char *mnemonic)
         return 0x1E;
     if (!strcmp(mnemonic, "mflo"))
         return 0x12;
+    if (!strcmp(mnemonic, "dsubu"))
+        return 0x2F;
+    if (!strcmp(mnemonic, "mfhi"))
+        return 0x10;
+    if (!strcmp(mnemonic, "dsll"))
+        return 0x38;
+    if (!strcmp(mnemonic, "dsrl"))
+        return 0x3A;
+    if (!strcmp(mnemonic, "dsra"))
+        return 0x3B;
+    if (!strcmp(mnemonic, "dsll32"))
+        return 0x3C;
+    if (!strcmp(mnemonic, "dsrl32"))
+        return 0x3E;
+    if (!strcmp(mnemonic, "dsra32"))
+        return 0x3F;
     return 0;
 }
 
 /* ===================== REMOVE .data / .code ===================== */
 
-void remove_data_and_code_section()
+void remove_data_and_code_section(BaiCompiler *ctx)
 {
+    if (ctx->machine.data_address_capacity < ctx->names.count)
+    {
+        int *addr = (int *)realloc(ctx->machine.data_address, ctx->names.count * sizeof(int));
+        if (!addr)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        ctx->machine.data_address = addr;
+        ctx->machine.data_address_capacity = ctx->names.count;
+    }
+    for (int d = 0; d < ctx->names.count; d++)
+        ctx->machine.data_address[d] = -1;
+
     int i = 0;
-    while (i < assembly_code_count)
+    while (i < ctx->target.assembly_code_count)
     {
-        char *line = assembly_code[i].assembly;
+        ASSEMBLY *line = &ctx->target.assembly_code[i];
 
-        char label[32];
-        if (sscanf(line, "%31[^:]:", label) == 1)
+        // Every line up to and including .code takes an 8-byte slot
+        // (the .data directive too), as the label scan always did
+        if (line->assembly[0] != '\0' && line->assembly[0] != ':')
         {
-            trim(label);
-            strcpy(data_symbols[data_symbol_count].label, label);
-            data_symbols[data_symbol_count].address = current_data_address;
-            data_symbol_count++;
-            current_data_address += 8;
+            if (line->sym != INTERN_NONE)
+                ctx->machine.data_address[line->sym] = ctx->machine.current_data_address;
+            ctx->machine.data_symbol_count++;
+            ctx->machine.current_data_address += 8;
         }
 
-        if (strstr(assembly_code[i].assembly, ".code"))
+        if (strstr(line->assembly, ".code"))
         {
-            start_code_counter = i + 1;
+            ctx->machine.start_code_counter = i + 1;
             break;
         }
         i++;
     }
 
     int j = 0;
-    for (i = start_code_counter; i < assembly_code_count; i++, j++)
-        strcpy(assembly_code[j].assembly, assembly_code[i].assembly);
+    for (i = ctx->machine.start_code_counter; i < ctx->target.assembly_code_count; i++, j++)
+        ctx->target.assembly_code[j] = ctx->target.assembly_code[i];
 
-    assembly_code_count = j;
+    ctx->target.assembly_code_count = j;
 }
 
 /* ===================== MACHINE CODE GENERATOR ===================== */
 
-void convert_to_machine_code()
+void convert_to_machine_code(BaiCompiler *ctx)
 {
     char mnemonic[32], operands[128];
     char bin_opcode[7], bin_rs[6], bin_rt[6], bin_rd[6], bin_shamt[6], bin_funct[7], bin_imm[17];
     char full_bin[64];
 
-    for (int i = 0; i < assembly_code_count; i++)
+    for (int i = 0; i < ctx->target.assembly_code_count; i++)
     {
-        assembly_code[i].assembly[strcspn(assembly_code[i].assembly, "\n")] = '\0';
+        ctx->target.assembly_code[i].assembly[strcspn(ctx->target.assembly_code[i].assembly, "\n")] = '\0';
 
-        if (strstr(assembly_code[i].assembly, ";"))
+        if (strstr(ctx->target.assembly_code[i].assembly, ";"))
             continue;
 
-        if (sscanf(assembly_code[i].assembly, "%31s %[^\n]", mnemonic, operands) < 1)
+        if (sscanf(ctx->target.assembly_code[i].assembly, "%31s %127[^\n]", mnemonic, operands) < 1)
             continue;
 
         trim(operands);
 
         int opcode = get_opcode(mnemonic);
         int funct = get_funct(mnemonic);
-        int rs = 0, rt = 0, rd = 0, imm = 0;
+        int rs = 0, rt = 0, rd = 0, shamt = 0, imm = 0;
         char *tok;
+        char *cursor = operands;
 
         /* ----- Operand Parsing ----- */
-        if (!strcmp(mnemonic, "mflo"))
+        if (!strcmp(mnemonic, "mflo") || !strcmp(mnemonic, "mfhi"))
         {
-            tok = strtok(operands, ", ");
+            tok = next_operand(&cursor);
             if (tok)
                 rd = parse_register(tok);
         }
         else if (!strcmp(mnemonic, "dmult") || !strcmp(mnemonic, "ddiv"))
         {
-            tok = strtok(operands, ", ");
+            tok = next_operand(&cursor);
             if (tok)
                 rs = parse_register(tok);
-            tok = strtok(NULL, ", ");
+            tok = next_operand(&cursor);
             if (tok)
                 rt = parse_register(tok);
         }
+        else if (opcode == 0 && funct >= 0x38) /* shift: rd, rt, sa */
+        {
+            tok = next_operand(&cursor);
+            if (tok)
+                rd = parse_register(tok);
+            tok = next_operand(&cursor);
+            if (tok)
+                rt = parse_register(tok);
+            tok = next_operand(&cursor);
+            if (tok)
+                shamt = atoi(tok);
+        }
+        else if (!strcmp(mnemonic, "lui")) /* rt, imm */
+        {
+            tok = next_operand(&cursor);
+            if (tok)
+                rt = parse_register(tok);
+            tok = next_operand(&cursor);
+            if (tok)
+                imm = atoi(tok);
+        }
         else if (opcode == 0) /* R-type */
         {
-            tok = strtok(operands, ", ");
+            tok = next_operand(&cursor);
             if (tok)
                 rd = parse_register(tok);
-            tok = strtok(NULL, ", ");
+            tok = next_operand(&cursor);
             if (tok)
                 rs = parse_register(tok);
-            tok = strtok(NULL, ", ");
+            tok = next_operand(&cursor);
             if (tok)
                 rt = parse_register(tok);
         }
         else /* I-type */
         {
-            tok = strtok(operands, ", ");
+            tok = next_operand(&cursor);
             if (tok)
                 rt = parse_register(tok);
 
-            tok = strtok(NULL, ", ");
+            tok = next_operand(&cursor);
             if (tok)
             {
                 char *paren = strchr(tok, '(');
@@ -208,24 +259,16 @@ void convert_to_machine_code()
 
                     rs = parse_register(base);
 
-                    int found = 0;
-                    for (int d = 0; d < data_symbol_count; d++)
-                    {
-                        if (!strcmp(tok, data_symbols[d].label))
-                        {
-                            imm = data_symbols[d].address;
-                            found = 1;
-                            break;
-                        }
-                    }
-
-                    if (!found)
+                    int sym = ctx->target.assembly_code[i].sym;
+                    if (sym != INTERN_NONE && ctx->machine.data_address[sym] != -1)
+                        imm = ctx->machine.data_address[sym];
+                    else
                         imm = atoi(tok);
                 }
                 else
                 {
                     rs = parse_register(tok);
-                    tok = strtok(NULL, ", ");
+                    tok = next_operand(&cursor);
                     if (tok)
                         imm = atoi(tok);
                 }
@@ -237,7 +280,7 @@ void convert_to_machine_code()
         convert_to_binary(rs, 5, bin_rs);
         convert_to_binary(rt, 5, bin_rt);
         convert_to_binary(rd, 5, bin_rd);
-        convert_to_binary(0, 5, bin_shamt);
+        convert_to_binary(shamt, 5, bin_shamt);
         convert_to_binary(funct, 6, bin_funct);
         convert_to_binary(imm & 0xFFFF, 16, bin_imm);
 
@@ -254,47 +297,67 @@ void convert_to_machine_code()
             hex_val = (hex_val << 1) | (full_bin[b] == '1');
 
         /* ----- STORE in machine_code_list[] ----- */
-        strcpy(machine_code_list[machine_code_count].assembly, assembly_code[i].assembly);
-        strcpy(machine_code_list[machine_code_count].machine_bin, full_bin);
-        machine_code_list[machine_code_count].machine_hex = hex_val;
-        machine_code_count++;
+        if (ctx->machine.machine_code_count == ctx->machine.machine_code_capacity)
+        {
+            int capacity = ctx->machine.machine_code_capacity ? ctx->machine.machine_code_capacity * 2 : 256;
+            MachineCodeEntry *list = (MachineCodeEntry *)realloc(ctx->machine.machine_code_list,
+                                                                 capacity * sizeof(MachineCodeEntry));
+            if (!list)
+            {
+                fprintf(stderr, "Out of memory\n");
+                exit(1);
+            }
+            ctx->machine.machine_code_list = list;
+            ctx->machine.machine_code_capacity = capacity;
+        }
+        strcpy(ctx->machine.machine_code_list[ctx->machine.machine_code_count].assembly, ctx->target.assembly_code[i].assembly);
+        strcpy(ctx->machine.machine_code_list[ctx->machine.machine_code_count].machine_bin, full_bin);
+        ctx->machine.machine_code_list[ctx->machine.machine_code_count].machine_hex = hex_val;
+        ctx->machine.machine_code_count++;
 
         /* Console Output */
-        printf("%-25s -> %s (0x%08X)\n",
-               assembly_code[i].assembly, full_bin, hex_val);
+        TRACE(&ctx->trace, TRACE_MC, TRACE_FULL, "%-25s -> %s (0x%08X)\n",
+              ctx->target.assembly_code[i].assembly, full_bin, hex_val);
     }
 }
 
 /* ===================== WRITE TO FILE ===================== */
 
-void output_machine_file()
+void output_machine_file(BaiCompiler *ctx)
 {
-    FILE *f_assembly = fopen("output_machine_assembly.txt", "w");
-    FILE *f_bin = fopen("output_machine_bin.txt", "w");
-    FILE *f_hex = fopen("output_machine_hex.txt", "w");
-    if (!f_assembly || !f_bin || !f_hex)
-    {
-        printf("ERROR: Cannot write output file for machine code!\n");
-        return;
-    }
+    bai_output_clear(ctx, BAI_OUT_MACHINE_ASSEMBLY);
+    bai_output_clear(ctx, BAI_OUT_MACHINE_BIN);
+    bai_output_clear(ctx, BAI_OUT_MACHINE_HEX);
 
-    for (int i = 0; i < machine_code_count; i++)
+    for (int i = 0; i < ctx->machine.machine_code_count; i++)
     {
-        fprintf(f_assembly, "%s\n", machine_code_list[i].assembly);
-        fprintf(f_bin, "%s\n", machine_code_list[i].machine_bin);
-        fprintf(f_hex, "%08X\n", machine_code_list[i].machine_hex);
+        bai_output_printf(ctx, BAI_OUT_MACHINE_ASSEMBLY, "%s\n", ctx->machine.machine_code_list[i].assembly);
+        bai_output_printf(ctx, BAI_OUT_MACHINE_BIN, "%s\n", ctx->machine.machine_code_list[i].machine_bin);
+        bai_output_printf(ctx, BAI_OUT_MACHINE_HEX, "%08X\n", ctx->machine.machine_code_list[i].machine_hex);
     }
-
-    fclose(f_assembly);
-    fclose(f_bin);
-    fclose(f_hex);
 }
 
 /* ===================== MAIN ENTRY ===================== */
 
-void generate_machine_code()
+void generate_machine_code(BaiCompiler *ctx)
+{
+    ctx->machine.start_code_counter = 0;
+    ctx->machine.data_symbol_count = 0;
+    ctx->machine.current_data_address = 0xFFF8;
+    ctx->machine.machine_code_count = 0;
+
+    remove_data_and_code_section(ctx);
+    convert_to_machine_code(ctx);
+    output_machine_file(ctx);
+}
+
+void machine_cleanup(BaiCompiler *ctx)
 {
-    remove_data_and_code_section();
-    convert_to_machine_code();
-    output_machine_file();
+    free(ctx->machine.data_address);
+    ctx->machine.data_address = NULL;
+    ctx->machine.data_address_capacity = 0;
+    free(ctx->machine.machine_code_list);
+    ctx->machine.machine_code_list = NULL;
+    ctx->machine.machine_code_count = 0;
+    ctx->machine.machine_code_capacity = 0;
 }
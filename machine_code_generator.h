@@ -8,15 +8,42 @@
 #include <ctype.h>
 #include "target_code_generator.h"
 
-#define R_TYPE_COUNT 5
-#define I_TYPE_COUNT 3
+#define R_TYPE_COUNT 13
+#define I_TYPE_COUNT 5
 
 typedef struct
 {
     char code[33]; // 32 bits + null terminator
 } MACHINE;
 
+typedef struct
+{
+    char assembly[MAX_ASSEMBLY_LINE];
+    char machine_bin[64];
+    unsigned int machine_hex;
+} MachineCodeEntry;
+
+// Encoder state for one compilation
+typedef struct
+{
+    int start_code_counter;
+
+    // .data address per intern ID, -1 for names without a slot
+    int *data_address;
+    int data_address_capacity;
+    int data_symbol_count;
+    int current_data_address;
+
+    // one entry per encoded line; grows as needed, kept across compiles
+    MachineCodeEntry *machine_code_list;
+    int machine_code_count;
+    int machine_code_capacity;
+} MachineState;
+
+typedef struct BaiCompiler BaiCompiler;
+
 // Function prototype
-void generate_machine_code(void);
+void generate_machine_code(BaiCompiler *ctx);
+void machine_cleanup(BaiCompiler *ctx);
 
 #endif // MACHINE_CODE_GENERERATOR_H
@@ -2,210 +2,100 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "ast.h"
-#include "yacc.tab.h"
-#include "semantic_analyzer.h"
-#include "intermediate_code_generator.h"
-#include "target_code_generator.h"
-#include "machine_code_generator.h"
-#include "symbol_table.h"
-
-extern int yyparse(void);
-extern int parse_failed;
-extern FILE *yyin;
-extern ASTNode *root;
-
-int parse_failed = 0;
-int sem_errors = 0;
-
-void write_error_file(const char *filename, const char *msg)
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "compiler.h"
+#include "serve.h"
+
+/* --serve: stdout carries only response frames, so the phase logging that
+   normally goes to stdout is pointed at stderr for the life of the process */
+static int run_server(void)
 {
-    FILE *f = fopen(filename, "w");
-    if (f)
-    {
-        fprintf(f, "%s\n", msg);
-        fclose(f);
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+    int proto_fd = _dup(_fileno(stdout));
+    _dup2(_fileno(stderr), _fileno(stdout));
+#else
+    int proto_fd = dup(fileno(stdout));
+    dup2(fileno(stderr), fileno(stdout));
+#endif
+
+    FILE *proto = proto_fd >= 0 ? fdopen(proto_fd, "wb") : NULL;
+    if (!proto)
+    {
+        fprintf(stderr, "Error: unable to set up the --serve output channel\n");
+        return 1;
     }
-}
-
-void write_machine_error_files(const char *error_msg)
-{
-    // Write the same error message to all machine code output files
-    // This ensures the Electron process finds consistent error messages
-    write_error_file("output_machine_assembly.txt", error_msg);
-    write_error_file("output_machine_bin.txt", error_msg);
-    write_error_file("output_machine_hex.txt", error_msg);
-    // Also write to the legacy single file for backward compatibility
-    write_error_file("output_machine.txt", error_msg);
-}
 
-void write_assembly_error_file(const char *error_msg)
-{
-    write_error_file("output_assembly.txt", error_msg);
+    int status = bai_serve(stdin, proto);
+    fclose(proto);
+    return status;
 }
 
-void write_tac_error_file(const char *error_msg)
+int main(int argc, char *argv[])
 {
-    write_error_file("output_tac.txt", error_msg);
-}
-
-void write_print_error_file(const char *error_msg)
-{
-    write_error_file("output_print.txt", error_msg);
-}
+    if (argc > 1 && strcmp(argv[1], "--serve") == 0)
+        return run_server();
 
-void initialize_output_files()
-{
-    // Clear all output files at start
-    write_error_file("output_assembly.txt", "");
-    write_error_file("output_machine_assembly.txt", "");
-    write_error_file("output_machine_bin.txt", "");
-    write_error_file("output_machine_hex.txt", "");
-    write_error_file("output_machine.txt", "");
-    write_error_file("output_tac.txt", "");
-    write_error_file("output_print.txt", "");
-}
-
-int main()
-{
-    // === STEP 0: OPEN SOURCE FILE ===
-    yyin = fopen("input.txt", "r");
-    if (!yyin)
+    BaiCompiler *ctx = bai_compiler_new();
+    if (!ctx)
     {
-        printf("Error: unable to open input.txt\n");
-        // Write error to all output files
-        write_assembly_error_file("Error: unable to open input.txt");
-        write_machine_error_files("Error: unable to open input.txt");
-        write_tac_error_file("Error: unable to open input.txt");
-        write_print_error_file("Error: unable to open input.txt");
+        fprintf(stderr, "Error: out of memory\n");
         return 1;
     }
 
-    printf("=== BaiScript IS PARSING! ===\n\n");
-
-    parse_failed = 0; // reset before starting
-    islexerror = 0;   // reset before starting
-
-    // Initialize all output files to empty
-    initialize_output_files();
+    // console logging: everything, unless BAI_TRACE says otherwise
+    trace_set_all(&ctx->trace, TRACE_FULL);
+    const char *spec = getenv("BAI_TRACE");
+    if (spec && !trace_configure(&ctx->trace, spec))
+        fprintf(stderr, "Warning: ignoring unknown items in BAI_TRACE=%s\n", spec);
 
-    int result = yyparse();
-
-    if (result == 0 && !parse_failed)
-    {
-        printf("[PARSE] Accepted\n\n");
-        printf("== AST ==\n");
-        print_ast(root, 0);
-    }
-    else
+    // --fast-lexer: scan with the hand-written scanner (no [LEX] trace lines)
+    // --trace=SPEC: console logging levels, applied after BAI_TRACE (see trace.h)
+    // --time-passes / --stats=json: per-phase timings and counters on stderr (see stats.h)
+    int stats_json = 0;
+    for (int i = 1; i < argc; i++)
     {
-        const char *parse_error_msg = "No assembly generated due to parse errors.";
-        printf("[PARSE] Failed - writing error messages to output files\n");
-        write_assembly_error_file(parse_error_msg);
-        write_machine_error_files("No machine code generated due to parse errors.");
-        write_tac_error_file("No TAC generated due to parse errors.");
+        if (strcmp(argv[i], "--fast-lexer") == 0)
+            ctx->fast_lexer = 1;
+        else if (strncmp(argv[i], "--trace=", 8) == 0 && !trace_configure(&ctx->trace, argv[i] + 8))
+            fprintf(stderr, "Warning: ignoring unknown items in %s\n", argv[i]);
+        else if (strcmp(argv[i], "--time-passes") == 0 || strcmp(argv[i], "--stats=table") == 0)
+            ctx->stats.enabled = 1;
+        else if (strcmp(argv[i], "--stats=json") == 0)
+            ctx->stats.enabled = stats_json = 1;
     }
 
-    printf("\n=== BaiScript IS PARSED! ===\n");
-
-    // === STEP 2: SEMANTIC ANALYSIS ===
-    printf("\n=== BaiScript SEMANTIC ANALYSIS ===\n\n");
-
-    if (result == 0 && !parse_failed)
-    {
-        // analyze AST
-        sem_errors = semantic_analyzer(); // assign to global
-
-        if (sem_errors == 0)
-        {
-            printf("[MAIN] Semantic analysis passed.\n");
-        }
-        else
-        {
-            printf("[MAIN] Semantic analysis failed with %d error(s).\n", sem_errors);
-            // Write semantic errors to output files
-            char sem_error_msg[256];
-            snprintf(sem_error_msg, sizeof(sem_error_msg),
-                     "No assembly generated due to %d semantic error(s).", sem_errors);
-            write_assembly_error_file(sem_error_msg);
-            write_machine_error_files("No machine code generated due to semantic errors.");
-            write_tac_error_file("No TAC generated due to semantic errors.");
-        }
-    }
-    else
-    {
-        printf("[MAIN] Skipping semantic analysis due to parse errors.\n");
-    }
-
-    printf("\n=== BaiScript SEMANTIC ANALYSIS ENDED ===\n\n");
-
-    // === STEP 3: INTERMEDIATE CODE GENERATION ===
-    printf("\n=== BaiScript INTERMEDIATE CODE GENERATION ===\n\n");
-
-    if (sem_errors > 0)
-    {
-        printf("[MAIN] Skipping intermediate code generation due to semantic errors.\n");
-        // Error messages already written in semantic analysis step
-    }
-    else if (result == 0 && !parse_failed)
-    {
-        generate_intermediate_code(root);
-        printf("[MAIN] Intermediate code generation completed.\n");
-    }
-    else
-    {
-        printf("[MAIN] Skipping intermediate code generation due to parse errors.\n");
-    }
-
-    printf("\n=== BaiScript INTERMEDIATE CODE GENERATION ENDED ===\n\n");
-
-    // === STEP 4: TARGET CODE GENERATION ===
-    printf("\n=== BaiScript TARGET CODE GENERATION ===\n\n");
-
-    if (sem_errors > 0)
-    {
-        printf("[MAIN] Skipping target code generation due to semantic errors.\n");
-        // Error messages already written in semantic analysis step
-    }
-    else if (result == 0 && !parse_failed)
-    {
-        generate_target_code();
-        printf("[MAIN] Target code generation completed.\n");
-    }
-    else
-    {
-        printf("[MAIN] Skipping target code generation due to parse errors.\n");
-    }
-
-    printf("\n=== BaiScript TARGET CODE GENERATION ENDED ===\n\n");
-
-    // === STEP 5: MACHINE CODE GENERATION ===
-    printf("\n=== BaiScript MACHINE CODE GENERATION ===\n\n");
-
-    if (sem_errors > 0)
-    {
-        printf("[MAIN] Skipping machine code generation due to semantic errors.\n");
-        // Error messages already written in semantic analysis step
-    }
-    else if (result == 0 && !parse_failed)
-    {
-        generate_machine_code();
-    }
-    else
+    // === STEP 0: OPEN SOURCE FILE ===
+    FILE *in = fopen("input.txt", "r");
+    if (!in)
     {
-        printf("[MAIN] Skipping machine code generation due to parse errors.\n");
+        printf("Error: unable to open input.txt\n");
+        // Write error to all output files
+        for (int i = 0; i < BAI_OUT_COUNT; i++)
+            bai_write_output(ctx, (BaiOutput)i, "Error: unable to open input.txt");
+        bai_save_outputs(ctx);
+        bai_compiler_free(ctx);
+        return 1;
     }
 
-    printf("\n=== BaiScript MACHINE CODE GENERATION ENDED ===\n\n");
+    int failed = bai_compile_file(ctx, in);
 
-    // === SYMBOL TABLE ===
-    printf("\n=== BaiScript SYMBOL TABLE ===\n\n");
-    print_symbol_table();
-
-    fclose(yyin);
+    fclose(in);
+    if (stats_json)
+        stats_print_json(&ctx->stats, stderr);
+    else if (ctx->stats.enabled)
+        stats_print_table(&ctx->stats, stderr);
+    bai_compiler_free(ctx);
 
     // Return appropriate exit code
-    if (result != 0 || parse_failed || sem_errors > 0)
+    if (failed)
     {
         printf("\n\nCompilation failed with errors\n\n");
         return 1;
@@ -215,4 +105,4 @@ int main()
         printf("\n\n[MAIN] Compilation successful\n\n");
         return 0;
     }
-}
\ No newline at end of file
+}
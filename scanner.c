@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scanner.h"
+#include "compiler.h"
+#include "yacc.tab.h"
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define SCAN_SSE2 1
+#endif
+
+/* Reentrant flex scanner (lex.l), used unless ctx->fast_lexer is set */
+int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner);
+
+void scanner_init(Scanner *s, const char *src, size_t len)
+{
+    s->src = src;
+    s->len = len;
+    s->pos = 0;
+}
+
+/* ----------------------------
+Character runs
+---------------------------- */
+
+// Length of the run of blanks and newlines at p; newlines are added to *lines
+static size_t blank_run(const unsigned char *p, size_t n, int *lines)
+{
+    size_t i = 0;
+
+#ifdef SCAN_SSE2
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i nl = _mm_set1_epi8('\n');
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i is_nl = _mm_cmpeq_epi8(v, nl);
+        __m128i blank = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, tab)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, cr), is_nl));
+        unsigned other = ~(unsigned)_mm_movemask_epi8(blank) & 0xffffu;
+        unsigned newlines = (unsigned)_mm_movemask_epi8(is_nl);
+
+        if (other)
+        {
+            unsigned k = (unsigned)__builtin_ctz(other);
+            *lines += __builtin_popcount(newlines & ((1u << k) - 1));
+            return i + k;
+        }
+        *lines += __builtin_popcount(newlines);
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        if (p[i] == '\n')
+            (*lines)++;
+        else if (p[i] != ' ' && p[i] != '\t' && p[i] != '\r')
+            break;
+    }
+    return i;
+}
+
+static int is_word(unsigned char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static int is_digit(unsigned char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+#ifdef SCAN_SSE2
+// Bytes of v in [lo, hi]. The compares are signed, so bytes >= 0x80 never match.
+static __m128i in_range(__m128i v, char lo, char hi)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char)(lo - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8((char)(hi + 1))));
+}
+#endif
+
+// Length of the run of [A-Za-z0-9_] at p
+static size_t word_run(const unsigned char *p, size_t n)
+{
+    size_t i = 0;
+
+#ifdef SCAN_SSE2
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i word = _mm_or_si128(_mm_or_si128(in_range(lower, 'a', 'z'), in_range(v, '0', '9')),
+                                    _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+        unsigned other = ~(unsigned)_mm_movemask_epi8(word) & 0xffffu;
+        if (other)
+            return i + (unsigned)__builtin_ctz(other);
+    }
+#endif
+
+    while (i < n && is_word(p[i]))
+        i++;
+    return i;
+}
+
+// Length of the run of [0-9] at p
+static size_t digit_run(const unsigned char *p, size_t n)
+{
+    size_t i = 0;
+
+#ifdef SCAN_SSE2
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        unsigned other = ~(unsigned)_mm_movemask_epi8(in_range(v, '0', '9')) & 0xffffu;
+        if (other)
+            return i + (unsigned)__builtin_ctz(other);
+    }
+#endif
+
+    while (i < n && is_digit(p[i]))
+        i++;
+    return i;
+}
+
+// Keywords all differ in length, so the length picks the only candidate
+static int keyword(const char *s, size_t len)
+{
+    switch (len)
+    {
+    case 4: return memcmp(s, "KUAN", 4) == 0 ? KUAN : IDENTIFIER;
+    case 5: return memcmp(s, "PRENT", 5) == 0 ? PRENT : IDENTIFIER;
+    case 6: return memcmp(s, "CHAROT", 6) == 0 ? CHAROT : IDENTIFIER;
+    case 7: return memcmp(s, "ENTEGER", 7) == 0 ? ENTEGER : IDENTIFIER;
+    default: return IDENTIFIER;
+    }
+}
+
+/* ----------------------------
+Lexical errors (same text as lex.l)
+---------------------------- */
+
+static void invalid_character(BaiCompiler *ctx, char c)
+{
+    if (ctx->islexerror == 0) {                                     // only log the first error
+        char text[2] = {c, '\0'};
+        bai_output_clear(ctx, BAI_OUT_PRINT);                       // overwrite the file
+        bai_output_printf(ctx, BAI_OUT_PRINT, "Invalid Character (%s) [line:%d]\n", text, ctx->lineCount);
+        bai_report(ctx, BAI_DIAG_ERROR, ctx->lineCount, "Invalid Character (%s)", text);
+        ctx->islexerror = 1;                                        // mark that an error was logged
+    }
+    ctx->parse_failed = 1;
+}
+
+static void empty_character(BaiCompiler *ctx)
+{
+    if (ctx->islexerror == 0) {                                     // only log the first error
+        bai_output_clear(ctx, BAI_OUT_PRINT);                       // overwrite the file
+        bai_output_printf(ctx, BAI_OUT_PRINT, "Invalid Empty Character [line:%d]\n", ctx->lineCount);
+        bai_report(ctx, BAI_DIAG_ERROR, ctx->lineCount, "Invalid Empty Character");
+        ctx->islexerror = 1;                                        // mark that an error was logged
+    }
+    ctx->parse_failed = 1;
+}
+
+/* ----------------------------
+Scanner
+---------------------------- */
+
+// Operator at p, longest match first; 0 if p does not start one
+static int operator_token(const char *p, size_t n, size_t *len)
+{
+    char next = n > 1 ? p[1] : '\0';
+
+    *len = 2;
+    switch (p[0])
+    {
+    case '+':
+        if (next == '=') return PLUS_EQUAL;
+        if (next == '+') return PLUSPLUS;
+        break;
+    case '-':
+        if (next == '=') return MINUS_EQUAL;
+        if (next == '-') return MINUSMINUS;
+        break;
+    case '*':
+        if (next == '=') return MUL_EQUAL;
+        break;
+    case '/':
+        if (next == '=') return DIV_EQUAL;
+        break;
+    }
+
+    *len = 1;
+    switch (p[0])
+    {
+    case '+': return PLUS;
+    case '-': return MINUS;
+    case '*': return MUL;
+    case '/': return DIV;
+    case '=': return EQUAL;
+    case '!': return EXCLAM;
+    case '(': return LPAREN;
+    case ')': return RPAREN;
+    case ',': return COMMA;
+    default:  return 0;
+    }
+}
+
+int scanner_next(BaiCompiler *ctx, Scanner *s, ScanToken *tok)
+{
+    const char *src = s->src;
+    size_t len = s->len;
+
+    for (;;)
+    {
+        s->pos += blank_run((const unsigned char *)src + s->pos, len - s->pos, &ctx->lineCount);
+        if (s->pos >= len)
+        {
+            tok->type = 0;
+            tok->offset = (uint32_t)len;
+            tok->length = 0;
+            return 0;
+        }
+
+        size_t start = s->pos;
+        const char *p = src + start;
+        size_t rest = len - start;
+        unsigned char c = (unsigned char)p[0];
+        size_t n = 0;
+        int type = 0;
+
+        if (c == '/' && rest > 1 && p[1] == '/')
+        {
+            // line comment, up to (not including) the newline
+            const char *end = (const char *)memchr(p, '\n', rest);
+            s->pos = end ? (size_t)(end - src) : len;
+            continue;
+        }
+        if (c == '/' && rest > 1 && p[1] == '*')
+        {
+            // block comment; like lex.l, newlines inside do not advance lineCount
+            const char *q = p + 2;
+            const char *end = src + len;
+            s->pos = len;
+            while ((q = (const char *)memchr(q, '*', (size_t)(end - q))) != NULL && q + 1 < end)
+            {
+                if (q[1] == '/')
+                {
+                    s->pos = (size_t)(q + 2 - src);
+                    break;
+                }
+                q++;
+            }
+            continue;
+        }
+
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')
+        {
+            n = word_run((const unsigned char *)p, rest);
+            type = keyword(p, n);
+        }
+        else if (is_digit(c))
+        {
+            n = digit_run((const unsigned char *)p, rest);
+            type = INT_LITERAL;
+        }
+        else if (c == '\'')
+        {
+            if (rest >= 3 && p[1] != '\\' && p[1] != '\'' && p[2] == '\'')
+                n = 3, type = CHAR_LITERAL;
+            else if (rest >= 4 && p[1] == '\\' && p[2] != '\n' && p[3] == '\'')
+                n = 4, type = CHAR_LITERAL;
+            else if (rest >= 2 && p[1] == '\'')
+            {
+                empty_character(ctx);
+                s->pos += 2;
+                continue;
+            }
+        }
+        else if (c == '"')
+        {
+            // strings may span lines; like lex.l, lineCount does not see them
+            const char *end = (const char *)memchr(p + 1, '"', rest - 1);
+            if (end)
+                n = (size_t)(end - p) + 1, type = STRING_LITERAL;
+        }
+        else
+            type = operator_token(p, rest, &n);
+
+        if (!type)
+        {
+            invalid_character(ctx, (char)c);
+            s->pos++;
+            continue;
+        }
+
+        s->pos += n;
+        tok->type = type;
+        tok->offset = (uint32_t)start;
+        tok->length = (uint32_t)n;
+        return type;
+    }
+}
+
+/* ----------------------------
+Parser entry point
+---------------------------- */
+
+// Called by yyparse() for every token; picks the scanner for this compile
+int bai_lex(YYSTYPE *yylval, BaiCompiler *ctx, yyscan_t scanner)
+{
+    if (!ctx->fast_lexer)
+    {
+        int type = yylex(yylval, scanner);
+        if (type)
+            ctx->stats.tokens++;
+        return type;
+    }
+
+    ScanToken tok;
+    int type = scanner_next(ctx, &ctx->scan, &tok);
+    if (type)
+        ctx->stats.tokens++;
+
+    switch (type)
+    {
+    case IDENTIFIER:
+    case INT_LITERAL:
+    case CHAR_LITERAL:
+    case STRING_LITERAL:
+        yylval->sym = intern(&ctx->names, &ctx->arena, ctx->scan.src + tok.offset, tok.length);
+        break;
+    default:
+        break;
+    }
+    return type;
+}
@@ -0,0 +1,42 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct BaiCompiler BaiCompiler;
+
+/* ----------------------------
+Hand-written scanner
+
+An alternative to the flex scanner in lex.l, selected with
+BaiCompiler.fast_lexer. It runs over the whole source buffer in place:
+blanks, identifier and number runs are found 16 bytes at a time with
+SSE2 where available, keywords are matched by length (each keyword has
+a different one), and every token is an (offset, length) slice of the
+buffer. Only identifiers and literals are interned; nothing else is
+copied. It accepts exactly what lex.l accepts, reports the same lexical
+errors and keeps ctx->lineCount the same way, but it does not print the
+"[LEX] ..." trace lines.
+---------------------------- */
+
+typedef struct
+{
+    int type;           /* token code from yacc.tab.h, 0 at end of input */
+    uint32_t offset;    /* slice of the source buffer */
+    uint32_t length;
+} ScanToken;
+
+typedef struct
+{
+    const char *src;    /* not owned, must outlive the parse */
+    size_t len;
+    size_t pos;
+} Scanner;
+
+void scanner_init(Scanner *s, const char *src, size_t len);
+
+/* Scans the next token into *tok and returns its type (0 at the end) */
+int scanner_next(BaiCompiler *ctx, Scanner *s, ScanToken *tok);
+
+#endif /* SCANNER_H */
@@ -1,110 +1,103 @@
 #include "semantic_analyzer.h"
 #include "ast.h"
 #include "symbol_table.h"
+#include "compiler.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <ctype.h>
+#include <limits.h>
 
 /* ----------------------------
 Internal structures
 ---------------------------- */
 
-static SEM_TEMP *sem_temps = NULL;
-static size_t sem_temps_capacity = 0;
-static size_t sem_temps_count = 0;
-static int sem_next_temp_id = 1;
-
-static SEM_OP *sem_ops = NULL;
-static size_t sem_ops_capacity = 0;
-static size_t sem_ops_count = 0;
-
-static KnownVar *known_vars_head = NULL;
-
-static int sem_errors = 0;
-static int sem_warnings = 0;
-static int sem_inside_print = 0; // 1 if evaluating inside a PRENT
-
-static FILE *out_file = NULL;
-
 /* Deferred postfix ops (kept for possible future policy changes) */
 typedef struct DeferredOp
 {
-    KnownVar *kv;
+    int var;   // index into ctx->symbols (entries may move before the op is applied)
     int delta; // +1 for ++, -1 for --
     struct DeferredOp *next;
 } DeferredOp;
 
-static DeferredOp *deferred_head = NULL;
-
 /* ----------------------------
 Helpers: error/warning
 ---------------------------- */
 
-static void sem_record_error(ASTNode *node, const char *fmt, ...)
+static void sem_record_error(BaiCompiler *ctx, AstRef node, const char *fmt, ...)
 {
-    sem_errors++;
+    const AstTree *ast = &ctx->ast;
 
-    if (!out_file)
-        return;
+    ctx->sem.errors++;
 
-    fprintf(out_file, "ERROR: ");
+    bai_output_printf(ctx, BAI_OUT_PRINT, "ERROR: ");
 
     va_list ap;
     va_start(ap, fmt);
-    vfprintf(out_file, fmt, ap);
+    bai_output_vprintf(ctx, BAI_OUT_PRINT, fmt, ap);
     va_end(ap);
 
     if (node)
-        fprintf(out_file, " [line:%d]\n", node->line);
+        bai_output_printf(ctx, BAI_OUT_PRINT, " [line:%d]\n", ast_line(ast, node));
+
+    va_start(ap, fmt);
+    char msg[512];
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    bai_report(ctx, BAI_DIAG_ERROR, node ? ast_line(ast, node) : 0, "%s", msg);
 }
 
-static void sem_record_warning(ASTNode *node, const char *fmt, ...)
+static void sem_record_warning(BaiCompiler *ctx, AstRef node, const char *fmt, ...)
 {
-    sem_warnings++;
+    const AstTree *ast = &ctx->ast;
 
-    if (!out_file)
-        return;
+    ctx->sem.warnings++;
 
     va_list ap;
     va_start(ap, fmt);
-    vfprintf(out_file, fmt, ap);
+    bai_output_vprintf(ctx, BAI_OUT_PRINT, fmt, ap);
     va_end(ap);
 
     if (node)
-        fprintf(out_file, " [line:%d]\n", node->line);
+        bai_output_printf(ctx, BAI_OUT_PRINT, " [line:%d]\n", ast_line(ast, node));
+
+    va_start(ap, fmt);
+    char msg[512];
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    bai_report(ctx, BAI_DIAG_WARNING, node ? ast_line(ast, node) : 0, "%s", msg);
 }
 
 /* ----------------------------
 Dynamic arrays helpers
 ---------------------------- */
 
-static int ensure_temp_capacity(void)
+static int ensure_temp_capacity(BaiCompiler *ctx)
 {
-    if (sem_temps_count + 1 > sem_temps_capacity)
+    if (ctx->sem.temps_count + 1 > ctx->sem.temps_capacity)
     {
-        size_t newcap = sem_temps_capacity == 0 ? 256 : sem_temps_capacity * 2;
-        SEM_TEMP *nb = (SEM_TEMP *)realloc(sem_temps, newcap * sizeof(SEM_TEMP));
+        size_t newcap = ctx->sem.temps_capacity == 0 ? 256 : ctx->sem.temps_capacity * 2;
+        SEM_TEMP *nb = (SEM_TEMP *)realloc(ctx->sem.temps, newcap * sizeof(SEM_TEMP));
         if (!nb)
             return 0;
-        sem_temps = nb;
-        sem_temps_capacity = newcap;
+        ctx->sem.temps = nb;
+        ctx->sem.temps_capacity = newcap;
     }
     return 1;
 }
 
-static int ensure_ops_capacity(void)
+static int ensure_ops_capacity(BaiCompiler *ctx)
 {
-    if (sem_ops_count + 1 > sem_ops_capacity)
+    if (ctx->sem.ops_count + 1 > ctx->sem.ops_capacity)
     {
-        size_t newcap = sem_ops_capacity == 0 ? 256 : sem_ops_capacity * 2;
-        SEM_OP *nb = (SEM_OP *)realloc(sem_ops, newcap * sizeof(SEM_OP));
+        size_t newcap = ctx->sem.ops_capacity == 0 ? 256 : ctx->sem.ops_capacity * 2;
+        SEM_OP *nb = (SEM_OP *)realloc(ctx->sem.ops, newcap * sizeof(SEM_OP));
         if (!nb)
             return 0;
-        sem_ops = nb;
-        sem_ops_capacity = newcap;
+        ctx->sem.ops = nb;
+        ctx->sem.ops_capacity = newcap;
     }
     return 1;
 }
@@ -113,24 +106,24 @@ static int ensure_ops_capacity(void)
 Deferred postfix helpers
 (retained but not used for current immediate semantics)
 ---------------------------- */
-static void push_deferred_op(KnownVar *kv, int delta)
+static void push_deferred_op(BaiCompiler *ctx, SymbolEntry *var, int delta)
 {
     DeferredOp *d = (DeferredOp *)malloc(sizeof(DeferredOp));
     if (!d)
         return;
-    d->kv = kv;
+    d->var = (int)(var - ctx->symbols.entries);
     d->delta = delta;
-    d->next = deferred_head;
-    deferred_head = d;
+    d->next = ctx->sem.deferred_head;
+    ctx->sem.deferred_head = d;
 }
 
-static void apply_deferred_ops(void)
+static void apply_deferred_ops(BaiCompiler *ctx)
 {
-    if (!deferred_head)
+    if (!ctx->sem.deferred_head)
         return;
 
     // Reverse the list for FIFO
-    DeferredOp *prev = NULL, *cur = deferred_head;
+    DeferredOp *prev = NULL, *cur = ctx->sem.deferred_head;
     while (cur)
     {
         DeferredOp *n = cur->next;
@@ -142,27 +135,20 @@ static void apply_deferred_ops(void)
 
     for (DeferredOp *p = r; p; p = p->next)
     {
-        KnownVar *kv = p->kv;
-        if (!kv)
-            continue;
-        if (!kv->initialized)
+        SymbolEntry *var = &ctx->symbols.entries[p->var];
+        if (!var->initialized)
         {
-            sem_record_error(kv->temp.node, "Postfix operation on uninitialized variable '%s'", kv->name);
+            sem_record_error(ctx, AST_NULL, "Postfix operation on uninitialized variable '%s'", var->name);
             continue;
         }
-        long before = kv->temp.is_constant ? kv->temp.int_value : 0;
+        long before = var->is_constant ? var->int_value : 0;
         long after = before + p->delta;
-        kv->temp.is_constant = 1;
-        kv->temp.int_value = after;
-        kv->initialized = 1;
-        kv->used = 1;
-
-        int idx = find_symbol(kv->name);
-        if (idx != -1)
-        {
-            symbol_table[idx].initialized = 1;
-            snprintf(symbol_table[idx].value_str, SYMBOL_VALUE_MAX, "%ld", after);
-        }
+        var->is_constant = 1;
+        var->int_value = after;
+        var->initialized = 1;
+        var->used = 1;
+        var->value_kind = SYM_VALUE_INT;
+        var->value = after;
     }
 
     // free list
@@ -173,72 +159,74 @@ static void apply_deferred_ops(void)
         free(it);
         it = n;
     }
-    deferred_head = NULL;
+    ctx->sem.deferred_head = NULL;
 }
 
 /* ----------------------------
 Public helpers
 ---------------------------- */
 
-SEM_TEMP sem_new_temp(SEM_TYPE type)
+SEM_TEMP sem_new_temp(BaiCompiler *ctx, SEM_TYPE type)
 {
-    if (!ensure_temp_capacity())
+    if (!ensure_temp_capacity(ctx))
     {
-        SEM_TEMP t = {0, SEM_TYPE_UNKNOWN, 0, 0, NULL};
+        SEM_TEMP t = {0, SEM_TYPE_UNKNOWN, 0, 0, AST_NULL};
         return t;
     }
     SEM_TEMP t;
-    t.id = sem_next_temp_id++;
+    t.id = ctx->sem.next_temp_id++;
     t.type = type;
     t.is_constant = 0;
     t.int_value = 0;
-    t.node = NULL;
-    sem_temps[sem_temps_count++] = t;
+    t.node = AST_NULL;
+    ctx->sem.temps[ctx->sem.temps_count++] = t;
     return t;
 }
 
-KnownVar *sem_find_var(const char *name)
+SymbolEntry *sem_find_var(BaiCompiler *ctx, int sym)
 {
-    for (KnownVar *k = known_vars_head; k; k = k->next)
-        if (strcmp(k->name, name) == 0)
-            return k;
-    return NULL;
+    int idx = find_symbol(&ctx->symbols, sym);
+    return idx == -1 ? NULL : &ctx->symbols.entries[idx];
 }
 
-KnownVar *sem_add_var(const char *name, SEM_TYPE type)
+SymbolEntry *sem_add_var(BaiCompiler *ctx, int sym, SEM_TYPE type)
 {
-    /* If already present, return existing KnownVar (do not treat as error here). */
-    KnownVar *existing = sem_find_var(name);
+    /* If already present, return the existing entry (do not treat as error here). */
+    SymbolEntry *existing = sem_find_var(ctx, sym);
     if (existing)
         return existing;
 
-    KnownVar *k = (KnownVar *)malloc(sizeof(KnownVar));
-    if (!k)
+    int initialized = (type == SEM_TYPE_INT || type == SEM_TYPE_CHAR); // KUAN starts uninitialized
+
+    int idx = add_symbol(&ctx->symbols, sym, intern_name(&ctx->names, sym), type, initialized);
+    if (idx == -1)
         return NULL;
-    k->name = strdup(name);
-    if (!k->name) { free(k); return NULL; }
-    k->temp = sem_new_temp(type);
-    k->used = 0;
-    k->next = known_vars_head;
-    known_vars_head = k;
-
-    if (type == SEM_TYPE_INT || type == SEM_TYPE_CHAR) {
-        k->initialized = 1;
-        k->temp.is_constant = 1;
-        k->temp.int_value = 0;
-    } else {
-        k->initialized = 0; // KUAN starts uninitialized
-    }
 
-    const char *dtype_str = "KUAN";
-    if (type == SEM_TYPE_INT) dtype_str = "ENTEGER";
-    else if (type == SEM_TYPE_CHAR) dtype_str = "CHAROT";
+    SymbolEntry *var = &ctx->symbols.entries[idx];
+    if (initialized) {
+        var->is_constant = 1;
+        var->int_value = 0;
+    }
+    return var;
+}
 
-    int idx = find_symbol(name);
-    if (idx == -1)
-        add_symbol(name, dtype_str, k->initialized, k->initialized ? NULL : NULL);
+/* sem_add_var() for the variable named at `node`. A new name longer than
+   MAX_IDENTIFIER_LENGTH would not fit its ld/sd and .data lines, so it is
+   reported here; the variable is still added to keep later errors quiet. */
+static SymbolEntry *declare_var(BaiCompiler *ctx, AstRef node, int sym, SEM_TYPE type)
+{
+    const char *name = intern_name(&ctx->names, sym);
+    if (!sem_find_var(ctx, sym) && strlen(name) > MAX_IDENTIFIER_LENGTH)
+        sem_record_error(ctx, node, "Identifier '%.32s...' is longer than %d characters",
+                         name, MAX_IDENTIFIER_LENGTH);
+    return sem_add_var(ctx, sym, type);
+}
 
-    return k;
+/* Current value of a variable as an expression result */
+static SEM_TEMP var_value(const SymbolEntry *var, AstRef node)
+{
+    SEM_TEMP t = {0, (SEM_TYPE)var->type, var->is_constant, var->int_value, node};
+    return t;
 }
 
 
@@ -256,469 +244,440 @@ SEM_TYPE sem_type_from_string(const char *s)
 }
 
 /* ----------------------------
-Constant helpers
+Expression evaluation
 ---------------------------- */
 
-static int try_parse_int(const char *s, long *out)
+static void push_value(BaiCompiler *ctx, SEM_TEMP v)
 {
-    if (!s || !out)
-        return 0;
-    char *end;
-    long v = strtol(s, &end, 10);
-    if (end != s && *end == '\0')
+    if (ctx->sem.values_count == ctx->sem.values_capacity)
     {
-        *out = v;
-        return 1;
-    }
-    return 0;
-}
-
-static int try_parse_char_literal(const char *lex, long *out)
-{
-    if (!lex || !out)
-        return 0;
-    size_t len = strlen(lex);
-    if (len < 3 || lex[0] != '\'' || lex[len - 1] != '\'')
-        return 0;
-    size_t content_len = len - 2;
-    if (content_len == 1)
-    {
-        *out = (unsigned char)lex[1];
-        return 1;
-    }
-    if (content_len == 2 && lex[1] == '\\')
-    {
-        char esc = lex[2];
-        switch (esc)
+        size_t newcap = ctx->sem.values_capacity == 0 ? 256 : ctx->sem.values_capacity * 2;
+        SEM_TEMP *nb = (SEM_TEMP *)realloc(ctx->sem.values, newcap * sizeof(SEM_TEMP));
+        if (!nb)
         {
-        case 'n':
-            *out = '\n';
-            return 1;
-        case 't':
-            *out = '\t';
-            return 1;
-        case 'r': // no proper logic yet
-            *out = '\r';
-        case '0':
-            *out = '\0';
-            return 1;
-        case '\\':
-            *out = '\\';
-            return 1;
-        case '\'':
-            *out = '\'';
-            return 1;
-        case '"':
-            *out = '"';
-            return 1;
-        default:
-            return 0;
+            fprintf(stderr, "Memory allocation failed in push_value()\n");
+            exit(1);
         }
+        ctx->sem.values = nb;
+        ctx->sem.values_capacity = newcap;
     }
-    return 0;
+    ctx->sem.values[ctx->sem.values_count++] = v;
 }
 
-/* ----------------------------
-Expression evaluation
----------------------------- */
-
-static SEM_TEMP evaluate_expression(ASTNode *node);
-static SEM_TEMP eval_factor(ASTNode *node);
-static SEM_TEMP eval_term(ASTNode *node);
-static SEM_TEMP eval_additive(ASTNode *node);
+static SEM_TEMP pop_value(BaiCompiler *ctx)
+{
+    return ctx->sem.values[--ctx->sem.values_count];
+}
 
-static SEM_TEMP eval_factor(ASTNode *node)
+// Identifier or literal
+static SEM_TEMP eval_leaf(BaiCompiler *ctx, AstRef node)
 {
-    if (!node)
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
+    const AstTree *ast = &ctx->ast;
 
-    if (node->type == NODE_LITERAL)
+    if (ast_type(ast, node) == NODE_LITERAL)
     {
-        long v;
         SEM_TEMP t;
-        if (try_parse_int(node->value, &v))
+        switch (ast_kind(ast, node))
         {
-            t = sem_new_temp(SEM_TYPE_INT);
-            t.is_constant = 1;
-            t.int_value = v;
-            t.node = node;
-            return t;
-        }
-        if (try_parse_char_literal(node->value, &v))
-        {
-            t = sem_new_temp(SEM_TYPE_CHAR);
-            t.is_constant = 1;
-            t.int_value = v;
-            t.node = node;
-            return t;
+        case AST_LIT_INT:
+            t = sem_new_temp(ctx, SEM_TYPE_INT);
+            break;
+        case AST_LIT_CHAR:
+            t = sem_new_temp(ctx, SEM_TYPE_CHAR);
+            break;
+        default:
+            // the parser leaves a character literal it cannot decode undecoded
+            sem_record_error(ctx, node, "Invalid escape in character literal %s",
+                             intern_name(&ctx->names, ast_sym(ast, node)));
+            return sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
         }
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
+        t.is_constant = 1;
+        t.int_value = ast_lit(ast, node);
+        t.node = node;
+        return t;
     }
 
-    if (node->type == NODE_IDENTIFIER)
-    {
-        const char *name = node->value;
-        if (!name)
-            return sem_new_temp(SEM_TYPE_UNKNOWN);
+    const char *name = intern_name(&ctx->names, ast_sym(ast, node));
+    if (!name)
+        return sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
 
-        KnownVar *kv = sem_find_var(name);
-        if (kv)
-        {
-            kv->used = 1; // mark as used
-            if (sem_inside_print)
-                kv->used = 1; // redundant but explicit
-            if (!kv->initialized)
-                sem_record_error(node, "Use of uninitialized variable '%s'", name);
-            SEM_TEMP t = kv->temp;
-            t.node = node;
-            return t;
-        }
-
-        int idx = find_symbol(name);
-        if (idx == -1)
-        {
-            sem_record_error(node, "Undeclared identifier '%s'", name);
-            return sem_new_temp(SEM_TYPE_UNKNOWN);
-        }
-
-        SEM_TYPE stype = sem_type_from_string(symbol_table[idx].datatype);
-        SEM_TEMP placeholder = sem_new_temp(stype);
-        placeholder.node = node;
-
-        KnownVar *new_kv = sem_add_var(name, stype);
-        new_kv->used = 1;
-        new_kv->initialized = symbol_table[idx].initialized;
-        if (symbol_table[idx].initialized)
-        {
-            long vv = 0;
-            if (try_parse_int(symbol_table[idx].value_str, &vv))
-            {
-                new_kv->temp.is_constant = 1;
-                new_kv->temp.int_value = vv;
-            }
-        }
-        return placeholder;
+    SymbolEntry *var = sem_find_var(ctx, ast_sym(ast, node));
+    if (!var)
+    {
+        sem_record_error(ctx, node, "Undeclared identifier '%s'", name);
+        return sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
     }
 
-    return evaluate_expression(node);
+    var->used = 1; // mark as used
+    if (!var->initialized)
+        sem_record_error(ctx, node, "Use of uninitialized variable '%s'", name);
+    return var_value(var, node);
 }
 
-static SEM_TEMP eval_term(ASTNode *node)
+// Binary + - * / once both operands are known
+static SEM_TEMP fold_binary(BaiCompiler *ctx, AstRef node, SEM_TEMP L, SEM_TEMP R)
 {
-    if (!node)
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
-    if (node->type != NODE_TERM)
-        return eval_factor(node);
-
-    if (!node->left || !node->right)
-    {
-        if (node->left)  evaluate_expression(node->left);
-        if (node->right) evaluate_expression(node->right);
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
-    }
-
-    SEM_TEMP L = eval_term(node->left);
-    SEM_TEMP R = eval_factor(node->right);
-    const char *op = node->value ? node->value : "";
+    const AstTree *ast = &ctx->ast;
 
     long val = 0;
     SEM_TYPE result_type = SEM_TYPE_INT;
 
-    // -----------------------------
-    // TYPE RESOLUTION (same as additive)
-    // -----------------------------
+    // Determine result type based on operand types
     if (L.type == SEM_TYPE_CHAR && R.type == SEM_TYPE_CHAR)
-        result_type = SEM_TYPE_CHAR;
+        result_type = SEM_TYPE_CHAR;       // CHAR + CHAR
     else if (L.type == SEM_TYPE_CHAR && R.type == SEM_TYPE_INT)
-        result_type = SEM_TYPE_CHAR;
+        result_type = SEM_TYPE_CHAR;       // CHAR + INT → CHAR
     else if (L.type == SEM_TYPE_INT && R.type == SEM_TYPE_CHAR)
-        result_type = SEM_TYPE_INT;
+        result_type = SEM_TYPE_INT;        // INT + CHAR → INT
     else
-        result_type = SEM_TYPE_INT;
+        result_type = SEM_TYPE_INT;        // INT + INT or unknown
 
-    // -----------------------------
-    // CONSTANT FOLDING (if possible)
-    // -----------------------------
-    if (L.is_constant && R.is_constant && op[0] != '\0')
+    // Constant folding if possible
+    if (L.is_constant && R.is_constant)
     {
-        if (strcmp(op, "*") == 0)
-        {
-            val = L.int_value * R.int_value;
-        }
-        else if (strcmp(op, "/") == 0)
+        switch (ast_op(ast, node))
         {
+        case AST_OP_ADD: val = L.int_value + R.int_value; break;
+        case AST_OP_SUB: val = L.int_value - R.int_value; break;
+        case AST_OP_MUL: val = L.int_value * R.int_value; break;
+        case AST_OP_DIV:
             if (R.int_value == 0)
             {
-                sem_record_error(node, "Division by zero");
+                sem_record_error(ctx, node, "Division by zero");
                 val = 0;
             }
+            else if (L.int_value == LONG_MIN && R.int_value == -1)
+            {
+                // dividing would trap; the quotient wraps like the folds above
+                val = LONG_MIN;
+            }
             else
             {
                 val = L.int_value / R.int_value;
             }
+            break;
+        default:         val = 0; break; // fallback
         }
     }
 
-    // -----------------------------
-    // RESULT TEMP
-    // -----------------------------
-    SEM_TEMP t = sem_new_temp(result_type);
-    t.node = node;
+    SEM_TEMP t = sem_new_temp(ctx, result_type);
     t.is_constant = (L.is_constant && R.is_constant);
     t.int_value = val;
+    t.node = node;
     t.type = result_type;
 
     return t;
 }
 
-static SEM_TEMP eval_additive(ASTNode *node)
+// Prefix ++a / --a: applied at once, the operand is not evaluated
+static SEM_TEMP eval_prefix(BaiCompiler *ctx, AstRef node)
 {
-    if (!node)
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
-    if (node->type != NODE_EXPRESSION)
-        return eval_term(node);
+    const AstTree *ast = &ctx->ast;
+    AstOp opcode = ast_op(ast, node);
+    const char *op = ast_op_text(opcode);
 
-    if (!node->left || !node->right)
+    AstRef target = ast_left(ast, node);
+    if (!target || ast_type(ast, target) != NODE_IDENTIFIER)
     {
-        if (node->left)
-            evaluate_expression(node->left);
-        if (node->right)
-            evaluate_expression(node->right);
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
+        sem_record_error(ctx, node, "Prefix %s applied to non-identifier", op);
+        return sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
     }
+    const char *name = intern_name(&ctx->names, ast_sym(ast, target));
+    SymbolEntry *var = sem_find_var(ctx, ast_sym(ast, target));
+    if (var && ctx->sem.inside_print)
+        var->used = 1;
+    if (!var)
+        var = declare_var(ctx, target, ast_sym(ast, target), SEM_TYPE_INT);
+    if (!var->initialized)
+    {
+        sem_record_error(ctx, target, "Prefix %s on uninitialized variable '%s'", op, name);
+        // but still mark initialized and continue
+        var->initialized = 1;
+        var->is_constant = 1;
+        var->int_value = 0;
+    }
+    int delta = opcode == AST_OP_INC ? 1 : -1;
+    long newval = (var->is_constant ? var->int_value : 0) + delta;
+    var->is_constant = 1;
+    var->int_value = newval;
+    var->initialized = 1;
+    var->value_kind = SYM_VALUE_INT;
+    var->value = newval;
+
+    SEM_TEMP r = sem_new_temp(ctx, (SEM_TYPE)var->type);
+    r.is_constant = 1;
+    r.int_value = newval;
+    r.node = node;
+    return r;
+}
 
-    SEM_TEMP L = eval_additive(node->left);
-    SEM_TEMP R = eval_term(node->right);
-    const char *op = node->value ? node->value : "";
-
-    long val = 0;
-    SEM_TYPE result_type = SEM_TYPE_INT;
+// Unary minus and other unary ops, once the operand is known
+static SEM_TEMP fold_unary(BaiCompiler *ctx, AstRef node, SEM_TEMP t)
+{
+    if (t.is_constant && ast_op(&ctx->ast, node) == AST_OP_SUB)
+    {
+        SEM_TEMP r = sem_new_temp(ctx, t.type);
+        r.is_constant = 1;
+        r.int_value = -t.int_value;
+        r.node = node;
+        return r;
+    }
+    return t;
+}
 
-    // Determine result type based on operand types
-    if (L.type == SEM_TYPE_CHAR && R.type == SEM_TYPE_CHAR)
-        result_type = SEM_TYPE_CHAR;       // CHAR + CHAR
-    else if (L.type == SEM_TYPE_CHAR && R.type == SEM_TYPE_INT)
-        result_type = SEM_TYPE_CHAR;       // CHAR + INT → CHAR
-    else if (L.type == SEM_TYPE_INT && R.type == SEM_TYPE_CHAR)
-        result_type = SEM_TYPE_INT;        // INT + CHAR → INT
-    else
-        result_type = SEM_TYPE_INT;        // INT + INT or unknown
+// Postfix a++ / a--: yields the old value, the delta is deferred
+static SEM_TEMP eval_postfix(BaiCompiler *ctx, AstRef node)
+{
+    const AstTree *ast = &ctx->ast;
+    const char *op = ast_op_text(ast_op(ast, node));
+    AstRef target = ast_left(ast, node);
+    if (!target || ast_type(ast, target) != NODE_IDENTIFIER) {
+        sem_record_error(ctx, node, "Postfix %s applied to non-identifier", op);
+        return sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
+    }
 
-    // Constant folding if possible
-    if (L.is_constant && R.is_constant)
-    {
-        if (strcmp(op, "+") == 0)
-            val = L.int_value + R.int_value;
-        else if (strcmp(op, "-") == 0)
-            val = L.int_value - R.int_value;
-        else
-            val = 0; // fallback
+    const char *name = intern_name(&ctx->names, ast_sym(ast, target));
+    SymbolEntry *var = sem_find_var(ctx, ast_sym(ast, target));
+    if (!var) {
+        sem_record_error(ctx, node, "Use of undeclared variable '%s'", name);
+        return sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
     }
+    if (!var->initialized)
+        sem_record_error(ctx, target, "Use of uninitialized variable '%s' in postfix", name);
 
-    SEM_TEMP t = sem_new_temp(result_type);
-    t.is_constant = (L.is_constant && R.is_constant);
-    t.int_value = val;
-    t.node = node;
-    t.type = result_type;
+    SEM_TEMP ret = var_value(var, node); // return current value
 
-    return t;
+    // Determine delta
+    int delta = 0;
+    if (ast_op(ast, node) == AST_OP_INC) delta = 1;
+    else if (ast_op(ast, node) == AST_OP_DEC) delta = -1;
+
+    // **Defer the delta instead of applying immediately**
+    if (delta != 0)
+        push_deferred_op(ctx, var, delta);
+
+    return ret;  // return old value
 }
 
+// Assignment inside an expression, before the RHS is evaluated.
+// Returns 0 if the target is not an identifier (the RHS is then skipped).
+static int begin_assignment(BaiCompiler *ctx, AstRef node)
+{
+    const AstTree *ast = &ctx->ast;
+    AstRef lhs = ast_left(ast, node);
 
-static SEM_TEMP evaluate_expression(ASTNode *node)
+    if (!lhs || ast_type(ast, lhs) != NODE_IDENTIFIER) {
+        sem_record_error(ctx, node, "Left side of assignment is not an identifier");
+        return 0;
+    }
+
+    declare_var(ctx, lhs, ast_sym(ast, lhs), SEM_TYPE_INT);
+    return 1;
+}
+
+static SEM_TEMP finish_assignment(BaiCompiler *ctx, AstRef node, SEM_TEMP rval)
 {
-    if (!node)
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
+    const AstTree *ast = &ctx->ast;
+    AstRef lhs = ast_left(ast, node);
+    const char *name = intern_name(&ctx->names, ast_sym(ast, lhs));
 
-    switch (node->type)
-    {
-    case NODE_TERM:
-        return eval_term(node);
-    case NODE_EXPRESSION:
-        return eval_additive(node);
-    case NODE_UNARY_OP:
+    // the RHS may have added variables; look the target up again
+    SymbolEntry *var = sem_find_var(ctx, ast_sym(ast, lhs));
+
+    long oldval = 0;
+    if (ast_op(ast, node) != AST_OP_ASSIGN)   // compound assignment requires reading old value
     {
-        // prefix operators: e.g. ++a, --a, unary -
-        const char *op = node->value ? node->value : "";
-        if (op && (strcmp(op, "++") == 0 || strcmp(op, "--") == 0))
-        {
-            ASTNode *target = node->left;
-            if (!target || target->type != NODE_IDENTIFIER)
-            {
-                sem_record_error(node, "Prefix %s applied to non-identifier", op);
-                return sem_new_temp(SEM_TYPE_UNKNOWN);
-            }
-            const char *name = target->value;
-            KnownVar *kv = sem_find_var(name);
-            if (kv && sem_inside_print)
-                kv->used = 1;
-            if (!kv)
-                kv = sem_add_var(name, SEM_TYPE_INT);
-            if (!kv->initialized)
-            {
-                sem_record_error(target, "Prefix %s on uninitialized variable '%s'", op, name);
-                // but still mark initialized and continue
-                kv->initialized = 1;
-                kv->temp.is_constant = 1;
-                kv->temp.int_value = 0;
-            }
-            int delta = (strcmp(op, "++") == 0) ? 1 : -1;
-            long newval = (kv->temp.is_constant ? kv->temp.int_value : 0) + delta;
-            kv->temp.is_constant = 1;
-            kv->temp.int_value = newval;
-            kv->initialized = 1;
-
-            int idx = find_symbol(kv->name);
-            if (idx != -1)
-            {
-                symbol_table[idx].initialized = 1;
-                snprintf(symbol_table[idx].value_str, SYMBOL_VALUE_MAX, "%ld", newval);
-            }
+        if (!var->initialized)
+            sem_record_error(ctx, node, "Use of uninitialized variable '%s' in compound assignment", name);
 
-            SEM_TEMP r = sem_new_temp(kv->temp.type);
-            r.is_constant = 1;
-            r.int_value = newval;
-            r.node = node;
-            return r;
-        }
-        // unary minus and other unary ops
-        {
-            SEM_TEMP t = evaluate_expression(node->left);
-            if (t.is_constant && op && op[0] != '\0' && strcmp(op, "-") == 0)
-            {
-                SEM_TEMP r = sem_new_temp(t.type);
-                r.is_constant = 1;
-                r.int_value = -t.int_value;
-                r.node = node;
-                return r;
-            }
-            return t;
-        }
+        oldval = var->is_constant ? var->int_value : 0;
     }
-    case NODE_POSTFIX_OP: {
-        const char *op = node->value ? node->value : "";
-        ASTNode *target = node->left;
-        if (!target || target->type != NODE_IDENTIFIER) {
-            sem_record_error(node, "Postfix %s applied to non-identifier", op);
-            return sem_new_temp(SEM_TYPE_UNKNOWN);
-        }
 
-        const char *name = target->value;
-        KnownVar *kv = sem_find_var(name);
-        if (!kv) {
-            sem_record_error(node, "Use of undeclared variable '%s'", name);
-            return sem_new_temp(SEM_TYPE_UNKNOWN);
-        }
-        if (!kv->initialized)
-            sem_record_error(target, "Use of uninitialized variable '%s' in postfix", name);
+    long newval = rval.int_value;
 
-        SEM_TEMP ret = kv->temp; // return current value
-        ret.node = node;
+    // Handle compound operators
+    switch (ast_op(ast, node))
+    {
+    case AST_OP_ADD_ASSIGN: newval = oldval + rval.int_value; break;
+    case AST_OP_SUB_ASSIGN: newval = oldval - rval.int_value; break;
+    case AST_OP_MUL_ASSIGN: newval = oldval * rval.int_value; break;
+    case AST_OP_DIV_ASSIGN:
+        if (rval.int_value == 0)
+            sem_record_error(ctx, node, "Division by zero");
+        else
+            newval = oldval / rval.int_value;
+        break;
+    case AST_OP_ASSIGN:
+        // simple assignment, already handled
+        break;
+    default:
+        sem_record_error(ctx, node, "Unknown assignment operator '%s'", ast_op_text(ast_op(ast, node)));
+        break;
+    }
 
-        // Determine delta
-        int delta = 0;
-        if (strcmp(op, "++") == 0) delta = 1;
-        else if (strcmp(op, "--") == 0) delta = -1;
+    // Assign result
+    var->initialized = 1;
+    var->is_constant = 1;
+    var->int_value = newval;
+    var->value_kind = SYM_VALUE_INT;
+    var->value = newval;
 
-        // **Defer the delta instead of applying immediately**
-        if (delta != 0)
-            push_deferred_op(kv, delta);
+    SEM_TEMP ret = sem_new_temp(ctx, SEM_TYPE_INT);
+    ret.is_constant = 1;
+    ret.int_value = newval;
+    ret.node = node;
 
-        return ret;  // return old value
-    }
-    case NODE_ASSIGNMENT:
-    {
-        ASTNode *lhs = node->left;
-        ASTNode *rhs = node->right;
+    return ret;
+}
 
-        if (!lhs || lhs->type != NODE_IDENTIFIER) {
-            sem_record_error(node, "Left side of assignment is not an identifier");
-            return sem_new_temp(SEM_TYPE_UNKNOWN);
-        }
+// Progress through an expression node on the walk stack
+enum
+{
+    EVAL_ENTER,     // no operand evaluated yet
+    EVAL_LEFT,      // left (or only) operand is on the value stack
+    EVAL_RIGHT      // right operand is on the value stack
+};
+
+// Evaluates the expression at `root`, operands left to right. The tree
+// is walked with ctx->sem.walk instead of recursion; each finished
+// subexpression leaves its value on ctx->sem.values for its parent.
+static SEM_TEMP evaluate_expression(BaiCompiler *ctx, AstRef root)
+{
+    const AstTree *ast = &ctx->ast;
+    AstStack *walk = &ctx->sem.walk;
+    size_t base = walk->count;
 
-        const char *name = lhs->value;
-        KnownVar *kv = sem_add_var(name, SEM_TYPE_INT);
+    ast_push(walk, root, EVAL_ENTER, 0);
 
-        const char *op = node->value ? node->value : "=";
+    while (walk->count > base)
+    {
+        AstFrame *f = &walk->frames[walk->count - 1];
+        AstRef node = f->node;
+        AstRef left = node ? ast_left(ast, node) : AST_NULL;
+        AstRef right = node ? ast_right(ast, node) : AST_NULL;
+        SEM_TEMP result;
 
-        // Evaluate RHS expression first
-        SEM_TEMP rval = evaluate_expression(rhs);
+        if (!node)
+        {
+            result = sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
+            walk->count--;
+            push_value(ctx, result);
+            continue;
+        }
 
-        long oldval = 0;
-        if (strcmp(op, "=") != 0)   // compound assignment requires reading old value
+        switch (ast_type(ast, node))
         {
-            if (!kv->initialized)
-                sem_record_error(node, "Use of uninitialized variable '%s' in compound assignment", name);
+        case NODE_IDENTIFIER:
+        case NODE_LITERAL:
+            result = eval_leaf(ctx, node);
+            break;
 
-            oldval = kv->temp.is_constant ? kv->temp.int_value : 0;
-        }
+        case NODE_UNARY_OP:
+            // prefix operators: e.g. ++a, --a, unary -
+            if (ast_op(ast, node) == AST_OP_INC || ast_op(ast, node) == AST_OP_DEC)
+            {
+                result = eval_prefix(ctx, node);
+                break;
+            }
+            if (f->state == EVAL_ENTER)
+            {
+                f->state = EVAL_LEFT;
+                ast_push(walk, left, EVAL_ENTER, 0);
+                continue;
+            }
+            result = fold_unary(ctx, node, pop_value(ctx));
+            break;
 
-        long newval = rval.int_value;
+        case NODE_POSTFIX_OP:
+            result = eval_postfix(ctx, node);
+            break;
 
-        // Handle compound operators
-        if      (strcmp(op, "+=") == 0) newval = oldval + rval.int_value;
-        else if (strcmp(op, "-=") == 0) newval = oldval - rval.int_value;
-        else if (strcmp(op, "*=") == 0) newval = oldval * rval.int_value;
-        else if (strcmp(op, "/=") == 0) {
-            if (rval.int_value == 0)
-                sem_record_error(node, "Division by zero");
-            else
-                newval = oldval / rval.int_value;
-        }
-        else if (strcmp(op, "=") == 0) {
-            // simple assignment, already handled
-        }
-        else {
-            sem_record_error(node, "Unknown assignment operator '%s'", op);
-        }
+        case NODE_ASSIGNMENT:
+            if (f->state == EVAL_ENTER)
+            {
+                if (!begin_assignment(ctx, node))
+                {
+                    result = sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
+                    break;
+                }
+                // Evaluate RHS expression first
+                f->state = EVAL_LEFT;
+                ast_push(walk, right, EVAL_ENTER, 0);
+                continue;
+            }
+            result = finish_assignment(ctx, node, pop_value(ctx));
+            break;
 
-        // Assign result
-        kv->initialized = 1;
-        kv->temp.is_constant = 1;
-        kv->temp.int_value = newval;
+        case NODE_TERM:
+        case NODE_EXPRESSION:
+            if (left && right)
+            {
+                if (f->state == EVAL_ENTER)
+                {
+                    f->state = EVAL_LEFT;
+                    ast_push(walk, left, EVAL_ENTER, 0);
+                    continue;
+                }
+                if (f->state == EVAL_LEFT)
+                {
+                    f->state = EVAL_RIGHT;
+                    ast_push(walk, right, EVAL_ENTER, 0);
+                    continue;
+                }
+                SEM_TEMP R = pop_value(ctx);
+                SEM_TEMP L = pop_value(ctx);
+                result = fold_binary(ctx, node, L, R);
+                break;
+            }
+            // fall through: a half-built operation is evaluated like any other node
 
-        int idx = find_symbol(name);
-        if (idx != -1) {
-            symbol_table[idx].initialized = 1;
-            snprintf(symbol_table[idx].value_str, SYMBOL_VALUE_MAX, "%ld", newval);
+        default:
+            // evaluate whatever children there are, then give up on the value
+            if (f->state == EVAL_ENTER)
+            {
+                f->state = EVAL_LEFT;
+                if (left)
+                {
+                    ast_push(walk, left, EVAL_ENTER, 0);
+                    continue;
+                }
+            }
+            if (f->state == EVAL_LEFT)
+            {
+                if (left)
+                    pop_value(ctx);
+                f->state = EVAL_RIGHT;
+                if (right)
+                {
+                    ast_push(walk, right, EVAL_ENTER, 0);
+                    continue;
+                }
+            }
+            if (right)
+                pop_value(ctx);
+            result = sem_new_temp(ctx, SEM_TYPE_UNKNOWN);
+            break;
         }
 
-        SEM_TEMP ret = sem_new_temp(SEM_TYPE_INT);
-        ret.is_constant = 1;
-        ret.int_value = newval;
-        ret.node = node;
-
-        return ret;
+        walk->count--;
+        push_value(ctx, result);
     }
 
-    case NODE_IDENTIFIER:
-    case NODE_LITERAL:
-        return eval_factor(node);
-    default:
-        if (node->left)
-            evaluate_expression(node->left);
-        if (node->right)
-            evaluate_expression(node->right);
-        return sem_new_temp(SEM_TYPE_UNKNOWN);
-    }
+    return pop_value(ctx);
 }
 
 /* ----------------------------
 Buffers for output
 ---------------------------- */
-#define PRINT_BUFFER_SIZE 8192
-static char print_buffer[PRINT_BUFFER_SIZE];
-static size_t print_offset = 0;
-
-static void buffer_print(const char *s)
+static void buffer_print(BaiCompiler *ctx, const char *s)
 {
     if (!s)
         return;
     size_t len = strlen(s);
-    if (print_offset + len < PRINT_BUFFER_SIZE - 2)
+    if (ctx->sem.print_offset + len < PRINT_BUFFER_SIZE - 2)
     {
-        strcpy(print_buffer + print_offset, s);
-        print_offset += len;
+        strcpy(ctx->sem.print_buffer + ctx->sem.print_offset, s);
+        ctx->sem.print_offset += len;
     }
 }
 
@@ -766,20 +725,22 @@ static void unescape_string(const char *src, char *dst, size_t dstsize)
 /* ----------------------------
 Handle print statements (printf-like)
 ---------------------------- */
-static void handle_print(ASTNode *print_node)
+static void handle_print(BaiCompiler *ctx, AstRef print_node)
 {
+    const AstTree *ast = &ctx->ast;
+
     if (!print_node)
         return;
 
-    sem_inside_print = 1; // Begin print context
+    ctx->sem.inside_print = 1; // Begin print context
 
-    ASTNode *item = print_node->left;
+    AstRef item = ast_left(ast, print_node);
     while (item)
     {
-        ASTNode *expr = item->left ? item->left : item;
+        AstRef expr = ast_left(ast, item) ? ast_left(ast, item) : item;
 
-        if (expr->type == NODE_STRING_LITERAL) {
-            const char *s = expr->value;
+        if (ast_type(ast, expr) == NODE_STRING_LITERAL) {
+            const char *s = intern_name(&ctx->names, ast_sym(ast, expr));
             size_t len = s ? strlen(s) : 0;
 
             if (len >= 2) {
@@ -795,24 +756,24 @@ static void handle_print(ASTNode *print_node)
                 /* unescape into another buffer and then print */
                 char unesc[1024];
                 unescape_string(raw, unesc, sizeof(unesc));
-                buffer_print(unesc);
+                buffer_print(ctx, unesc);
             }
 
-            item = item->right;
+            item = ast_right(ast, item);
             continue;
         }
 
         char tempbuf[1024] = {0};
 
         // Evaluate expression
-        SEM_TEMP val = evaluate_expression(expr);
+        SEM_TEMP val = evaluate_expression(ctx, expr);
         
         // If identifier, update usage
-        if (expr->type == NODE_IDENTIFIER)
+        if (ast_type(ast, expr) == NODE_IDENTIFIER)
         {
-            KnownVar *kv = sem_find_var(expr->value);
-            if (kv)
-                kv->used = 1;
+            SymbolEntry *var = sem_find_var(ctx, ast_sym(ast, expr));
+            if (var)
+                var->used = 1;
         }
 
         // Decide how to print based on actual variable type
@@ -831,101 +792,92 @@ static void handle_print(ASTNode *print_node)
             snprintf(tempbuf, sizeof(tempbuf), "%ld", val.int_value);
         }
 
-        buffer_print(tempbuf);
+        buffer_print(ctx, tempbuf);
 
         // Move to next item in list (comma-separated)
-        item = item->right;
+        item = ast_right(ast, item);
     }
 
-    buffer_print("\n"); // Append newline at end of PRENT
-    sem_inside_print = 0; // End print context
+    buffer_print(ctx, "\n"); // Append newline at end of PRENT
+    ctx->sem.inside_print = 0; // End print context
 }
 
 
 /* ----------------------------
 Declaration & assignment
 ---------------------------- */
-void handle_declaration(ASTNode *decl_node, SEM_TYPE dtype)
+static void declare_one(BaiCompiler *ctx, AstRef decl_node, SEM_TYPE dtype)
 {
-    if (!decl_node)
-        return;
+    const AstTree *ast = &ctx->ast;
 
     /* Simple identifier declaration */
-    if (decl_node->type == NODE_IDENTIFIER)
+    if (ast_type(ast, decl_node) == NODE_IDENTIFIER)
     {
-        const char *name = decl_node->value;
-        KnownVar *existing = sem_find_var(name);
+        const char *name = intern_name(&ctx->names, ast_sym(ast, decl_node));
 
         /* Any existing declaration = ERROR */
-        if (existing)
-        {
-            sem_record_error(decl_node,
-                "Duplicate declaration of variable '%s'", name);
-            return;
-        }
-
-        /* Also check symbol table (already-declared globally) */
-        if (find_symbol(name) != -1)
+        if (sem_find_var(ctx, ast_sym(ast, decl_node)))
         {
-            sem_record_error(decl_node,
+            sem_record_error(ctx, decl_node,
                 "Duplicate declaration of variable '%s'", name);
             return;
         }
 
         /* Create new variable */
-        KnownVar *kv = sem_add_var(name, dtype);
-        if (!kv)
+        SymbolEntry *var = declare_var(ctx, decl_node, ast_sym(ast, decl_node), dtype);
+        if (!var)
         {
-            sem_record_error(decl_node,
+            sem_record_error(ctx, decl_node,
                 "Failed to declare variable '%s'", name);
             return;
         }
 
-        kv->temp.type = dtype; // store declared type
+        var->type = dtype; // store declared type
 
         /* Default initialization for typed variables */
         if (dtype == SEM_TYPE_INT || dtype == SEM_TYPE_CHAR)
         {
-            kv->temp.is_constant = 1;
-            kv->temp.int_value = 0;
-            kv->initialized = 1;
+            var->is_constant = 1;
+            var->int_value = 0;
+            var->initialized = 1;
         }
 
         return;
     }
 
     /* Initialized declaration: IDENT = EXPR */
-    if (decl_node->type == NODE_DECLARATION && strcmp(decl_node->value, "INIT_DECL") == 0)
+    if (ast_type(ast, decl_node) == NODE_DECLARATION && ast_kind(ast, decl_node) == AST_DECL_INIT)
     {
-        const char *name = decl_node->left->value;
-        ASTNode *init_expr = decl_node->right;
+        int sym = ast_sym(ast, ast_left(ast, decl_node));
+        const char *name = intern_name(&ctx->names, sym);
+        AstRef init_expr = ast_right(ast, decl_node);
 
-        /* If already declared (in known vars or symbol table), it's an error */
-        if (sem_find_var(name) || find_symbol(name) != -1) {
-            sem_record_error(decl_node, "Redeclaration of variable '%s'", name);
+        /* If already declared, it's an error */
+        if (sem_find_var(ctx, sym)) {
+            sem_record_error(ctx, decl_node, "Redeclaration of variable '%s'", name);
             return;
         }
 
         /* create new variable */
-        KnownVar *kv = sem_add_var(name, SEM_TYPE_UNKNOWN);
-        if (!kv)
+        if (!declare_var(ctx, decl_node, sym, SEM_TYPE_UNKNOWN))
         {
-            sem_record_error(decl_node, "Failed to declare variable '%s'", name);
+            sem_record_error(ctx, decl_node, "Failed to declare variable '%s'", name);
             return;
         }
 
-        SEM_TEMP val = evaluate_expression(init_expr);
+        SEM_TEMP val = evaluate_expression(ctx, init_expr);
+
+        // the initializer may have added variables; look this one up again
+        SymbolEntry *var = sem_find_var(ctx, sym);
 
         // --- KUAN adopts RHS type, others keep declared type ---
         if (dtype == SEM_TYPE_UNKNOWN) // KUAN
         {
-            kv->temp.type = val.type != SEM_TYPE_UNKNOWN ? val.type : SEM_TYPE_INT;
-            kv->temp.type = kv->temp.type;
+            var->type = val.type != SEM_TYPE_UNKNOWN ? val.type : SEM_TYPE_INT;
         }
         else
         {
-            kv->temp.type = dtype;
-            kv->temp.type = dtype;
+            var->type = dtype;
 
             // force value conversion if needed
             if (dtype == SEM_TYPE_INT && val.type == SEM_TYPE_CHAR)
@@ -934,104 +886,109 @@ void handle_declaration(ASTNode *decl_node, SEM_TYPE dtype)
                 val.int_value = (char)val.int_value;
         }
 
-        kv->temp.is_constant = val.is_constant;
-        kv->temp.int_value = val.is_constant ? val.int_value : 0;
-        kv->initialized = 1;
+        var->is_constant = val.is_constant;
+        var->int_value = val.is_constant ? val.int_value : 0;
+        var->initialized = 1;
 
-        int idx = find_symbol(name);
-        if (idx != -1)
-        {
-            symbol_table[idx].initialized = 1;
-            if (kv->temp.type == SEM_TYPE_INT)
-                snprintf(symbol_table[idx].value_str, SYMBOL_VALUE_MAX, "%ld", kv->temp.int_value);
-            else if (kv->temp.type == SEM_TYPE_CHAR)
-                snprintf(symbol_table[idx].value_str, SYMBOL_VALUE_MAX, "%c", (char)kv->temp.int_value);
-
-            if (kv->temp.type == SEM_TYPE_INT)
-                strcpy(symbol_table[idx].datatype, "ENTEGER");
-            else
-                strcpy(symbol_table[idx].datatype, "CHAROT");
-        }
+        var->value_kind = var->type == SEM_TYPE_INT ? SYM_VALUE_INT : SYM_VALUE_CHAR;
+        var->value = var->int_value;
         return;
     }
+}
+
+/* Declares every name in a declarator list, left to right */
+void handle_declaration(BaiCompiler *ctx, AstRef decl_node, SEM_TYPE dtype)
+{
+    const AstTree *ast = &ctx->ast;
+    AstStack *walk = &ctx->sem.walk;
+    size_t base = walk->count;
+
+    ast_push(walk, decl_node, 0, 0);
+
+    while (walk->count > base)
+    {
+        AstRef node = walk->frames[--walk->count].node;
+
+        if (!node)
+            continue;
+
+        if (ast_type(ast, node) == NODE_IDENTIFIER ||
+            (ast_type(ast, node) == NODE_DECLARATION && ast_kind(ast, node) == AST_DECL_INIT))
+        {
+            declare_one(ctx, node, dtype);
+            continue;
+        }
 
-    /* Otherwise recurse */
-    handle_declaration(decl_node->left, dtype);
-    handle_declaration(decl_node->right, dtype);
+        ast_push(walk, ast_right(ast, node), 0, 0);
+        ast_push(walk, ast_left(ast, node), 0, 0);
+    }
 }
 
 
-static void handle_assignment(ASTNode *assign_node)
+static void handle_assignment(BaiCompiler *ctx, AstRef assign_node)
 {
-    if (!assign_node || !assign_node->left)
+    const AstTree *ast = &ctx->ast;
+
+    if (!assign_node || !ast_left(ast, assign_node))
         return;
 
-    ASTNode *lhs = assign_node->left;
-    ASTNode *rhs = assign_node->right;
+    AstRef lhs = ast_left(ast, assign_node);
+    AstRef rhs = ast_right(ast, assign_node);
 
-    if (lhs->type != NODE_IDENTIFIER)
+    if (ast_type(ast, lhs) != NODE_IDENTIFIER)
     {
-        sem_record_error(assign_node, "Left-hand side of assignment must be an identifier");
+        sem_record_error(ctx, assign_node, "Left-hand side of assignment must be an identifier");
         return;
     }
 
-    const char *name = lhs->value;
-    KnownVar *kv = sem_find_var(name);
-
-    if (!kv)
-    {
-        // If variable not declared, create it
-        kv = sem_add_var(name, SEM_TYPE_UNKNOWN);
-    }
+    // If variable not declared, create it
+    declare_var(ctx, lhs, ast_sym(ast, lhs), SEM_TYPE_UNKNOWN);
 
     // Evaluate RHS
-    SEM_TEMP rhs_temp = evaluate_expression(rhs);
+    SEM_TEMP rhs_temp = evaluate_expression(ctx, rhs);
+
+    // the RHS may have added variables; look the target up again
+    SymbolEntry *var = sem_find_var(ctx, ast_sym(ast, lhs));
 
     // Determine old value
     long oldval = 0;
-    if (kv->initialized)
-        oldval = kv->temp.int_value;
+    if (var->initialized)
+        oldval = var->int_value;
 
     // Compute new value based on assignment type
     long newval = rhs_temp.is_constant ? rhs_temp.int_value : 0;
-    const char *op = assign_node->value ? assign_node->value : "=";
-
-    if      (strcmp(op, "+=") == 0) newval = oldval + rhs_temp.int_value;
-    else if (strcmp(op, "-=") == 0) newval = oldval - rhs_temp.int_value;
-    else if (strcmp(op, "*=") == 0) newval = oldval * rhs_temp.int_value;
-    else if (strcmp(op, "/=") == 0)
+    switch (ast_op(ast, assign_node))
     {
+    case AST_OP_ADD_ASSIGN: newval = oldval + rhs_temp.int_value; break;
+    case AST_OP_SUB_ASSIGN: newval = oldval - rhs_temp.int_value; break;
+    case AST_OP_MUL_ASSIGN: newval = oldval * rhs_temp.int_value; break;
+    case AST_OP_DIV_ASSIGN:
         if (rhs_temp.int_value == 0)
-            sem_record_error(assign_node, "Division by zero");
+            sem_record_error(ctx, assign_node, "Division by zero");
         else
             newval = oldval / rhs_temp.int_value;
-    }
-    else if (strcmp(op, "=") == 0)
-    {
+        break;
+    case AST_OP_ASSIGN:
         // simple assignment, just take RHS
         newval = rhs_temp.int_value;
-    }
-    else
-    {
-        sem_record_error(assign_node, "Unknown assignment operator '%s'", op);
+        break;
+    default:
+        sem_record_error(ctx, assign_node, "Unknown assignment operator '%s'", ast_op_text(ast_op(ast, assign_node)));
         newval = oldval; // fallback
+        break;
     }
 
     // Update variable
-    kv->temp.int_value = newval;
-    kv->temp.is_constant = 1;
-    kv->initialized = 1;
-    kv->used = 1;
-    
-    // Update symbol table
-    int idx = find_symbol(name);
-    if (idx != -1)
+    var->int_value = newval;
+    var->is_constant = 1;
+    var->initialized = 1;
+    var->used = 1;
+
+    // an untyped (KUAN) target keeps the value it last showed
+    if (var->type == SEM_TYPE_INT || var->type == SEM_TYPE_CHAR)
     {
-        symbol_table[idx].initialized = 1;
-        if (kv->temp.type == SEM_TYPE_INT)
-            snprintf(symbol_table[idx].value_str, SYMBOL_VALUE_MAX, "%ld", newval);
-        else if (kv->temp.type == SEM_TYPE_CHAR)
-            snprintf(symbol_table[idx].value_str, SYMBOL_VALUE_MAX, "%c", (char)newval);
+        var->value_kind = var->type == SEM_TYPE_INT ? SYM_VALUE_INT : SYM_VALUE_CHAR;
+        var->value = newval;
     }
 }
 
@@ -1040,46 +997,72 @@ static void handle_assignment(ASTNode *assign_node)
 AST traversal
 ---------------------------- */
 
-static void analyze_node(ASTNode *node)
+// A statement frame on the walk stack is visited twice: once to queue
+// its body, and again afterwards to apply the postfix ops it deferred
+enum
 {
-    if (!node)
-        return;
-    switch (node->type)
+    VISIT_ENTER,
+    VISIT_EXIT
+};
+
+static void analyze_node(BaiCompiler *ctx, AstRef root)
+{
+    const AstTree *ast = &ctx->ast;
+    AstStack *walk = &ctx->sem.walk;
+    size_t base = walk->count;
+
+    ast_push(walk, root, VISIT_ENTER, 0);
+
+    while (walk->count > base)
     {
-        case NODE_START: analyze_node(node->left); break;
-        case NODE_STATEMENT_LIST:
-            analyze_node(node->left);
-            analyze_node(node->right);
-            break;
-        case NODE_STATEMENT:
-            analyze_node(node->left);
-            apply_deferred_ops(); // harmless (not used in current immediate semantics)
-            break;
-        case NODE_DECLARATION:
+        AstFrame f = walk->frames[--walk->count];
+        AstRef node = f.node;
+
+        if (!node)
+            continue;
+        switch (ast_type(ast, node))
         {
-            SEM_TYPE dtype = SEM_TYPE_UNKNOWN; // default to unknown, not INT
-            if (node->value) {
-                if (strcmp(node->value, "ENTEGER") == 0) dtype = SEM_TYPE_INT;
-                else if (strcmp(node->value, "CHAROT") == 0) dtype = SEM_TYPE_CHAR;
-                else if (strcmp(node->value, "KUAN") == 0) dtype = SEM_TYPE_UNKNOWN;
+            case NODE_START: ast_push(walk, ast_left(ast, node), VISIT_ENTER, 0); break;
+            case NODE_STATEMENT_LIST:
+                ast_push(walk, ast_right(ast, node), VISIT_ENTER, 0);
+                ast_push(walk, ast_left(ast, node), VISIT_ENTER, 0);
+                break;
+            case NODE_STATEMENT:
+                if (f.state == VISIT_EXIT)
+                {
+                    apply_deferred_ops(ctx); // harmless (not used in current immediate semantics)
+                    break;
+                }
+                ast_push(walk, node, VISIT_EXIT, 0);
+                ast_push(walk, ast_left(ast, node), VISIT_ENTER, 0);
+                break;
+            case NODE_DECLARATION:
+            {
+                SEM_TYPE dtype = SEM_TYPE_UNKNOWN; // default to unknown, not INT
+                if (ast_kind(ast, node) == AST_DECL_TYPED) {
+                    switch (ast_dtype(ast, node)) {
+                    case AST_TYPE_ENTEGER: dtype = SEM_TYPE_INT; break;
+                    case AST_TYPE_CHAROT:  dtype = SEM_TYPE_CHAR; break;
+                    case AST_TYPE_KUAN:    dtype = SEM_TYPE_UNKNOWN; break;
+                    }
+                }
+                handle_declaration(ctx, ast_left(ast, node), dtype);
+                apply_deferred_ops(ctx);
+                break;
             }
-            handle_declaration(node->left, dtype);
-            apply_deferred_ops();
-            break;
+            case NODE_ASSIGNMENT:
+                handle_assignment(ctx, node);
+                apply_deferred_ops(ctx);
+                break;
+            case NODE_PRINTING:
+            case NODE_PRINT_ITEM:
+                handle_print(ctx, node);
+                apply_deferred_ops(ctx);
+                break;
+            default:
+                evaluate_expression(ctx, node);
+                break;
         }
-            break;
-        case NODE_ASSIGNMENT:
-            handle_assignment(node);
-            apply_deferred_ops();
-            break;
-        case NODE_PRINTING:
-        case NODE_PRINT_ITEM:
-            handle_print(node);
-            apply_deferred_ops();
-            break;
-        default:
-            evaluate_expression(node);
-            break;
     }
 }
 
@@ -1087,123 +1070,100 @@ static void analyze_node(ASTNode *node)
 Check unused
 ---------------------------- */
 
-static void check_unused_variables(void)
+static void check_unused_variables(BaiCompiler *ctx)
 {
-    for (KnownVar *k = known_vars_head; k; k = k->next)
+    // newest first, the order the analyzer has always reported them in
+    for (size_t i = ctx->symbols.count; i-- > 0;)
     {
-        ASTNode *node = k->temp.node;
-        if (!k->used)
-            sem_record_warning(node, "Variable '%s' declared but never use\n", k->name);
+        const SymbolEntry *var = &ctx->symbols.entries[i];
+        if (!var->used)
+            sem_record_warning(ctx, AST_NULL, "Variable '%s' declared but never use\n", var->name);
     }
 }
 
 /* ----------------------------
 Semantic analyzer
 ---------------------------- */
-int semantic_analyzer(void)
+int semantic_analyzer(BaiCompiler *ctx)
 {
-    // overwrite old file
-    out_file = fopen("output_print.txt", "w");
-    if (!out_file)
-    {
-        fprintf(stderr, "Failed to open output_print.txt\n");
-        return 0;
-    }
-
-    sem_errors = 0;
-    sem_warnings = 0;
-    sem_next_temp_id = 1;
-    sem_temps_count = 0;
-    sem_ops_count = 0;
-    print_offset = 0;
-    print_buffer[0] = '\0';
-
-    // free known vars
-    KnownVar *k = known_vars_head;
-    while (k)
-    {
-        KnownVar *n = k->next;
-        free(k->name);
-        free(k);
-        k = n;
-    }
-    known_vars_head = NULL;
-
-    if (!root)
+    // overwrite old output
+    bai_output_clear(ctx, BAI_OUT_PRINT);
+
+    ctx->sem.errors = 0;
+    ctx->sem.warnings = 0;
+    ctx->sem.next_temp_id = 1;
+    ctx->sem.temps_count = 0;
+    ctx->sem.ops_count = 0;
+    ctx->sem.print_offset = 0;
+    ctx->sem.print_buffer[0] = '\0';
+
+    if (!ctx->root)
     {
         fprintf(stderr, "No AST\n");
-        fclose(out_file);
         return 0;
     }
 
     // Traverse AST
-    analyze_node(root);
+    analyze_node(ctx, ctx->root);
 
     // If errors exist, discard buffered prints
-    if (sem_errors > 0)
+    if (ctx->sem.errors > 0)
     {
-        print_offset = 0;
-        print_buffer[0] = '\0';
+        ctx->sem.print_offset = 0;
+        ctx->sem.print_buffer[0] = '\0';
     }
     else
     {
         // No errors: flush buffered prints
-        if (print_offset > 0)
-            fprintf(out_file, "%s", print_buffer);
+        if (ctx->sem.print_offset > 0)
+            bai_output_printf(ctx, BAI_OUT_PRINT, "%s", ctx->sem.print_buffer);
     }
 
-    if (sem_errors == 0)
+    if (ctx->sem.errors == 0)
     {
         // Write semantic analysis summary
-        fprintf(out_file, "\n\n=== COMPILATION SUCCESSFULL ===\n\n");
-        check_unused_variables();
-        // fprintf(out_file, "[SEM] Analysis completed: %d semantic error(s), %d warning(s)\n", sem_errors, sem_warnings);
-        fprintf(out_file, "\n%d semantic error(s), %d warning(s)\n", sem_errors, sem_warnings);
+        bai_output_printf(ctx, BAI_OUT_PRINT, "\n\n=== COMPILATION SUCCESSFULL ===\n\n");
+        check_unused_variables(ctx);
+        // bai_output_printf(ctx, BAI_OUT_PRINT, "[SEM] Analysis completed: %d semantic error(s), %d warning(s)\n", ctx->sem.errors, ctx->sem.warnings);
+        bai_output_printf(ctx, BAI_OUT_PRINT, "\n%d semantic error(s), %d warning(s)\n", ctx->sem.errors, ctx->sem.warnings);
     }
 
-    fclose(out_file);
-    out_file = NULL;
-
-    return sem_errors;
+    return ctx->sem.errors;
 }
 
-int semantic_error_count(void) { return sem_errors; }
+int semantic_error_count(BaiCompiler *ctx) { return ctx->sem.errors; }
 
-void sem_cleanup(void)
+void sem_cleanup(BaiCompiler *ctx)
 {
-    if (sem_temps)
+    if (ctx->sem.temps)
     {
-        free(sem_temps);
-        sem_temps = NULL;
-        sem_temps_count = 0;
-        sem_temps_capacity = 0;
+        free(ctx->sem.temps);
+        ctx->sem.temps = NULL;
+        ctx->sem.temps_count = 0;
+        ctx->sem.temps_capacity = 0;
     }
-    if (sem_ops)
+    if (ctx->sem.ops)
     {
-        free(sem_ops);
-        sem_ops = NULL;
-        sem_ops_count = 0;
-        sem_ops_capacity = 0;
+        free(ctx->sem.ops);
+        ctx->sem.ops = NULL;
+        ctx->sem.ops_count = 0;
+        ctx->sem.ops_capacity = 0;
     }
-    KnownVar *k = known_vars_head;
-    while (k)
-    {
-        KnownVar *n = k->next;
-        free(k->name);
-        free(k);
-        k = n;
-    }
-    known_vars_head = NULL;
-
-    DeferredOp *d = deferred_head;
+    DeferredOp *d = ctx->sem.deferred_head;
     while (d)
     {
         DeferredOp *n = d->next;
         free(d);
         d = n;
     }
-    deferred_head = NULL;
+    ctx->sem.deferred_head = NULL;
+
+    ast_stack_free(&ctx->sem.walk);
+    free(ctx->sem.values);
+    ctx->sem.values = NULL;
+    ctx->sem.values_count = 0;
+    ctx->sem.values_capacity = 0;
 
-    sem_errors = 0;
-    sem_warnings = 0;
+    ctx->sem.errors = 0;
+    ctx->sem.warnings = 0;
 }
@@ -1,8 +1,12 @@
 #ifndef SEMANTIC_ANALYZER_H
 #define SEMANTIC_ANALYZER_H
 
+#include <stdio.h>
 #include <stddef.h>
 #include "ast.h"
+#include "symbol_table.h"
+
+typedef struct BaiCompiler BaiCompiler;
 
 /* ----------------------------
 Semantic Types & Temp Records
@@ -18,20 +22,9 @@ int id;             /* unique temp id */
 SEM_TYPE type;      /* type of this temp */
 int is_constant;    /* boolean: constant or not */
 long int_value;     /* value if constant */
-ASTNode *node;      /* optional: originating AST node */
+AstRef node;        /* optional: originating AST node */
 } SEM_TEMP;
 
-/* ----------------------------
-Known Variable (tracked in analyzer)
----------------------------- */
-typedef struct KnownVar {
-char *name;           /* variable name */
-SEM_TEMP temp;        /* temp representing this variable */
-int initialized;      /* boolean: has been initialized */
-int used;             /* boolean: has been used */
-struct KnownVar *next;
-} KnownVar;
-
 /* ----------------------------
 Semantic Operation Records
 ---------------------------- */
@@ -50,39 +43,72 @@ int src1_temp;
 int src2_temp;
 char op[8];           /* operator text: "+", "-", etc */
 long const_val;       /* value if storing constant */
-ASTNode *node;        /* AST node origin */
+AstRef node;          /* AST node origin */
 } SEM_OP;
 
+/* ----------------------------
+Analyzer state (one per BaiCompiler)
+---------------------------- */
+#define PRINT_BUFFER_SIZE 8192
+
+struct DeferredOp;
+
+typedef struct {
+SEM_TEMP *temps;
+size_t temps_capacity;
+size_t temps_count;
+int next_temp_id;
+
+SEM_OP *ops;
+size_t ops_capacity;
+size_t ops_count;
+
+struct DeferredOp *deferred_head;
+
+AstStack walk;        /* explicit stack for the tree walkers */
+SEM_TEMP *values;     /* operand values of expressions being evaluated */
+size_t values_count;
+size_t values_capacity;
+
+int errors;
+int warnings;
+int inside_print;     /* 1 if evaluating inside a PRENT */
+
+char print_buffer[PRINT_BUFFER_SIZE];
+size_t print_offset;
+} SemanticState;
+
 /* ----------------------------
 Public API
 ---------------------------- */
 
-/* Analyze the global AST root; returns number of semantic errors (0 = success) */
-extern int semantic_analyzer(void);
+/* Analyze ctx->root; returns number of semantic errors (0 = success) */
+extern int semantic_analyzer(BaiCompiler *ctx);
 
 /* Returns number of semantic errors recorded */
-int semantic_error_count(void);
+int semantic_error_count(BaiCompiler *ctx);
 
 /* Returns read-only array of temps, and sets count */
-const SEM_TEMP *sem_get_temps(size_t *out_count);
+const SEM_TEMP *sem_get_temps(BaiCompiler *ctx, size_t *out_count);
 
 /* Returns read-only array of semantic operations, and sets count */
-const SEM_OP *sem_get_ops(size_t *out_count);
+const SEM_OP *sem_get_ops(BaiCompiler *ctx, size_t *out_count);
 
 /* Cleanup internal structures (free memory) */
-void sem_cleanup(void);
+void sem_cleanup(BaiCompiler *ctx);
 
 /* Utility: create a new temp of given type */
-SEM_TEMP sem_new_temp(SEM_TYPE type);
+SEM_TEMP sem_new_temp(BaiCompiler *ctx, SEM_TYPE type);
 
-/* Variable lookup/addition in analyzer */
-KnownVar* sem_find_var(const char *name);
-KnownVar* sem_add_var(const char *name, SEM_TYPE type);
+/* Variable lookup/addition in analyzer. Variables are the entries of
+   ctx->symbols; a returned pointer is valid until the next sem_add_var. */
+SymbolEntry* sem_find_var(BaiCompiler *ctx, int sym);
+SymbolEntry* sem_add_var(BaiCompiler *ctx, int sym, SEM_TYPE type);
 
 /* Map datatype string token to SEM_TYPE */
 SEM_TYPE sem_type_from_string(const char *s);
 
 /* Optional: semantic annotation / textual notes */
-void sem_emit(const char *fmt, ...);
+void sem_emit(BaiCompiler *ctx, const char *fmt, ...);
 
 #endif /* SEMANTIC_ANALYZER_H */
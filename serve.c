@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compiler.h"
+#include "serve.h"
+
+/* Refuse frames larger than this instead of trying to allocate them */
+#define MAX_REQUEST_SIZE (64u * 1024u * 1024u)
+
+/* ----------------------------
+JSON response builder
+---------------------------- */
+
+static int json_put(BaiBuffer *buf, const char *s, size_t n)
+{
+    if (buf->len + n + 1 > buf->cap)
+    {
+        size_t cap = buf->cap ? buf->cap : 4096;
+        while (cap < buf->len + n + 1)
+            cap *= 2;
+        char *data = (char *)realloc(buf->data, cap);
+        if (!data)
+            return 0;
+        buf->data = data;
+        buf->cap = cap;
+    }
+    memcpy(buf->data + buf->len, s, n);
+    buf->len += n;
+    buf->data[buf->len] = '\0';
+    return 1;
+}
+
+static int json_raw(BaiBuffer *buf, const char *s)
+{
+    return json_put(buf, s, strlen(s));
+}
+
+static int json_string(BaiBuffer *buf, const char *s, size_t n)
+{
+    int ok = json_put(buf, "\"", 1);
+    size_t run = 0; // start of the pending run of characters needing no escape
+
+    for (size_t i = 0; i < n && ok; i++)
+    {
+        unsigned char c = (unsigned char)s[i];
+        const char *esc = NULL;
+        char hex[8];
+
+        if (c == '"')
+            esc = "\\\"";
+        else if (c == '\\')
+            esc = "\\\\";
+        else if (c == '\n')
+            esc = "\\n";
+        else if (c == '\r')
+            esc = "\\r";
+        else if (c == '\t')
+            esc = "\\t";
+        else if (c < 0x20)
+        {
+            snprintf(hex, sizeof(hex), "\\u%04x", c);
+            esc = hex;
+        }
+
+        if (esc)
+        {
+            ok = json_put(buf, s + run, i - run) && json_raw(buf, esc);
+            run = i + 1;
+        }
+    }
+
+    return ok && json_put(buf, s + run, n - run) && json_put(buf, "\"", 1);
+}
+
+static int json_output(BaiBuffer *buf, BaiCompiler *ctx, const char *key, BaiOutput which)
+{
+    const BaiBuffer *out = &ctx->outputs[which];
+    return json_raw(buf, "\"") && json_raw(buf, key) && json_raw(buf, "\":") &&
+           json_string(buf, out->data ? out->data : "", out->len);
+}
+
+static int build_response(BaiBuffer *buf, BaiCompiler *ctx, int failed)
+{
+    int ok = json_raw(buf, failed ? "{\"success\":false,\"exitCode\":1,\"outputs\":{"
+                                   : "{\"success\":true,\"exitCode\":0,\"outputs\":{");
+
+    ok = ok && json_output(buf, ctx, "print", BAI_OUT_PRINT) && json_raw(buf, ",");
+    ok = ok && json_output(buf, ctx, "tac", BAI_OUT_TAC) && json_raw(buf, ",");
+    ok = ok && json_output(buf, ctx, "assembly", BAI_OUT_ASSEMBLY) && json_raw(buf, ",\"machine\":{");
+    ok = ok && json_output(buf, ctx, "assembly", BAI_OUT_MACHINE_ASSEMBLY) && json_raw(buf, ",");
+    ok = ok && json_output(buf, ctx, "binary", BAI_OUT_MACHINE_BIN) && json_raw(buf, ",");
+    ok = ok && json_output(buf, ctx, "hex", BAI_OUT_MACHINE_HEX) && json_raw(buf, "}},\"diagnostics\":[");
+
+    for (int i = 0; i < ctx->diagnostic_count && ok; i++)
+    {
+        const BaiDiagnostic *d = &ctx->diagnostics[i];
+        char line[48];
+        snprintf(line, sizeof(line), ",\"line\":%d,\"message\":", d->line);
+
+        ok = json_raw(buf, i ? ",{\"severity\":" : "{\"severity\":") &&
+             json_raw(buf, d->severity == BAI_DIAG_ERROR ? "\"error\"" : "\"warning\"") &&
+             json_raw(buf, line) &&
+             json_string(buf, d->message, strlen(d->message)) &&
+             json_raw(buf, "}");
+    }
+
+    return ok && json_raw(buf, "]}");
+}
+
+/* ----------------------------
+Framing
+---------------------------- */
+
+// Reads "<digits>\n". Returns 1 on success, 0 on clean EOF, -1 on a bad header.
+static int read_header(FILE *in, size_t *len)
+{
+    int c = fgetc(in);
+    if (c == EOF)
+        return 0;
+
+    size_t n = 0;
+    int digits = 0;
+    while (c >= '0' && c <= '9')
+    {
+        n = n * 10 + (size_t)(c - '0');
+        if (n > MAX_REQUEST_SIZE)
+            return -1;
+        digits++;
+        c = fgetc(in);
+    }
+
+    if (c == '\r')
+        c = fgetc(in);
+    if (!digits || c != '\n')
+        return -1;
+
+    *len = n;
+    return 1;
+}
+
+static int write_frame(FILE *out, const char *data, size_t len)
+{
+    if (fprintf(out, "%lu\n", (unsigned long)len) < 0)
+        return 0;
+    if (len && fwrite(data, 1, len, out) != len)
+        return 0;
+    return fflush(out) == 0;
+}
+
+/* ----------------------------
+Request loop
+---------------------------- */
+
+int bai_serve(FILE *in, FILE *out)
+{
+    BaiCompiler *ctx = bai_compiler_new();
+    if (!ctx)
+    {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    // nobody reads the console log of a server, so it stays off unless
+    // BAI_TRACE turns it on
+    const char *spec = getenv("BAI_TRACE");
+    if (spec)
+        trace_configure(&ctx->trace, spec);
+
+    BaiBuffer response = {0};
+    char *src = NULL;
+    size_t src_cap = 0;
+    int status = 0;
+
+    for (;;)
+    {
+        size_t len;
+        int h = read_header(in, &len);
+        if (h == 0)
+            break;
+        if (h < 0)
+        {
+            fprintf(stderr, "[SERVE] Malformed request header\n");
+            status = 1;
+            break;
+        }
+
+        if (len + 1 > src_cap)
+        {
+            char *grown = (char *)realloc(src, len + 1);
+            if (!grown)
+            {
+                fprintf(stderr, "[SERVE] Out of memory for a %lu byte request\n", (unsigned long)len);
+                status = 1;
+                break;
+            }
+            src = grown;
+            src_cap = len + 1;
+        }
+
+        if (fread(src, 1, len, in) != len)
+        {
+            fprintf(stderr, "[SERVE] Truncated request\n");
+            status = 1;
+            break;
+        }
+        src[len] = '\0';
+
+        int failed = bai_compile_source(ctx, src, len);
+
+        response.len = 0;
+        if (!build_response(&response, ctx, failed))
+        {
+            const char *oom = "{\"success\":false,\"exitCode\":1,\"error\":\"out of memory\"}";
+            if (!write_frame(out, oom, strlen(oom)))
+                status = 1;
+        }
+        else if (!write_frame(out, response.data, response.len))
+            status = 1;
+
+        // drop this program's AST, tables and outputs before waiting for the next one
+        bai_compiler_reset(ctx);
+
+        if (status)
+            break;
+    }
+
+    free(src);
+    free(response.data);
+    bai_compiler_free(ctx);
+    return status;
+}
@@ -0,0 +1,29 @@
+#ifndef SERVE_H
+#define SERVE_H
+
+#include <stdio.h>
+
+/* ----------------------------
+Compile server (main.exe --serve)
+
+Requests and responses are framed the same way: the payload length in
+bytes as ASCII decimal, a '\n', then exactly that many bytes.
+
+    request:  <len>\n<BaiScript source>
+    response: <len>\n<JSON result>
+
+The JSON result has the shape the IDE already uses:
+    { "success", "exitCode",
+      "outputs": { "print", "tac", "assembly",
+                   "machine": { "assembly", "binary", "hex" } },
+      "diagnostics": [ { "severity", "line", "message" } ] }
+
+One BaiCompiler is reused for every request and reset in between. Its
+console trace is off unless the BAI_TRACE environment variable sets it.
+---------------------------- */
+
+/* Serve requests from `in` until EOF. Returns 0 on a clean EOF,
+   1 on a malformed frame or I/O error. */
+int bai_serve(FILE *in, FILE *out);
+
+#endif /* SERVE_H */
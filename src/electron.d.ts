@@ -7,9 +7,15 @@ interface ElectronAPI {
     error?: string;
     outputs?: {
       print?: string;
+      tac?: string;
       assembly?: string;
       machine?: string;
     };
+    diagnostics?: {
+      severity: 'error' | 'warning';
+      line: number;
+      message: string;
+    }[];
   }>;
   windowMinimize: () => Promise<void>;
   windowMaximize: () => Promise<void>;
@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats.h"
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <time.h>
+#include <sys/resource.h>
+#endif
+
+static const char *phase_names[STATS_PHASE_COUNT] = {
+    "parse",
+    "semantic",
+    "tac",
+    "target",
+    "machine",
+    "report",
+};
+
+/* ----------------------------
+Clocks
+---------------------------- */
+
+static double wall_ms(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000.0 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+#endif
+}
+
+// CPU time of the calling thread, so compiles on other threads do not count
+static double cpu_ms(void)
+{
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user))
+        return 0;
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return (double)(k.QuadPart + u.QuadPart) / 10000.0; // 100 ns units
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+#endif
+}
+
+// Peak resident set of the process so far, in KB
+static long peak_rss_kb(void)
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return 0;
+    return (long)(pmc.PeakWorkingSetSize / 1024);
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0)
+        return 0;
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024; // bytes on macOS
+#else
+    return ru.ru_maxrss;
+#endif
+#endif
+}
+
+/* ----------------------------
+Recording
+---------------------------- */
+
+void stats_reset(BaiStats *st)
+{
+    int enabled = st->enabled;
+    memset(st, 0, sizeof(*st));
+    st->enabled = enabled;
+}
+
+void stats_begin(BaiStats *st, StatsPhase phase)
+{
+    if (!st->enabled)
+        return;
+    PhaseStats *p = &st->phase[phase];
+    p->rss_start = peak_rss_kb();
+    p->cpu_start = cpu_ms();
+    p->wall_start = wall_ms();
+}
+
+void stats_end(BaiStats *st, StatsPhase phase)
+{
+    if (!st->enabled)
+        return;
+    PhaseStats *p = &st->phase[phase];
+    p->wall_ms += wall_ms() - p->wall_start;
+    p->cpu_ms += cpu_ms() - p->cpu_start;
+    p->peak_rss_kb += peak_rss_kb() - p->rss_start;
+    p->ran = 1;
+}
+
+/* ----------------------------
+Reports
+---------------------------- */
+
+const char *stats_phase_name(StatsPhase phase)
+{
+    return phase_names[phase];
+}
+
+void stats_print_table(const BaiStats *st, FILE *out)
+{
+    double wall = 0, cpu = 0;
+    long rss = 0;
+
+    fprintf(out, "===== COMPILE STATISTICS =====\n");
+    fprintf(out, "%-10s | %12s | %12s | %14s\n", "Phase", "Wall ms", "CPU ms", "Peak RSS +KB");
+    fprintf(out, "--------------------------------------------------------\n");
+    for (int i = 0; i < STATS_PHASE_COUNT; i++)
+    {
+        const PhaseStats *p = &st->phase[i];
+        if (!p->ran)
+            continue;
+        fprintf(out, "%-10s | %12.3f | %12.3f | %14ld\n", phase_names[i], p->wall_ms, p->cpu_ms, p->peak_rss_kb);
+        wall += p->wall_ms;
+        cpu += p->cpu_ms;
+        rss += p->peak_rss_kb;
+    }
+    fprintf(out, "--------------------------------------------------------\n");
+    fprintf(out, "%-10s | %12.3f | %12.3f | %14ld\n\n", "total", wall, cpu, rss);
+
+    fprintf(out, "%-22s %zu\n", "source bytes", st->source_bytes);
+    fprintf(out, "%-22s %ld\n", "tokens", st->tokens);
+    fprintf(out, "%-22s %ld\n", "AST nodes", st->ast_nodes);
+    fprintf(out, "%-22s %ld\n", "interned names", st->names);
+    fprintf(out, "%-22s %ld\n", "TAC instructions", st->tac_instructions);
+    fprintf(out, "%-22s %ld\n", "TAC after optimizing", st->tac_optimized);
+    fprintf(out, "%-22s %ld\n", "CSE reused", st->tac_cse_reused);
+    fprintf(out, "%-22s %ld\n", "CSE mul/div removed", st->tac_cse_muldiv);
+    fprintf(out, "%-22s %ld\n", "dead stores removed", st->tac_dead_stores);
+    fprintf(out, "%-22s %ld\n", "assembly lines", st->assembly_lines);
+    fprintf(out, "%-22s %ld\n", "estimated cycles", st->code_cycles);
+    fprintf(out, "%-22s %ld\n", "loads saved", st->loads_saved);
+    fprintf(out, "%-22s %ld\n", "stores saved", st->stores_saved);
+    fprintf(out, "%-22s %ld\n", ".data slots", st->data_slots);
+    fprintf(out, "%-22s %ld\n", "machine words", st->machine_words);
+    fprintf(out, "%-22s %ld\n", "symbols", st->symbols);
+    fprintf(out, "===================================\n");
+}
+
+void stats_print_json(const BaiStats *st, FILE *out)
+{
+    double wall = 0, cpu = 0;
+    int first = 1;
+
+    fprintf(out, "{\"phases\":[");
+    for (int i = 0; i < STATS_PHASE_COUNT; i++)
+    {
+        const PhaseStats *p = &st->phase[i];
+        if (!p->ran)
+            continue;
+        fprintf(out, "%s{\"name\":\"%s\",\"wall_ms\":%.3f,\"cpu_ms\":%.3f,\"peak_rss_delta_kb\":%ld}",
+                first ? "" : ",", phase_names[i], p->wall_ms, p->cpu_ms, p->peak_rss_kb);
+        wall += p->wall_ms;
+        cpu += p->cpu_ms;
+        first = 0;
+    }
+    fprintf(out, "],\"total\":{\"wall_ms\":%.3f,\"cpu_ms\":%.3f},", wall, cpu);
+    fprintf(out, "\"counts\":{\"source_bytes\":%zu,\"tokens\":%ld,\"ast_nodes\":%ld,\"names\":%ld,"
+                 "\"tac_instructions\":%ld,\"tac_optimized\":%ld,\"tac_cse_reused\":%ld,"
+                 "\"tac_cse_muldiv\":%ld,\"tac_dead_stores\":%ld,\"assembly_lines\":%ld,"
+                 "\"code_cycles\":%ld,\"loads_saved\":%ld,\"stores_saved\":%ld,\"data_slots\":%ld,\"machine_words\":%ld,\"symbols\":%ld}}\n",
+            st->source_bytes, st->tokens, st->ast_nodes, st->names, st->tac_instructions,
+            st->tac_optimized, st->tac_cse_reused, st->tac_cse_muldiv, st->tac_dead_stores,
+            st->assembly_lines, st->code_cycles, st->loads_saved, st->stores_saved, st->data_slots, st->machine_words, st->symbols);
+}
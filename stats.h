@@ -0,0 +1,78 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/* ----------------------------
+Compile statistics
+
+When enabled, bai_compile_source() records for each phase the monotonic
+wall time, the CPU time of the compiling thread and how far the peak
+resident set grew, plus how much each phase produced (tokens, AST nodes,
+TAC before/after optimization, assembly lines, machine words).
+main --time-passes prints them as a table and --stats=json as JSON,
+both on stderr. Disabled, the phases are not timed at all.
+---------------------------- */
+
+typedef enum
+{
+    STATS_PARSE,        /* lexing and parsing, with the AST dump */
+    STATS_SEMANTIC,
+    STATS_TAC,
+    STATS_TARGET,
+    STATS_MACHINE,
+    STATS_REPORT,       /* symbol table dump and the trace flush */
+    STATS_PHASE_COUNT
+} StatsPhase;
+
+typedef struct
+{
+    int ran;
+    double wall_ms;
+    double cpu_ms;
+    long peak_rss_kb;       /* growth of the process peak RSS during the phase */
+
+    /* start stamps of a running phase */
+    double wall_start;
+    double cpu_start;
+    long rss_start;
+} PhaseStats;
+
+typedef struct
+{
+    int enabled;            /* kept across resets */
+    PhaseStats phase[STATS_PHASE_COUNT];
+
+    size_t source_bytes;
+    long tokens;
+    long ast_nodes;
+    long names;             /* distinct interned spellings */
+    long tac_instructions;
+    long tac_optimized;
+    long tac_cse_reused;    /* repeated computations value numbering replaced */
+    long tac_cse_muldiv;    /* ... of which multiplies or divides */
+    long tac_dead_stores;
+    long data_slots;        /* .data words emitted */
+    long assembly_lines;
+    long code_cycles;       /* the instruction selector's cycle estimate */
+    long loads_saved;       /* variable ld/sd register allocation made unnecessary */
+    long stores_saved;
+    long machine_words;
+    long symbols;
+} BaiStats;
+
+/* Zero the measurements, keeping `enabled` */
+void stats_reset(BaiStats *st);
+
+/* Time one phase; both are no-ops unless st->enabled */
+void stats_begin(BaiStats *st, StatsPhase phase);
+void stats_end(BaiStats *st, StatsPhase phase);
+
+/* "parse", "semantic", ... as used in the reports */
+const char *stats_phase_name(StatsPhase phase);
+
+void stats_print_table(const BaiStats *st, FILE *out);
+void stats_print_json(const BaiStats *st, FILE *out);
+
+#endif /* STATS_H */
@@ -3,88 +3,144 @@
 #include <stdlib.h>
 #include <string.h>
 
-SymbolEntry *symbol_table = NULL;
-size_t symbol_count = 0;
-size_t symbol_capacity = 0;
+/* Multiplicative hash: bits 7 and up of sym * 2^32/phi, masked to the
+   index size. This is not Fibonacci hashing, which keeps the top bits;
+   for the dense IDs the intern table hands out, the middle bits almost
+   never collide, and symbol_table_bench measured them faster at 1M. */
+static size_t index_slot(int sym, size_t size)
+{
+    return (size_t)(((unsigned)sym * 2654435769u) >> 7) & (size - 1);
+}
+
+static void index_insert(int *index, size_t size, const SymbolEntry *entries, int i)
+{
+    size_t slot = index_slot(entries[i].sym, size);
+    while (index[slot] != -1)
+        slot = (slot + 1) & (size - 1);
+    index[slot] = i;
+}
+
+/* Grow the hash index so it stays at most half full */
+static int ensure_index_capacity(SymbolTable *st)
+{
+    if ((st->count + 1) * 2 <= st->index_size)
+        return 1;
+
+    size_t new_size = st->index_size ? st->index_size * 2 : 64;
+    int *new_index = malloc(new_size * sizeof(int));
+    if (!new_index) return 0; // failed
+    memset(new_index, 0xff, new_size * sizeof(int));
+
+    for (size_t i = 0; i < st->count; i++)
+        index_insert(new_index, new_size, st->entries, (int)i);
+
+    free(st->index);
+    st->index = new_index;
+    st->index_size = new_size;
+    return 1;
+}
 
 /* Ensure capacity for dynamic array */
-static int ensure_symbol_capacity(void)
+static int ensure_symbol_capacity(SymbolTable *st)
 {
-    if (symbol_count >= symbol_capacity)
+    if (st->count >= st->capacity)
     {
-        size_t new_cap = (symbol_capacity == 0) ? 16 : symbol_capacity * 2;
-        SymbolEntry *new_table = realloc(symbol_table, new_cap * sizeof(SymbolEntry));
+        size_t new_cap = (st->capacity == 0) ? 16 : st->capacity * 2;
+        SymbolEntry *new_table = realloc(st->entries, new_cap * sizeof(SymbolEntry));
         if (!new_table) return 0; // failed
-        symbol_table = new_table;
-        symbol_capacity = new_cap;
+        st->entries = new_table;
+        st->capacity = new_cap;
     }
     return 1;
 }
 
 /* Add a symbol */
-int add_symbol(const char *name, const char *datatype, int initialized, const char *value_str)
+int add_symbol(SymbolTable *st, int sym, const char *name, int type, int initialized)
 {
-    if (!ensure_symbol_capacity()) return -1;
-
-    strncpy(symbol_table[symbol_count].name, name, SYMBOL_NAME_MAX-1);
-    symbol_table[symbol_count].name[SYMBOL_NAME_MAX-1] = '\0';
+    if (!ensure_symbol_capacity(st) || !ensure_index_capacity(st)) return -1;
 
-    strncpy(symbol_table[symbol_count].datatype, datatype, sizeof(symbol_table[symbol_count].datatype)-1);
-    symbol_table[symbol_count].datatype[sizeof(symbol_table[symbol_count].datatype)-1] = '\0';
+    SymbolEntry *e = &st->entries[st->count];
 
-    symbol_table[symbol_count].initialized = initialized;
+    e->sym = sym;
+    e->name = name;
+    e->type = type;
+    e->value_kind = SYM_VALUE_NONE;
+    e->value = 0;
 
-    if (value_str)
-        strncpy(symbol_table[symbol_count].value_str, value_str, SYMBOL_VALUE_MAX-1);
-    else
-        symbol_table[symbol_count].value_str[0] = '\0';
+    e->int_value = 0;
+    e->initialized = initialized != 0;
+    e->is_constant = 0;
+    e->used = 0;
 
-    symbol_table[symbol_count].value_str[SYMBOL_VALUE_MAX-1] = '\0';
+    index_insert(st->index, st->index_size, st->entries, (int)st->count);
 
-    return symbol_count++;
+    return (int)st->count++;
 }
 
-/* Find a symbol by name; returns index or -1 if not found */
-int find_symbol(const char *name)
+/* Find a symbol by intern ID; returns index or -1 if not found */
+int find_symbol(const SymbolTable *st, int sym)
 {
-    for (size_t i = 0; i < symbol_count; i++)
+    if (st->index_size == 0)
+        return -1;
+
+    /* probe order matches insertion order, so a repeated ID finds its first entry */
+    for (size_t slot = index_slot(sym, st->index_size); st->index[slot] != -1;
+         slot = (slot + 1) & (st->index_size - 1))
     {
-        if (strcmp(symbol_table[i].name, name) == 0)
-            return (int)i;
+        if (st->entries[st->index[slot]].sym == sym)
+            return st->index[slot];
     }
     return -1;
 }
 
 /* Clear symbol table */
-void clear_symbol_table(void)
+void clear_symbol_table(SymbolTable *st)
 {
-    free(symbol_table);
-    symbol_table = NULL;
-    symbol_count = 0;
-    symbol_capacity = 0;
+    free(st->entries);
+    free(st->index);
+    st->entries = NULL;
+    st->index = NULL;
+    st->count = 0;
+    st->capacity = 0;
+    st->index_size = 0;
+}
+
+const char *symbol_type_name(int type)
+{
+    if (type == SYM_TYPE_ENTEGER) return "ENTEGER";
+    if (type == SYM_TYPE_CHAROT) return "CHAROT";
+    return "KUAN";
 }
 
 /* Print symbol table */
-void print_symbol_table(void)
+void print_symbol_table(BaiTrace *tr, const SymbolTable *st)
 {
 
     char *name = "entries";
 
-    if (symbol_count == 1)
+    if (st->count == 1)
     {
         name = "entry";
     }
 
-    printf("============ SYMBOL TABLE (%zu %s) ============\n", symbol_count, name);
-    printf("%-10s | %-10s | %-10s | %-10s\n", "Name", "Datatype", "Initialized", "Value");
-    printf("---------------------------------------------\n");
-    for (size_t i = 0; i < symbol_count; i++)
+    trace_printf(tr, "============ SYMBOL TABLE (%zu %s) ============\n", st->count, name);
+    trace_printf(tr, "%-10s | %-10s | %-10s | %-10s\n", "Name", "Datatype", "Initialized", "Value");
+    trace_printf(tr, "---------------------------------------------\n");
+    for (size_t i = 0; i < st->count; i++)
     {
-        printf("%-10s | %-10s | %-10s | %-10s\n",
-            symbol_table[i].name,
-            symbol_table[i].datatype,
-            symbol_table[i].initialized ? "Yes" : "No",
-            symbol_table[i].value_str);
+        const SymbolEntry *e = &st->entries[i];
+        char value[32] = "";
+
+        if (e->value_kind == SYM_VALUE_INT)
+            snprintf(value, sizeof(value), "%ld", e->value);
+        else if (e->value_kind == SYM_VALUE_CHAR)
+            snprintf(value, sizeof(value), "%c", (char)e->value);
+
+        trace_printf(tr, "%-10.*s | %-10s | %-10s | %-10s\n",
+            SYMBOL_NAME_MAX - 1, e->name,
+            symbol_type_name(e->type),
+            e->initialized ? "Yes" : "No",
+            value);
     }
-    printf("===================================================\n");
+    trace_printf(tr, "===================================================\n");
 }
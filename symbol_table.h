@@ -2,31 +2,58 @@
 #define SYMBOL_TABLE_H
 
 #include <stddef.h>
+#include "trace.h"
 
-#define SYMBOL_NAME_MAX 64
-#define SYMBOL_VALUE_MAX 64
+#define SYMBOL_NAME_MAX 64      /* widest name shown by print_symbol_table */
 
+/* Numbered like SEM_TYPE (unknown/KUAN, int, char) */
 typedef enum {
     SYM_TYPE_KUAN,
     SYM_TYPE_ENTEGER,
     SYM_TYPE_CHAROT
 } SYM_TYPE;
 
+/* How the value column of the symbol table dump shows `value` */
+typedef enum {
+    SYM_VALUE_NONE,             /* blank */
+    SYM_VALUE_INT,              /* decimal */
+    SYM_VALUE_CHAR              /* the character (char)value */
+} SYM_VALUE_KIND;
+
 typedef struct {
-    char name[SYMBOL_NAME_MAX];
-    char datatype[16];          /* original type token: ENTEGER, CHAROT, etc */
-    int initialized;            /* 0 = no, 1 = yes */
-    char value_str[SYMBOL_VALUE_MAX]; /* optional constant value as string */
+    int sym;                    /* intern ID of the name */
+    const char *name;           /* interned spelling, owned by the compiler's arena */
+    int type;                   /* SYM_TYPE / SEM_TYPE: declared type, or adopted for KUAN */
+    int value_kind;             /* SYM_VALUE_KIND of `value` */
+    long value;                 /* last value recorded for the dump; formatted only when printed */
+
+    /* semantic analyzer state */
+    long int_value;             /* current value while is_constant */
+    unsigned char initialized;
+    unsigned char is_constant;
+    unsigned char used;         /* read somewhere in the program */
 } SymbolEntry;
 
-extern SymbolEntry *symbol_table;
-extern size_t symbol_count;
-extern size_t symbol_capacity;
+/* One symbol table per compilation (owned by BaiCompiler).
+   Entries keep their index for the life of the table; `index` is an
+   open-addressing hash from intern ID to entry index (-1 = empty slot),
+   kept at most half full. */
+typedef struct {
+    SymbolEntry *entries;
+    size_t count;
+    size_t capacity;
+
+    int *index;
+    size_t index_size;          /* power of two, 0 before the first add */
+} SymbolTable;
 
 /* Symbol table operations */
-int add_symbol(const char *name, const char *datatype, int initialized, const char *value_str);
-int find_symbol(const char *name);
-void clear_symbol_table(void);
-void print_symbol_table(void);
+int add_symbol(SymbolTable *st, int sym, const char *name, int type, int initialized);
+int find_symbol(const SymbolTable *st, int sym);
+void clear_symbol_table(SymbolTable *st);
+void print_symbol_table(BaiTrace *tr, const SymbolTable *st);
+
+/* Type token of a SYM_TYPE: "KUAN", "ENTEGER" or "CHAROT" */
+const char *symbol_type_name(int type);
 
 #endif /* SYMBOL_TABLE_H */
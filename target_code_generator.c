@@ -4,552 +4,1204 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
-
-Register registers[MAX_REGISTERS];
-Data data_storage[MAX_DATA];
-int data_count = 0;
-
-int assembly_code_count = 0;
-ASSEMBLY assembly_code[MAX_ASSEMBLY_CODE];
+#include <errno.h>
+#include "compiler.h"
 
 // === UTILITY ===
-void add_assembly_line(const char *format, ...)
+static const char *name_of(BaiCompiler *ctx, int sym)
 {
-    if (assembly_code_count >= MAX_ASSEMBLY_CODE)
-        return;
+    return intern_name(&ctx->names, sym);
+}
+
+void add_assembly_line(BaiCompiler *ctx, const char *format, ...)
+{
+    if (ctx->target.assembly_code_count == ctx->target.assembly_code_capacity)
+    {
+        int capacity = ctx->target.assembly_code_capacity ? ctx->target.assembly_code_capacity * 2 : 256;
+        ASSEMBLY *lines = (ASSEMBLY *)realloc(ctx->target.assembly_code, capacity * sizeof(ASSEMBLY));
+        if (!lines)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        ctx->target.assembly_code = lines;
+        ctx->target.assembly_code_capacity = capacity;
+    }
+
+    ASSEMBLY *line = &ctx->target.assembly_code[ctx->target.assembly_code_count++];
+    line->sym = INTERN_NONE;
 
     va_list args;
     va_start(args, format);
-    vsprintf(assembly_code[assembly_code_count++].assembly, format, args);
+    int n = vsnprintf(line->assembly, sizeof(line->assembly), format, args);
     va_end(args);
+
+    // only comments can be this long (the analyzer bounds identifiers);
+    // keep the newline so the next line does not join the cut one
+    if (n >= (int)sizeof(line->assembly))
+        line->assembly[sizeof(line->assembly) - 2] = '\n';
+}
+
+// ld/sd between a register and a variable's .data slot
+static void add_memory_line(BaiCompiler *ctx, const char *mnemonic, Register *reg, TACOperand var)
+{
+    int sym = tac_id(var);
+    add_assembly_line(ctx, "%s %s, %s(r0)\n", mnemonic, reg->name, name_of(ctx, sym));
+    ctx->target.assembly_code[ctx->target.assembly_code_count - 1].sym = sym;
+}
+
+void display_assembly_code(BaiCompiler *ctx)
+{
+    // Remove final newline for last line for clean printing; the machine
+    // code listing shares the line, so this happens with the trace off too
+    if (ctx->target.assembly_code_count > 0)
+    {
+        char *last = ctx->target.assembly_code[ctx->target.assembly_code_count - 1].assembly;
+        size_t len = strlen(last);
+        if (len > 0 && last[len - 1] == '\n')
+            last[len - 1] = '\0';
+    }
+
+    if (!trace_on(&ctx->trace, TRACE_ASM, TRACE_FULL))
+        return;
+
+    trace_printf(&ctx->trace, "===== ASSEMBLY CODE =====\n");
+    for (int i = 0; i < ctx->target.assembly_code_count; i++)
+        trace_printf(&ctx->trace, "%s", ctx->target.assembly_code[i].assembly);
+    if (ctx->target.loads_saved || ctx->target.stores_saved)
+        trace_printf(&ctx->trace, "\n; register allocation: %d load(s) and %d store(s) saved",
+                     ctx->target.loads_saved, ctx->target.stores_saved);
+    trace_printf(&ctx->trace, "\n===== ASSEMBLY CODE END =====\n\n");
+}
+
+void initialize_registers(BaiCompiler *ctx)
+{
+    for (int i = 0; i < MAX_REGISTERS; i++)
+    {
+        sprintf(ctx->target.registers[i].name, "r%d", i + 1);
+        ctx->target.registers[i].used = 0;
+        ctx->target.registers[i].assigned_temp = INTERN_NONE;
+        ctx->target.registers[i].var = INTERN_NONE;
+        ctx->target.registers[i].loaded = 0;
+        ctx->target.registers[i].dirty = 0;
+    }
+}
+
+void add_to_data_storage(BaiCompiler *ctx, int sym)
+{
+    ctx->target.data_slot[sym] = ctx->target.data_count++;
+}
+
+Register *get_available_register(BaiCompiler *ctx)
+{
+    for (int i = 0; i < MAX_REGISTERS; i++)
+        if (!ctx->target.registers[i].used)
+            return &ctx->target.registers[i];
+    return NULL;
+}
+
+Register *find_temp_reg(BaiCompiler *ctx, int temp)
+{
+    for (int i = 0; i < MAX_REGISTERS; i++)
+        if (ctx->target.registers[i].used && ctx->target.registers[i].assigned_temp == temp)
+            return &ctx->target.registers[i];
+    return NULL;
+}
+
+// Done with `reg` after reading `o` from it. A temp keeps its register
+// while value numbering left later reads of it, an allocated variable
+// until its live interval ends.
+static void release_register(BaiCompiler *ctx, Register *reg, TACOperand o)
+{
+    if (!reg || reg->var != INTERN_NONE)
+        return;
+    if (tac_kind(o) == TAC_TEMP && --ctx->target.temp_reads[tac_id(o)] > 0)
+        return;
+    reg->used = 0;
+    reg->assigned_temp = INTERN_NONE;
 }
 
-void display_assembly_code()
+static void count_temp_reads(BaiCompiler *ctx)
 {
-    printf("===== ASSEMBLY CODE =====\n");
-    for (int i = 0; i < assembly_code_count; i++)
+    int temps = ctx->tac.tempCount;
+
+    if (ctx->target.temp_reads_capacity < temps)
     {
-        char *line = assembly_code[i].assembly;
-        // Remove final newline for last line for clean printing
-        if (i == assembly_code_count - 1)
+        int *reads = (int *)realloc(ctx->target.temp_reads, temps * sizeof(int));
+        if (!reads)
         {
-            size_t len = strlen(line);
-            if (len > 0 && line[len - 1] == '\n')
-                line[len - 1] = '\0';
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
         }
-        printf("%s", line);
+        ctx->target.temp_reads = reads;
+        ctx->target.temp_reads_capacity = temps;
+    }
+    for (int t = 0; t < temps; t++)
+        ctx->target.temp_reads[t] = 0;
+    for (int i = 0; i < ctx->tac.optimizedCount; i++)
+    {
+        const TACInstruction *ins = &ctx->tac.optimizedCode[i];
+        if (tac_kind(ins->arg1) == TAC_TEMP)
+            ctx->target.temp_reads[tac_id(ins->arg1)]++;
+        if (tac_kind(ins->arg2) == TAC_TEMP)
+            ctx->target.temp_reads[tac_id(ins->arg2)]++;
     }
-    printf("\n===== ASSEMBLY CODE END =====\n\n");
 }
 
-void initialize_registers()
+// === VARIABLE REGISTERS ===
+// The program is one basic block, so a variable's live interval runs from
+// its first TAC reference to its last. Inside it the variable stays in a
+// register: loaded at most once, at its first read, and stored once, when
+// the interval ends, if it was written. Intervals are allocated in order
+// of start (linear scan) from r30 down, leaving the low registers to temps
+// and to the tiles' scratch registers; with the pool full, whichever
+// interval ends last stays in (or goes back to) memory.
+
+#define TILE_SCRATCH_REGISTERS 3    // most registers one tile claims besides temps
+
+static void load_variable(BaiCompiler *ctx, Register *reg, TACOperand var)
 {
-    for (int i = 0; i < MAX_REGISTERS; i++)
+    add_memory_line(ctx, "ld", reg, var);
+    ctx->target.var_loads++;
+}
+
+static void store_variable(BaiCompiler *ctx, Register *reg, TACOperand var)
+{
+    add_memory_line(ctx, "sd", reg, var);
+    ctx->target.var_stores++;
+}
+
+static int *resize_ints(int *p, int count)
+{
+    int *q = (int *)realloc(p, count * sizeof(int));
+    if (!q)
     {
-        sprintf(registers[i].name, "r%d", i + 1);
-        registers[i].used = 0;
-        registers[i].assigned_temp[0] = '\0';
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
     }
+    return q;
 }
 
-void add_to_data_storage(char *data)
+// Temps hold their registers from definition to last read; the most live
+// at once
+static int max_live_temps(BaiCompiler *ctx)
 {
-    strcpy(data_storage[data_count++].data, data);
+    int *reads_left = malloc((size_t)ctx->tac.tempCount * sizeof(int) + 1);
+    if (!reads_left)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    memcpy(reads_left, ctx->target.temp_reads, (size_t)ctx->tac.tempCount * sizeof(int));
+    int live = 0, max_live = 0;
+
+    for (int i = 0; i < ctx->tac.optimizedCount; i++)
+    {
+        const TACInstruction *ins = &ctx->tac.optimizedCode[i];
+
+        if (live > max_live)
+            max_live = live;
+        if (tac_kind(ins->arg1) == TAC_TEMP && --reads_left[tac_id(ins->arg1)] == 0)
+            live--;
+        if (tac_kind(ins->arg2) == TAC_TEMP && --reads_left[tac_id(ins->arg2)] == 0)
+            live--;
+        if (tac_kind(ins->result) == TAC_TEMP)
+            live++;
+    }
+    free(reads_left);
+    return max_live;
 }
 
-int is_in_data_storage(char *data)
+// Live intervals of the variables and the size of the register pool they
+// share. `reads`/`writes` get the variable references, i.e. the ld and sd
+// of code without allocation.
+static void plan_variable_registers(BaiCompiler *ctx, int *reads, int *writes)
 {
-    for (int i = 0; i < data_count; i++)
+    TargetState *t = &ctx->target;
+    int names = ctx->names.count;
+
+    if (t->var_capacity < names)
     {
-        if (strcmp(data_storage[i].data, data) == 0)
-            return 1;
+        t->var_register = resize_ints(t->var_register, names);
+        t->var_start = resize_ints(t->var_start, names);
+        t->var_end = resize_ints(t->var_end, names);
+        t->var_order = resize_ints(t->var_order, names);
+        t->var_capacity = names;
     }
-    return 0;
+    for (int v = 0; v < names; v++)
+    {
+        t->var_register[v] = -1;
+        t->var_start[v] = -1;
+    }
+    t->var_count = 0;
+    t->next_var = 0;
+    t->var_loads = 0;
+    t->var_stores = 0;
+    *reads = 0;
+    *writes = 0;
+
+    for (int i = 0; i < ctx->tac.optimizedCount; i++)
+    {
+        const TACInstruction *ins = &ctx->tac.optimizedCode[i];
+        const TACOperand operands[3] = {ins->result, ins->arg1, ins->arg2};
+
+        for (int k = 0; k < 3; k++)
+        {
+            if (tac_kind(operands[k]) != TAC_VAR)
+                continue;
+            int sym = tac_id(operands[k]);
+            if (t->var_start[sym] < 0)
+            {
+                t->var_start[sym] = i;
+                t->var_order[t->var_count++] = sym;
+            }
+            t->var_end[sym] = i;
+            if (k == 0)
+                (*writes)++;
+            else
+                (*reads)++;
+        }
+    }
+
+    // what the temps and a tile's scratch leave
+    t->var_pool = MAX_REGISTERS - max_live_temps(ctx) - TILE_SCRATCH_REGISTERS;
+    if (t->var_pool < 0)
+        t->var_pool = 0;
 }
 
-Register *get_available_register()
+// Back to memory: stored if written since it was loaded
+static void release_variable(BaiCompiler *ctx, Register *reg)
 {
-    for (int i = 0; i < MAX_REGISTERS; i++)
-        if (!registers[i].used)
-            return &registers[i];
-    return NULL;
+    if (reg->dirty)
+        store_variable(ctx, reg, tac_operand(TAC_VAR, reg->var));
+    ctx->target.var_register[reg->var] = -1;
+    reg->var = INTERN_NONE;
+    reg->used = 0;
+    reg->loaded = 0;
+    reg->dirty = 0;
 }
 
-int is_tac_temporary(char *tac)
+// Registers for the intervals starting at instruction i
+static void allocate_variables_at(BaiCompiler *ctx, int i)
 {
-    if (!tac || strncmp(tac, "temp", 4) != 0)
-        return 0;
+    TargetState *t = &ctx->target;
 
-    for (int i = 4; tac[i] != '\0'; i++)
-        if (!isdigit((unsigned char)tac[i]))
-            return 0;
+    while (t->next_var < t->var_count && t->var_start[t->var_order[t->next_var]] == i)
+    {
+        int sym = t->var_order[t->next_var++];
+        Register *reg = NULL, *furthest = NULL;
+        int held = 0;
 
-    return strlen(tac) > 4;
+        // within one instruction a register saves nothing
+        if (t->var_end[sym] == i)
+            continue;
+
+        for (int r = MAX_REGISTERS - 1; r >= 0; r--)
+        {
+            Register *x = &t->registers[r];
+            if (x->var != INTERN_NONE)
+            {
+                held++;
+                if (!furthest || t->var_end[x->var] > t->var_end[furthest->var])
+                    furthest = x;
+            }
+            else if (!x->used && !reg)
+                reg = x;
+        }
+
+        if (held >= t->var_pool)
+        {
+            if (!furthest || t->var_end[furthest->var] <= t->var_end[sym])
+                continue;
+            release_variable(ctx, furthest);
+            reg = furthest;
+        }
+        if (!reg)
+            continue;
+
+        reg->used = 1;
+        reg->assigned_temp = INTERN_NONE;
+        reg->var = sym;
+        reg->loaded = 0;
+        reg->dirty = 0;
+        t->var_register[sym] = (int)(reg - t->registers);
+    }
 }
 
-Register *find_temp_reg(char *temp)
+// Store and free the variables whose intervals end at instruction i
+static void expire_variables_at(BaiCompiler *ctx, int i)
 {
-    for (int i = 0; i < MAX_REGISTERS; i++)
-        if (registers[i].used && strcmp(registers[i].assigned_temp, temp) == 0)
-            return &registers[i];
-    return NULL;
+    for (int r = 0; r < MAX_REGISTERS; r++)
+    {
+        Register *reg = &ctx->target.registers[r];
+        if (reg->var != INTERN_NONE && ctx->target.var_end[reg->var] == i)
+            release_variable(ctx, reg);
+    }
 }
 
-int is_digit(char *value)
+// === SPILLING ===
+// A tile claims at most TILE_SCRATCH_REGISTERS registers besides the temps
+// it reads. Before each instruction that many are made free when they are
+// not: an allocated variable the instruction does not use goes back to
+// memory, else the live temp defined first (in a nested expression, the
+// one read last) is stored to a spill slot and loaded again when read.
+
+// One .data slot per temp that can be live at once, when they can outgrow
+// the registers. Names are "spillN", skipping any the program declares.
+static void reserve_spill_slots(BaiCompiler *ctx)
 {
-    if (!value || !*value)
-        return 0;
+    TargetState *t = &ctx->target;
+    int temps = ctx->tac.tempCount;
+    int max_live = max_live_temps(ctx);
+    int count = max_live > MAX_REGISTERS - TILE_SCRATCH_REGISTERS ? max_live : 0;
 
-    if (*value == '-')
-        value++;
+    if (t->spill_capacity < count)
+    {
+        t->spill_sym = resize_ints(t->spill_sym, count);
+        t->spill_busy = resize_ints(t->spill_busy, count);
+        t->spill_capacity = count;
+    }
+    char name[32];
+    for (int k = 0, n = 0; k < count; k++)
+    {
+        int sym;
+        do
+        {
+            snprintf(name, sizeof(name), "spill%d", n++);
+            sym = intern_str(&ctx->names, &ctx->arena, name);
+        } while (find_symbol(&ctx->symbols, sym) != -1);
+        t->spill_sym[k] = sym;
+        t->spill_busy[k] = 0;
+    }
+    t->spill_count = count;
 
-    if (!*value)
-        return 0;
+    if (t->temp_spill_capacity < temps)
+    {
+        t->temp_spill = resize_ints(t->temp_spill, temps);
+        t->temp_spill_capacity = temps;
+    }
+    for (int i = 0; i < temps; i++)
+        t->temp_spill[i] = -1;
+}
 
-    while (*value)
+static void spill_temp(BaiCompiler *ctx, Register *reg)
+{
+    TargetState *t = &ctx->target;
+    int k = 0;
+
+    // spilled temps and those in registers are all live, so one is free
+    while (t->spill_busy[k])
+        k++;
+    add_memory_line(ctx, "sd", reg, tac_operand(TAC_VAR, t->spill_sym[k]));
+    t->spill_busy[k] = 1;
+    t->temp_spill[reg->assigned_temp] = k;
+    reg->used = 0;
+    reg->assigned_temp = INTERN_NONE;
+}
+
+static int uses_operand(const TACInstruction *ins, TACOperand o)
+{
+    return ins->result == o || ins->arg1 == o || ins->arg2 == o;
+}
+
+static void free_registers_for(BaiCompiler *ctx, const TACInstruction *ins)
+{
+    for (;;)
     {
-        if (!isdigit(*value))
-            return 0;
-        value++;
+        Register *victim = NULL;
+        int free_count = 0;
+
+        for (int r = 0; r < MAX_REGISTERS; r++)
+        {
+            Register *x = &ctx->target.registers[r];
+            if (!x->used)
+                free_count++;
+            else if (x->var != INTERN_NONE)
+            {
+                if (!uses_operand(ins, tac_operand(TAC_VAR, x->var)) && (!victim || victim->var == INTERN_NONE))
+                    victim = x;
+            }
+            else if (x->assigned_temp != INTERN_NONE && !uses_operand(ins, tac_operand(TAC_TEMP, x->assigned_temp)))
+            {
+                if (!victim || (victim->var == INTERN_NONE && x->assigned_temp < victim->assigned_temp))
+                    victim = x;
+            }
+        }
+        if (free_count >= TILE_SCRATCH_REGISTERS || !victim)
+            return;
+
+        if (victim->var != INTERN_NONE)
+            release_variable(ctx, victim);
+        else
+            spill_temp(ctx, victim);
     }
-    return 1;
 }
 
 // === DATA SECTION ===
-void generate_data_section()
+void generate_data_section(BaiCompiler *ctx)
 {
-    add_assembly_line(".data\n");
-    for (int i = 0; i < symbol_count; i++)
+    // spill slot names are interned before the slot table is sized
+    reserve_spill_slots(ctx);
+
+    // one slot entry per interned name; the TAC generator has added its last one by now
+    if (ctx->target.data_slot_capacity < ctx->names.count)
     {
-        if (is_tac_temporary(symbol_table[i].name))
+        int *slots = (int *)realloc(ctx->target.data_slot, ctx->names.count * sizeof(int));
+        if (!slots)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        ctx->target.data_slot = slots;
+        ctx->target.data_slot_capacity = ctx->names.count;
+    }
+    for (int i = 0; i < ctx->names.count; i++)
+        ctx->target.data_slot[i] = -1;
+
+    // A variable gets a slot when the program reads it somewhere (its final
+    // value is what the program leaves behind) or the optimized TAC still
+    // uses it; the rest only had dead stores. -2 marks the latter for now.
+    for (int i = 0; i < ctx->tac.optimizedCount; i++)
+    {
+        const TACInstruction *ins = &ctx->tac.optimizedCode[i];
+        if (tac_kind(ins->result) == TAC_VAR)
+            ctx->target.data_slot[tac_id(ins->result)] = -2;
+        if (tac_kind(ins->arg1) == TAC_VAR)
+            ctx->target.data_slot[tac_id(ins->arg1)] = -2;
+        if (tac_kind(ins->arg2) == TAC_VAR)
+            ctx->target.data_slot[tac_id(ins->arg2)] = -2;
+    }
+
+    add_assembly_line(ctx, ".data\n");
+    for (int i = 0; i < ctx->symbols.count; i++)
+    {
+        int sym = ctx->symbols.entries[i].sym;
+        if (!ctx->symbols.entries[i].used && ctx->target.data_slot[sym] == -1)
             continue;
-        add_assembly_line("%s: .word64 0\n", symbol_table[i].name);
-        add_to_data_storage(symbol_table[i].name);
+        add_assembly_line(ctx, "%s: .word64 0\n", ctx->symbols.entries[i].name);
+        ctx->target.assembly_code[ctx->target.assembly_code_count - 1].sym = sym;
+        add_to_data_storage(ctx, sym);
     }
+    for (int k = 0; k < ctx->target.spill_count; k++)
+    {
+        int sym = ctx->target.spill_sym[k];
+        add_assembly_line(ctx, "%s: .word64 0\n", name_of(ctx, sym));
+        ctx->target.assembly_code[ctx->target.assembly_code_count - 1].sym = sym;
+        add_to_data_storage(ctx, sym);
+    }
+    for (int i = 0; i < ctx->names.count; i++)
+        if (ctx->target.data_slot[i] == -2)
+            ctx->target.data_slot[i] = -1;
 }
 
 // === TAC COMMENT ===
-void display_tac_as_comment(TACInstruction ins)
+void display_tac_as_comment(BaiCompiler *ctx, TACInstruction ins)
+{
+    char result[16], arg1[16], arg2[16];
+
+    if (ins.arg2 == TAC_NO_OPERAND)
+        add_assembly_line(ctx, "; %s = %s\n", tac_operand_text(ctx, ins.result, result, sizeof(result)),
+                          tac_operand_text(ctx, ins.arg1, arg1, sizeof(arg1)));
+    else
+        add_assembly_line(ctx, "; %s = %s %s %s\n", tac_operand_text(ctx, ins.result, result, sizeof(result)),
+                          tac_operand_text(ctx, ins.arg1, arg1, sizeof(arg1)), tac_op_text(ins.op),
+                          tac_operand_text(ctx, ins.arg2, arg2, sizeof(arg2)));
+}
+
+// === STRENGTH REDUCTION ===
+// dmult/ddiv take tens of cycles on the MIPS64 pipeline where a shift or
+// add takes one, so a multiply or divide by a constant has sequences of
+// shifts and adds the selector below can pick. Every one computes the same
+// 64-bit result as dmult/mflo or ddiv/mflo; sums use daddu/dsubu, which
+// wrap like the low word of the product instead of trapping.
+
+#define MAX_MULTIPLY_TERMS 3    // nonzero signed digits of the multiplier
+
+static int constant_value(BaiCompiler *ctx, TACOperand o, int64_t *out)
+{
+    const char *text = name_of(ctx, tac_id(o));
+    char *end;
+
+    errno = 0;
+    long long v = strtoll(text, &end, 10);
+    if (errno || end == text || *end)
+        return 0;
+    *out = v;
+    return 1;
+}
+
+// dsll / dsrl / dsra by 0..63, using the *32 forms past 31
+static void add_shift_line(BaiCompiler *ctx, const char *mnemonic, Register *rd, Register *rt, int amount)
 {
-    if (strlen(ins.arg2) == 0)
-        add_assembly_line("; %s = %s\n", ins.result, ins.arg1);
+    if (amount >= 32)
+        add_assembly_line(ctx, "%s32 %s, %s, %d\n", mnemonic, rd->name, rt->name, amount - 32);
     else
-        add_assembly_line("; %s = %s %s %s\n", ins.result, ins.arg1, ins.op, ins.arg2);
+        add_assembly_line(ctx, "%s %s, %s, %d\n", mnemonic, rd->name, rt->name, amount);
 }
 
-// === PERFORM OPERATION ===
-void perform_operation(char *result, char *arg1, char *op, char *arg2,
-                       Register *reg1, Register *reg2, Register *reg3, int is_for_temporary)
+// Any 64-bit constant: daddiu or ori when it fits 16 bits, else lui/ori
+// for 32 and two more dsll/ori steps for the rest
+static void load_constant(BaiCompiler *ctx, Register *reg, int64_t value)
 {
-    if (strcmp(op, "+") == 0)
-        add_assembly_line("daddu %s, %s, %s\n", reg3->name, reg1->name, reg2->name);
-    else if (strcmp(op, "-") == 0)
-        add_assembly_line("dsub %s, %s, %s\n", reg3->name, reg1->name, reg2->name);
-    else if (strcmp(op, "*") == 0)
+    uint64_t bits = (uint64_t)value;
+
+    if (value >= -32768 && value <= 32767)
+    {
+        add_assembly_line(ctx, "daddiu %s, r0, %d\n", reg->name, (int)value);
+        return;
+    }
+    if (value >= 0 && value <= 0xFFFF)
     {
-        add_assembly_line("dmult %s, %s\n", reg1->name, reg2->name);
-        add_assembly_line("mflo %s\n", reg3->name);
+        add_assembly_line(ctx, "ori %s, r0, %d\n", reg->name, (int)value);
+        return;
     }
-    else if (strcmp(op, "/") == 0)
+    if (value >= INT32_MIN && value <= INT32_MAX)
     {
-        add_assembly_line("ddiv %s, %s\n", reg1->name, reg2->name);
-        add_assembly_line("mflo %s\n", reg3->name);
+        add_assembly_line(ctx, "lui %s, %d\n", reg->name, (int)((bits >> 16) & 0xFFFF));
+        add_assembly_line(ctx, "ori %s, %s, %d\n", reg->name, reg->name, (int)(bits & 0xFFFF));
+        return;
     }
+    add_assembly_line(ctx, "lui %s, %d\n", reg->name, (int)((bits >> 48) & 0xFFFF));
+    add_assembly_line(ctx, "ori %s, %s, %d\n", reg->name, reg->name, (int)((bits >> 32) & 0xFFFF));
+    add_shift_line(ctx, "dsll", reg, reg, 16);
+    add_assembly_line(ctx, "ori %s, %s, %d\n", reg->name, reg->name, (int)((bits >> 16) & 0xFFFF));
+    add_shift_line(ctx, "dsll", reg, reg, 16);
+    add_assembly_line(ctx, "ori %s, %s, %d\n", reg->name, reg->name, (int)(bits & 0xFFFF));
+}
+
+// A literal operand into `reg`, with lui/ori when it does not fit daddiu
+static void load_literal(BaiCompiler *ctx, Register *reg, TACOperand o)
+{
+    int64_t v;
 
-    if (!is_for_temporary)
+    if (constant_value(ctx, o, &v))
+        load_constant(ctx, reg, v);
+    else
+        add_assembly_line(ctx, "daddiu %s, r0, %s\n", reg->name, name_of(ctx, tac_id(o)));
+}
+
+// Non-adjacent form of |c|: the fewest powers of two, each added or
+// subtracted. Returns the number of terms, or 0 when there are more than
+// MAX_MULTIPLY_TERMS. Terms come lowest first; the highest is positive.
+static int multiplier_terms(int64_t c, int shift[], int sign[])
+{
+    uint64_t n = c < 0 ? 0 - (uint64_t)c : (uint64_t)c;
+    int count = 0;
+
+    for (int bit = 0; n; bit++, n >>= 1)
+    {
+        if (!(n & 1))
+            continue;
+        if (count == MAX_MULTIPLY_TERMS)
+            return 0;
+        shift[count] = bit;
+        sign[count] = (n & 3) == 3 ? -1 : 1;
+        n += sign[count] < 0;   // ...0111 becomes ...1000 once -1 is taken out
+        count++;
+    }
+    return count;
+}
+
+// Magic number and shift for signed division by d, |d| >= 2 (Hacker's
+// Delight, 10-1): x / d == (mulhs(M, x) [+/- x]) >> s, plus one if negative
+static void division_magic(int64_t d, int64_t *magic, int *shift)
+{
+    const uint64_t two63 = (uint64_t)1 << 63;
+    uint64_t ad = d < 0 ? 0 - (uint64_t)d : (uint64_t)d;
+    uint64_t t = two63 + ((uint64_t)d >> 63);
+    uint64_t anc = t - 1 - t % ad;
+    uint64_t q1 = two63 / anc, r1 = two63 - q1 * anc;
+    uint64_t q2 = two63 / ad, r2 = two63 - q2 * ad;
+    uint64_t delta;
+    int p = 63;
+
+    do
     {
-        add_assembly_line("sd %s, %s(r0)\n", reg3->name, result);
-        if (reg1)
+        p++;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc)
         {
-            reg1->used = 0;
-            reg1->assigned_temp[0] = '\0';
+            q1++;
+            r1 -= anc;
         }
-        if (reg2)
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad)
         {
-            reg2->used = 0;
-            reg2->assigned_temp[0] = '\0';
+            q2++;
+            r2 -= ad;
         }
-        if (reg3)
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+
+    *magic = (int64_t)(q2 + 1);
+    if (d < 0)
+        *magic = (int64_t)(0 - (uint64_t)*magic);
+    *shift = p - 64;
+}
+
+static void emit_multiply_by_constant(BaiCompiler *ctx, Register *dst, Register *src, Register *scratch,
+                                      int64_t c, int terms, const int shift[], const int sign[])
+{
+    if (terms == 0)
+    {
+        add_assembly_line(ctx, "daddu %s, r0, r0\n", dst->name);
+        return;
+    }
+
+    add_shift_line(ctx, "dsll", dst, src, shift[terms - 1]);
+    for (int k = terms - 2; k >= 0; k--)
+    {
+        Register *term = src;
+        if (shift[k] > 0)
         {
-            reg3->used = 0;
-            reg3->assigned_temp[0] = '\0';
+            add_shift_line(ctx, "dsll", scratch, src, shift[k]);
+            term = scratch;
         }
+        add_assembly_line(ctx, "%s %s, %s, %s\n", sign[k] > 0 ? "daddu" : "dsubu", dst->name, dst->name, term->name);
     }
-    else
+    if (c < 0)
+        add_assembly_line(ctx, "dsubu %s, r0, %s\n", dst->name, dst->name);
+}
+
+// `magic` and `s` from division_magic(), used when |d| is not a power of two
+static void emit_divide_by_constant(BaiCompiler *ctx, Register *dst, Register *src, Register *scratch, int64_t d,
+                                    int64_t magic, int s)
+{
+    uint64_t ad = d < 0 ? 0 - (uint64_t)d : (uint64_t)d;
+
+    if (ad == 1)
     {
-        strcpy(reg3->assigned_temp, result);
-        if (reg1)
-            reg1->used = 0;
-        if (reg2)
-            reg2->used = 0;
+        add_assembly_line(ctx, d > 0 ? "daddu %s, %s, r0\n" : "dsubu %s, r0, %s\n", dst->name, src->name);
+        return;
     }
+
+    // 2^k: round toward zero by adding 2^k - 1 to negative x, then shift
+    if ((ad & (ad - 1)) == 0)
+    {
+        int k = 0;
+        while (((uint64_t)1 << k) != ad)
+            k++;
+        add_shift_line(ctx, "dsra", scratch, src, 63);
+        add_shift_line(ctx, "dsrl", scratch, scratch, 64 - k);
+        add_assembly_line(ctx, "daddu %s, %s, %s\n", scratch->name, src->name, scratch->name);
+        add_shift_line(ctx, "dsra", dst, scratch, k);
+        if (d < 0)
+            add_assembly_line(ctx, "dsubu %s, r0, %s\n", dst->name, dst->name);
+        return;
+    }
+
+    load_constant(ctx, scratch, magic);
+    add_assembly_line(ctx, "dmult %s, %s\n", src->name, scratch->name);
+    add_assembly_line(ctx, "mfhi %s\n", dst->name);
+    if (d > 0 && magic < 0)
+        add_assembly_line(ctx, "daddu %s, %s, %s\n", dst->name, dst->name, src->name);
+    else if (d < 0 && magic > 0)
+        add_assembly_line(ctx, "dsubu %s, %s, %s\n", dst->name, dst->name, src->name);
+    if (s > 0)
+        add_shift_line(ctx, "dsra", dst, dst, s);
+    add_shift_line(ctx, "dsrl", scratch, dst, 63);
+    add_assembly_line(ctx, "daddu %s, %s, %s\n", dst->name, dst->name, scratch->name);
 }
 
-void generate_code_section()
+// === INSTRUCTION SELECTION ===
+// Each TAC instruction is covered by the cheapest tile below whose pattern
+// it matches. A TAC instruction is a one-level tree, result <- op(arg1,
+// arg2), with variable, temp or literal leaves. A tile's cost is its own
+// instructions plus the leaves it needs in registers (a temp is already
+// in one, a variable takes an ld, a literal daddiu or lui/ori), plus the
+// sd of a variable result.
+
+// Issue cycles on an R4000-class MIPS64 pipeline; ld includes its
+// load-use delay
+#define CYCLES_ALU 1
+#define CYCLES_LOAD 2
+#define CYCLES_STORE 1
+#define CYCLES_MULT 12
+#define CYCLES_DIV 68
+
+#define NO_TILE -1
+#define TILE_OP(op) (1u << (op))
+
+enum
 {
-    add_assembly_line("\n.code\n");
+    SUBJECT_RESULT,
+    SUBJECT_ARG1,
+    SUBJECT_ARG2
+};
 
-    for (int i = 0; i < optimizedCount; i++)
-    {
-        TACInstruction ins = optimizedCode[i];
-        display_tac_as_comment(ins);
+// One instruction as the tiles see it, classified and parsed once
+typedef struct
+{
+    TACOperand operand[3];  // result, arg1, arg2
+    TACKind kind[3];
+    int64_t value[3];       // of a TAC_IMM operand that fits 64 bits
+    int parsed[3];
+    Register *held[3];      // register allocated to a TAC_VAR operand, or NULL
+    TACOp op;
+
+    // worked out by the constant multiply/divide costs for their emitters
+    int terms, shift[MAX_MULTIPLY_TERMS], sign[MAX_MULTIPLY_TERMS];
+    int64_t magic;
+    int magic_shift;
+} Subject;
+
+typedef struct
+{
+    unsigned ops;                           // TILE_OP() of each TACOp covered
+    int (*cost)(Subject *s);                // cycles, or NO_TILE
+    void (*emit)(BaiCompiler *ctx, const Subject *s);
+} Tile;
 
-        // case 1 : assignment only
-        if (strlen(ins.arg2) == 0)
-        {
-            // case 1 : variable = constant (for constant: check if positive or negative)
-            if (is_in_data_storage(ins.result) &&
-                (isdigit(ins.arg1[0]) || (ins.arg1[0] == '-' && isdigit(ins.arg1[1]))))
-            {
-                Register *reg = get_available_register();
-                reg->used = 1;
+static int literal_cycles(int64_t v)
+{
+    if ((v >= -32768 && v <= 32767) || (v >= 0 && v <= 0xFFFF))
+        return CYCLES_ALU;
+    if (v >= INT32_MIN && v <= INT32_MAX)
+        return 2 * CYCLES_ALU;
+    return 6 * CYCLES_ALU;
+}
 
-                add_assembly_line("daddiu %s, r0, %s\n", reg->name, ins.arg1);
-                add_assembly_line("sd %s, %s(r0)\n", reg->name, ins.result);
+// Getting operand k into a register
+static int leaf_cycles(const Subject *s, int k)
+{
+    if (s->kind[k] == TAC_VAR)
+        return s->held[k] && s->held[k]->loaded ? 0 : CYCLES_LOAD;
+    if (s->kind[k] == TAC_IMM)
+        return s->parsed[k] ? literal_cycles(s->value[k]) : CYCLES_ALU;
+    return 0;
+}
 
-                reg->used = 0;
-            }
-            // case 2 : variable = variable
-            else if (is_in_data_storage(ins.result) && is_in_data_storage(ins.arg1))
-            {
-                Register *arg1_val_reg = get_available_register();
-                arg1_val_reg->used = 1;
+static int root_cycles(const Subject *s)
+{
+    return s->kind[SUBJECT_RESULT] == TAC_VAR && !s->held[SUBJECT_RESULT] ? CYCLES_STORE : 0;
+}
 
-                add_assembly_line("ld %s, %s(r0)\n", arg1_val_reg->name, ins.arg1);
-                add_assembly_line("sd %s, %s(r0)\n", arg1_val_reg->name, ins.result);
+// The operand of `x op c` kept in a register: the non-literal side, arg1
+// when both are literals. Returns 0 when neither side is a usable literal.
+static int literal_side(const Subject *s, int *x, int *c)
+{
+    if (s->kind[SUBJECT_ARG2] == TAC_IMM && s->parsed[SUBJECT_ARG2])
+        *x = SUBJECT_ARG1, *c = SUBJECT_ARG2;
+    else if (s->kind[SUBJECT_ARG1] == TAC_IMM && s->parsed[SUBJECT_ARG1] && s->op != TAC_SUB && s->op != TAC_DIV)
+        *x = SUBJECT_ARG2, *c = SUBJECT_ARG1;
+    else
+        return 0;
+    return 1;
+}
 
-                arg1_val_reg->used = 0;
-            }
-            // case 3 : variable = temp
-            else if (is_in_data_storage(ins.result) && is_tac_temporary(ins.arg1))
-            {
-                // find register temp
-                Register *temp_reg = find_temp_reg(ins.arg1);
+static Register *claim_register(BaiCompiler *ctx)
+{
+    Register *reg = get_available_register(ctx);
+    reg->used = 1;
+    return reg;
+}
 
-                add_assembly_line("sd %s, %s(r0)\n", temp_reg->name, ins.result);
-            }
-            // case 4 : temp = variable
-            else if (is_tac_temporary(ins.result) && is_in_data_storage(ins.arg1))
-            {
-                Register *var_reg = get_available_register();
-                var_reg->used = 1;
+// Operand k, a variable in memory or a literal, into `reg`
+static void load_operand(BaiCompiler *ctx, const Subject *s, int k, Register *reg)
+{
+    if (s->kind[k] == TAC_VAR)
+        load_variable(ctx, reg, s->operand[k]);
+    else if (s->parsed[k])
+        load_constant(ctx, reg, s->value[k]);
+    else
+        load_literal(ctx, reg, s->operand[k]);
+}
 
-                add_assembly_line("ld %s, %s(r0)\n", var_reg->name, ins.arg1);
-                // the available register now becomes the temporary
-                strcpy(var_reg->assigned_temp, ins.result);
-            }
-            // case 5 : temp = constant
-            else if (is_tac_temporary(ins.result) && is_digit(ins.arg1))
-            {
-                Register *temp_reg = get_available_register();
-                temp_reg->used = 1;
-                strcpy(temp_reg->assigned_temp, ins.result);
+// Register holding operand k: a temp's or allocated variable's own, else
+// a fresh one loaded with the variable or literal
+static Register *operand_register(BaiCompiler *ctx, const Subject *s, int k)
+{
+    Register *reg = s->held[k];
 
-                add_assembly_line("daddiu %s, r0, %s\n", temp_reg->name, ins.arg1);
-            }
-            // case 6 : temp = temp
-            else if (is_tac_temporary(ins.result) && is_tac_temporary(ins.arg1))
-            {
-                // Find both temp registers
-                Register *temp_res = find_temp_reg(ins.result);
-                Register *temp_arg1 = find_temp_reg(ins.arg1);
-
-                // If result temp does not yet have a register, allocate one
-                if (!temp_res)
-                {
-                    temp_res = get_available_register();
-                    temp_res->used = 1;
-                    strcpy(temp_res->assigned_temp, ins.result);
-                }
-
-                // If argument temp does not exist (shouldn’t normally happen, but safe to check)
-                if (!temp_arg1)
-                {
-                    temp_arg1 = get_available_register();
-                    temp_arg1->used = 1;
-                    strcpy(temp_arg1->assigned_temp, ins.arg1);
-                }
-
-                // Move value from arg1 temp into result temp
-                add_assembly_line("daddu %s, %s, r0\n", temp_res->name, temp_arg1->name);
-            }
+    if (reg)
+    {
+        if (!reg->loaded)
+        {
+            load_variable(ctx, reg, s->operand[k]);
+            reg->loaded = 1;
         }
-        // case 2 : assignment + operation
-        else
+        return reg;
+    }
+
+    if (s->kind[k] == TAC_TEMP)
+    {
+        int temp = tac_id(s->operand[k]);
+        reg = find_temp_reg(ctx, temp);
+        if (!reg)
         {
-            Register *reg1 = get_available_register();
-            reg1->used = 1;
-            Register *reg2 = get_available_register();
-            reg2->used = 1;
-            Register *reg3 = get_available_register();
-            reg3->used = 1;
-
-            // variable = constant op constant
-            if (is_in_data_storage(ins.result) && is_digit(ins.arg1) && is_digit(ins.arg2))
+            // spilled, or not produced yet (should not happen)
+            reg = claim_register(ctx);
+            reg->assigned_temp = temp;
+            int slot = ctx->target.temp_spill[temp];
+            if (slot >= 0)
             {
-                add_assembly_line("daddiu %s, r0, %s\n", reg1->name, ins.arg1);
-                add_assembly_line("daddiu %s, r0, %s\n", reg2->name, ins.arg2);
-
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
+                add_memory_line(ctx, "ld", reg, tac_operand(TAC_VAR, ctx->target.spill_sym[slot]));
+                ctx->target.spill_busy[slot] = 0;
+                ctx->target.temp_spill[temp] = -1;
             }
-            // variable = variable op variable
-            else if (is_in_data_storage(ins.result) && is_in_data_storage(ins.arg1) && is_in_data_storage(ins.arg2))
-            {
-                add_assembly_line("ld %s, %s(r0)\n", reg1->name, ins.arg1);
-                add_assembly_line("ld %s, %s(r0)\n", reg2->name, ins.arg2);
+        }
+        return reg;
+    }
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // variable = variable op constant
-            else if (is_in_data_storage(ins.result) && is_in_data_storage(ins.arg1) && is_digit(ins.arg2))
-            {
-                add_assembly_line("ld %s, %s(r0)\n", reg1->name, ins.arg1);
-                add_assembly_line("daddiu %s, r0, %s\n", reg2->name, ins.arg2);
+    reg = claim_register(ctx);
+    load_operand(ctx, s, k, reg);
+    return reg;
+}
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // variable = constant op variable
-            else if (is_in_data_storage(ins.result) && is_digit(ins.arg1) && is_in_data_storage(ins.arg2))
-            {
-                add_assembly_line("daddiu %s, r0, %s\n", reg1->name, ins.arg1);
-                add_assembly_line("ld %s, %s(r0)\n", reg2->name, ins.arg2);
+// Register to compute the result in: an allocated variable's own unless
+// that is `avoid` (a source the tile reads after writing its result)
+static Register *result_register(BaiCompiler *ctx, const Subject *s, Register *avoid)
+{
+    Register *held = s->held[SUBJECT_RESULT];
+    return held && held != avoid ? held : claim_register(ctx);
+}
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // variable = temp op temp
-            else if (is_in_data_storage(ins.result) && is_tac_temporary(ins.arg1) && is_tac_temporary(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+// `dst` holds the result: kept for a temp or allocated variable, stored
+// for a variable in memory
+static void keep_result(BaiCompiler *ctx, Register *dst, const Subject *s)
+{
+    Register *held = s->held[SUBJECT_RESULT];
 
-                reg1 = find_temp_reg(ins.arg1);
-                reg2 = find_temp_reg(ins.arg2);
-                reg3 = get_available_register();
+    if (s->kind[SUBJECT_RESULT] == TAC_TEMP)
+        dst->assigned_temp = tac_id(s->operand[SUBJECT_RESULT]);
+    else if (held)
+    {
+        if (dst != held)
+        {
+            add_assembly_line(ctx, "daddu %s, %s, r0\n", held->name, dst->name);
+            dst->used = 0;
+            dst->assigned_temp = INTERN_NONE;
+        }
+        held->loaded = 1;
+        held->dirty = 1;
+    }
+    else
+    {
+        store_variable(ctx, dst, s->operand[SUBJECT_RESULT]);
+        dst->used = 0;
+        dst->assigned_temp = INTERN_NONE;
+    }
+}
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // variable = temp op variable
-            else if (is_in_data_storage(ins.result) && is_tac_temporary(ins.arg1) && is_in_data_storage(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+/* ----- copy: result = arg1 (and ops the generator does not know) ----- */
+
+// arg1 has a register of its own (a temp or allocated variable) to copy from
+static int copy_from_register(const Subject *s)
+{
+    return s->kind[SUBJECT_ARG1] == TAC_TEMP || s->held[SUBJECT_ARG1];
+}
 
-                reg1 = find_temp_reg(ins.arg1);
-                reg1->used = 1;
-                reg2 = get_available_register();
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+static int copy_cost(Subject *s)
+{
+    if (copy_from_register(s))
+        return leaf_cycles(s, SUBJECT_ARG1) + (root_cycles(s) ? CYCLES_STORE : CYCLES_ALU);
+    return leaf_cycles(s, SUBJECT_ARG1) + root_cycles(s);
+}
 
-                add_assembly_line("ld %s, %s(r0)\n", reg2->name, ins.arg2);
+static void emit_copy(BaiCompiler *ctx, const Subject *s)
+{
+    Register *held = s->held[SUBJECT_RESULT];
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // variable = variable op temp
-            else if (is_in_data_storage(ins.result) && is_in_data_storage(ins.arg1) && is_tac_temporary(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+    // a variable in memory or a literal is loaded straight into the result
+    if (!copy_from_register(s))
+    {
+        Register *dst = held ? held : claim_register(ctx);
+        load_operand(ctx, s, SUBJECT_ARG1, dst);
+        keep_result(ctx, dst, s);
+        return;
+    }
 
-                reg1 = get_available_register();
-                reg1->used = 1;
-                reg2 = find_temp_reg(ins.arg2);
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+    Register *src = operand_register(ctx, s, SUBJECT_ARG1);
+    if (s->kind[SUBJECT_RESULT] == TAC_VAR && !held)
+    {
+        store_variable(ctx, src, s->operand[SUBJECT_RESULT]);
+        release_register(ctx, src, s->operand[SUBJECT_ARG1]);
+        return;
+    }
 
-                add_assembly_line("ld %s, %s(r0)\n", reg1->name, ins.arg1);
+    Register *dst = held ? held : claim_register(ctx);
+    if (dst != src)
+        add_assembly_line(ctx, "daddu %s, %s, r0\n", dst->name, src->name);
+    release_register(ctx, src, s->operand[SUBJECT_ARG1]);
+    keep_result(ctx, dst, s);
+}
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // variable = temp op constant
-            else if (is_in_data_storage(ins.result) && is_tac_temporary(ins.arg1) && is_digit(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+/* ----- reg-reg: daddu / dsub / dmult + mflo / ddiv + mflo ----- */
 
-                reg1 = find_temp_reg(ins.arg1);
-                reg1->used = 1;
-                reg2 = get_available_register();
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+static int binary_cost(Subject *s)
+{
+    static const int op_cycles[] = {
+        [TAC_ADD] = CYCLES_ALU,
+        [TAC_SUB] = CYCLES_ALU,
+        [TAC_MUL] = CYCLES_MULT + CYCLES_ALU,
+        [TAC_DIV] = CYCLES_DIV + CYCLES_ALU,
+    };
+    return leaf_cycles(s, SUBJECT_ARG1) + leaf_cycles(s, SUBJECT_ARG2) + op_cycles[s->op] + root_cycles(s);
+}
 
-                add_assembly_line("daddiu %s, r0, %s\n", reg2->name, ins.arg2);
+static void emit_binary(BaiCompiler *ctx, const Subject *s)
+{
+    Register *reg1 = operand_register(ctx, s, SUBJECT_ARG1);
+    Register *reg2 = operand_register(ctx, s, SUBJECT_ARG2);
+    Register *reg3 = result_register(ctx, s, NULL);
+
+    if (s->op == TAC_ADD)
+        add_assembly_line(ctx, "daddu %s, %s, %s\n", reg3->name, reg1->name, reg2->name);
+    else if (s->op == TAC_SUB)
+        add_assembly_line(ctx, "dsub %s, %s, %s\n", reg3->name, reg1->name, reg2->name);
+    else
+    {
+        add_assembly_line(ctx, "%s %s, %s\n", s->op == TAC_MUL ? "dmult" : "ddiv", reg1->name, reg2->name);
+        add_assembly_line(ctx, "mflo %s\n", reg3->name);
+    }
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // variable = constant op temp
-            else if (is_in_data_storage(ins.result) && is_digit(ins.arg1) && is_tac_temporary(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+    release_register(ctx, reg1, s->operand[SUBJECT_ARG1]);
+    release_register(ctx, reg2, s->operand[SUBJECT_ARG2]);
+    keep_result(ctx, reg3, s);
+}
 
-                reg1 = get_available_register();
-                reg1->used = 1;
-                reg2 = find_temp_reg(ins.arg2);
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+/* ----- immediate: daddiu for x + c, c + x and x - c ----- */
 
-                add_assembly_line("daddiu %s, r0, %s\n", reg1->name, ins.arg1);
+static int immediate_cost(Subject *s)
+{
+    int x, c;
+
+    if (!literal_side(s, &x, &c))
+        return NO_TILE;
+    int64_t imm = s->value[c];
+    if (s->op == TAC_SUB)
+        imm = imm == INT64_MIN ? imm : -imm;
+    if (imm < -32768 || imm > 32767)
+        return NO_TILE;
+    return leaf_cycles(s, x) + CYCLES_ALU + root_cycles(s);
+}
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 0);
-            }
-            // temp = constant op constant
-            else if (is_tac_temporary(ins.result) && is_digit(ins.arg1) && is_digit(ins.arg2))
-            {
-                add_assembly_line("daddiu %s, r0, %s\n", reg1->name, ins.arg1);
-                add_assembly_line("daddiu %s, r0, %s\n", reg2->name, ins.arg2);
+static void emit_immediate(BaiCompiler *ctx, const Subject *s)
+{
+    int x, c;
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = constant op temp
-            else if (is_tac_temporary(ins.result) && is_digit(ins.arg1) && is_tac_temporary(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+    if (!literal_side(s, &x, &c))
+        return; // immediate_cost() only picks the tile when there is one
+    int imm = (int)(s->op == TAC_SUB ? -s->value[c] : s->value[c]);
+    Register *src = operand_register(ctx, s, x);
+    Register *dst = result_register(ctx, s, NULL);
 
-                reg1 = get_available_register();
-                reg1->used = 1;
-                reg2 = find_temp_reg(ins.arg2);
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+    add_assembly_line(ctx, "daddiu %s, %s, %d\n", dst->name, src->name, imm);
 
-                add_assembly_line("daddiu %s, r0, %s\n", reg1->name, ins.arg1);
+    release_register(ctx, src, s->operand[x]);
+    keep_result(ctx, dst, s);
+}
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = temp op constant
-            else if (is_tac_temporary(ins.result) && is_tac_temporary(ins.arg1) && is_digit(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+/* ----- negate: 0 - x against r0 ----- */
 
-                reg1 = find_temp_reg(ins.arg1);
-                reg1->used = 1;
-                reg2 = get_available_register();
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+static int negate_cost(Subject *s)
+{
+    if (s->kind[SUBJECT_ARG1] != TAC_IMM || !s->parsed[SUBJECT_ARG1] || s->value[SUBJECT_ARG1] != 0)
+        return NO_TILE;
+    return leaf_cycles(s, SUBJECT_ARG2) + CYCLES_ALU + root_cycles(s);
+}
 
-                add_assembly_line("daddiu %s, r0, %s\n", reg2->name, ins.arg2);
+static void emit_negate(BaiCompiler *ctx, const Subject *s)
+{
+    Register *src = operand_register(ctx, s, SUBJECT_ARG2);
+    Register *dst = result_register(ctx, s, NULL);
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = constant op variable
-            else if (is_tac_temporary(ins.result) && is_digit(ins.arg1) && is_in_data_storage(ins.arg2))
-            {
-                add_assembly_line("daddiu %s, r0, %s\n", reg1->name, ins.arg1);
-                add_assembly_line("ld %s, %s(r0)\n", reg2->name, ins.arg2);
+    add_assembly_line(ctx, "dsub %s, r0, %s\n", dst->name, src->name);
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = variable op constant
-            else if (is_tac_temporary(ins.result) && is_in_data_storage(ins.arg1) && is_digit(ins.arg2))
-            {
-                add_assembly_line("ld %s, %s(r0)\n", reg1->name, ins.arg1);
-                add_assembly_line("daddiu %s, r0, %s\n", reg2->name, ins.arg2);
+    release_register(ctx, src, s->operand[SUBJECT_ARG2]);
+    keep_result(ctx, dst, s);
+}
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = variable op variable
-            else if (is_tac_temporary(ins.result) && is_in_data_storage(ins.arg1) && is_in_data_storage(ins.arg2))
-            {
-                add_assembly_line("ld %s, %s(r0)\n", reg1->name, ins.arg1);
-                add_assembly_line("ld %s, %s(r0)\n", reg2->name, ins.arg2);
+/* ----- multiply / divide by a literal with shifts, adds and mfhi ----- */
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = temp op variable
-            else if (is_tac_temporary(ins.result) && is_tac_temporary(ins.arg1) && is_in_data_storage(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+static int multiply_cost(Subject *s)
+{
+    int x, c;
+
+    if (!literal_side(s, &x, &c))
+        return NO_TILE;
+    int64_t m = s->value[c];
+    s->terms = m ? multiplier_terms(m, s->shift, s->sign) : 0;
+    if (m && s->terms == 0)
+        return NO_TILE;
+
+    int lines = 1 + (m < 0);
+    for (int k = 0; k < s->terms - 1; k++)
+        lines += s->shift[k] > 0 ? 2 : 1;
+    return leaf_cycles(s, x) + lines * CYCLES_ALU + root_cycles(s);
+}
 
-                reg1 = find_temp_reg(ins.arg1);
-                reg1->used = 1;
-                reg2 = get_available_register();
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+static int divide_cost(Subject *s)
+{
+    if (s->kind[SUBJECT_ARG2] != TAC_IMM || !s->parsed[SUBJECT_ARG2])
+        return NO_TILE;
+    int64_t d = s->value[SUBJECT_ARG2];
+    if (d == 0 || d == INT64_MIN)
+        return NO_TILE;
+
+    uint64_t ad = d < 0 ? 0 - (uint64_t)d : (uint64_t)d;
+    int cycles;
+    if (ad == 1)
+        cycles = CYCLES_ALU;
+    else if ((ad & (ad - 1)) == 0)
+        cycles = (4 + (d < 0)) * CYCLES_ALU;
+    else
+    {
+        division_magic(d, &s->magic, &s->magic_shift);
+        int fixup = (d > 0 && s->magic < 0) || (d < 0 && s->magic > 0);
+        cycles = literal_cycles(s->magic) + CYCLES_MULT + (3 + fixup + (s->magic_shift > 0)) * CYCLES_ALU;
+    }
+    return leaf_cycles(s, SUBJECT_ARG1) + cycles + root_cycles(s);
+}
 
-                add_assembly_line("ld %s, %s(r0)\n", reg2->name, ins.arg2);
+static void emit_by_constant(BaiCompiler *ctx, const Subject *s)
+{
+    int x, c;
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = variable op temp
-            else if (is_tac_temporary(ins.result) && is_in_data_storage(ins.arg1) && is_tac_temporary(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
+    if (!literal_side(s, &x, &c))
+        return; // multiply_cost() and divide_cost() only pick the tile when there is one
+    Register *src = operand_register(ctx, s, x);
+    Register *dst = result_register(ctx, s, src);
+    Register *scratch = get_available_register(ctx);
+
+    if (s->op == TAC_MUL)
+        emit_multiply_by_constant(ctx, dst, src, scratch, s->value[c], s->terms, s->shift, s->sign);
+    else
+        emit_divide_by_constant(ctx, dst, src, scratch, s->value[c], s->magic, s->magic_shift);
 
-                reg1 = get_available_register();
-                reg1->used = 1;
-                reg2 = find_temp_reg(ins.arg2);
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
+    release_register(ctx, src, s->operand[x]);
+    keep_result(ctx, dst, s);
+}
 
-                add_assembly_line("ld %s, %s(r0)\n", reg1->name, ins.arg1);
+static const Tile tiles[] = {
+    {TILE_OP(TAC_COPY) | TILE_OP(TAC_NOP), copy_cost, emit_copy},
+    {TILE_OP(TAC_ADD) | TILE_OP(TAC_SUB), immediate_cost, emit_immediate},
+    {TILE_OP(TAC_SUB), negate_cost, emit_negate},
+    {TILE_OP(TAC_MUL), multiply_cost, emit_by_constant},
+    {TILE_OP(TAC_DIV), divide_cost, emit_by_constant},
+    {TILE_OP(TAC_ADD) | TILE_OP(TAC_SUB) | TILE_OP(TAC_MUL) | TILE_OP(TAC_DIV), binary_cost, emit_binary},
+};
 
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-            // temp = temp op temp
-            else if (is_tac_temporary(ins.result) && is_tac_temporary(ins.arg1) && is_tac_temporary(ins.arg2))
-            {
-                reg1->used = 0;
-                reg2->used = 0;
-                reg3->used = 0;
-
-                reg1 = find_temp_reg(ins.arg1);
-                reg1->used = 1;
-                reg2 = find_temp_reg(ins.arg2);
-                reg2->used = 1;
-                reg3 = get_available_register();
-                reg3->used = 1;
-
-                perform_operation(ins.result, ins.arg1, ins.op, ins.arg2, reg1, reg2, reg3, 1);
-            }
-        }
+static void select_instruction(BaiCompiler *ctx, TACInstruction ins)
+{
+    Subject s;
+    const Tile *best = NULL;
+    int best_cycles = 0;
+
+    s.operand[SUBJECT_RESULT] = ins.result;
+    s.operand[SUBJECT_ARG1] = ins.arg1;
+    s.operand[SUBJECT_ARG2] = ins.arg2;
+    s.op = ins.op;
+    for (int k = 0; k < 3; k++)
+    {
+        s.kind[k] = tac_kind(s.operand[k]);
+        s.parsed[k] = s.kind[k] == TAC_IMM && constant_value(ctx, s.operand[k], &s.value[k]);
+        s.held[k] = NULL;
+        if (s.kind[k] == TAC_VAR && ctx->target.var_register[tac_id(s.operand[k])] >= 0)
+            s.held[k] = &ctx->target.registers[ctx->target.var_register[tac_id(s.operand[k])]];
+    }
 
-        add_assembly_line("\n");
+    // a result that is not a variable or temp, a missing operand or a
+    // variable without a .data slot to load or store has no tile; an
+    // unknown operator is generated as a copy of arg1
+    if ((s.kind[SUBJECT_RESULT] != TAC_VAR && s.kind[SUBJECT_RESULT] != TAC_TEMP) || s.kind[SUBJECT_ARG1] == TAC_NONE)
+        return;
+    for (int k = 0; k < 3; k++)
+        if (s.kind[k] == TAC_VAR && ctx->target.data_slot[tac_id(s.operand[k])] < 0)
+            return;
+    if (s.kind[SUBJECT_ARG2] == TAC_NONE)
+        s.op = TAC_COPY;
+
+    for (size_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++)
+    {
+        if (!(tiles[t].ops & TILE_OP(s.op)))
+            continue;
+        int cycles = tiles[t].cost(&s);
+        if (cycles != NO_TILE && (!best || cycles < best_cycles))
+        {
+            best = &tiles[t];
+            best_cycles = cycles;
+        }
     }
+
+    best->emit(ctx, &s);
+    ctx->target.estimated_cycles += best_cycles;
 }
 
-// === OUTPUT FILE WITH PROPER HANDLING ===
-void output_assembly_file()
+void generate_code_section(BaiCompiler *ctx)
 {
-    FILE *file = fopen("output_assembly.txt", "w");
-    if (!file)
+    int reads, writes;
+
+    add_assembly_line(ctx, "\n.code\n");
+    plan_variable_registers(ctx, &reads, &writes);
+    ctx->target.estimated_cycles = 0;
+
+    for (int i = 0; i < ctx->tac.optimizedCount; i++)
     {
-        perror("Error creating output file");
-        return;
+        TACInstruction ins = ctx->tac.optimizedCode[i];
+        display_tac_as_comment(ctx, ins);
+        allocate_variables_at(ctx, i);
+        free_registers_for(ctx, &ins);
+        select_instruction(ctx, ins);
+        expire_variables_at(ctx, i);
+        add_assembly_line(ctx, "\n");
     }
 
-    for (int i = 0; i < assembly_code_count; i++)
-        fprintf(file, "%s", assembly_code[i].assembly);
+    ctx->target.loads_saved = reads - ctx->target.var_loads;
+    ctx->target.stores_saved = writes - ctx->target.var_stores;
+}
+
+// === OUTPUT FILE WITH PROPER HANDLING ===
+void output_assembly_file(BaiCompiler *ctx)
+{
+    bai_output_clear(ctx, BAI_OUT_ASSEMBLY);
 
-    if (fclose(file) != 0)
-        perror("Error closing output file");
+    for (int i = 0; i < ctx->target.assembly_code_count; i++)
+        bai_output_printf(ctx, BAI_OUT_ASSEMBLY, "%s", ctx->target.assembly_code[i].assembly);
+}
+
+void target_cleanup(BaiCompiler *ctx)
+{
+    free(ctx->target.assembly_code);
+    ctx->target.assembly_code = NULL;
+    ctx->target.assembly_code_count = 0;
+    ctx->target.assembly_code_capacity = 0;
+    free(ctx->target.data_slot);
+    ctx->target.data_slot = NULL;
+    ctx->target.data_slot_capacity = 0;
+    ctx->target.data_count = 0;
+    free(ctx->target.temp_reads);
+    ctx->target.temp_reads = NULL;
+    ctx->target.temp_reads_capacity = 0;
+    free(ctx->target.spill_sym);
+    free(ctx->target.spill_busy);
+    free(ctx->target.temp_spill);
+    ctx->target.spill_sym = NULL;
+    ctx->target.spill_busy = NULL;
+    ctx->target.temp_spill = NULL;
+    ctx->target.spill_count = 0;
+    ctx->target.spill_capacity = 0;
+    ctx->target.temp_spill_capacity = 0;
+    free(ctx->target.var_register);
+    free(ctx->target.var_start);
+    free(ctx->target.var_end);
+    free(ctx->target.var_order);
+    ctx->target.var_register = NULL;
+    ctx->target.var_start = NULL;
+    ctx->target.var_end = NULL;
+    ctx->target.var_order = NULL;
+    ctx->target.var_capacity = 0;
 }
 
 // === TARGET CODE GENERATION ===
-void generate_target_code()
+void generate_target_code(BaiCompiler *ctx)
 {
-    initialize_registers();
-    generate_data_section();
-    generate_code_section();
-    display_assembly_code();
-    output_assembly_file();
+    initialize_registers(ctx);
+    count_temp_reads(ctx);
+    generate_data_section(ctx);
+    generate_code_section(ctx);
+    display_assembly_code(ctx);
+    output_assembly_file(ctx);
 }
\ No newline at end of file
@@ -8,37 +8,87 @@
 #include "ast.h"
 #include <stdarg.h>
 
-#define MAX_DATA_LENGTH 50
-#define MAX_DATA 256
 #define MAX_REGISTER_NAME_LENGTH 10
 #define MAX_REGISTERS 30
 #define MAX_TAC 256
-#define MAX_ASSEMBLY_CODE 9999
 #define MAX_ASSEMBLY_LINE 128
-
-// 2D array for storage of Data section
-typedef struct
-{
-    char data[MAX_DATA_LENGTH];
-} Data;
+// Longest variable name: its ".data" line ("NAME: .word64 0\n") and
+// ld/sd lines ("sd r30, NAME(r0)\n") must fit in MAX_ASSEMBLY_LINE
+#define MAX_IDENTIFIER_LENGTH (MAX_ASSEMBLY_LINE - 16)
 
 typedef struct
 {
     char name[MAX_REGISTER_NAME_LENGTH];
     int used;
-    char assigned_temp[MAX_REGISTER_NAME_LENGTH];
+    int assigned_temp;  // number of the TAC temp held, INTERN_NONE if none
+    int var;            // variable allocated here across statements, INTERN_NONE if none
+    int loaded;         // ... whose value the register holds
+    int dirty;          // ... newer than its .data slot
 } Register;
 
 // Struct to hold the generated assembly output
 typedef struct
 {
     char assembly[MAX_ASSEMBLY_LINE];
+    int sym;  // variable whose .data slot the line defines or addresses, else INTERN_NONE
 } ASSEMBLY;
 
-extern int assembly_code_count;
-extern ASSEMBLY assembly_code[MAX_ASSEMBLY_CODE];
+// Register file, data section and emitted assembly for one compilation
+typedef struct
+{
+    Register registers[MAX_REGISTERS];
+
+    // Data section: slot number per intern ID, -1 for names without one
+    int *data_slot;
+    int data_slot_capacity;
+    int data_count;
+
+    // Reads of each temp not yet generated; its register is freed at the last
+    int *temp_reads;
+    int temp_reads_capacity;
+
+    // Spilling, for code whose temps outgrow the register file. Per slot:
+    // the intern ID of its .data name and whether a temp is in it. Per
+    // temp: the slot holding it, -1 while it is in a register.
+    int *spill_sym;
+    int *spill_busy;
+    int spill_count;
+    int spill_capacity;
+    int *temp_spill;
+    int temp_spill_capacity;
+
+    // Cycles of the selected code by the selector's cost model
+    long estimated_cycles;
+
+    // Linear-scan allocation of variables. Per intern ID: the register
+    // index holding it (-1 = in memory) and its first and last TAC
+    // reference; var_order lists the variables by first reference.
+    int *var_register;
+    int *var_start;
+    int *var_end;
+    int *var_order;
+    int var_capacity;
+    int var_count;
+    int next_var;       // first var_order entry not yet allocated
+    int var_pool;       // registers variables may hold at once
+
+    // ld/sd of variables emitted, and how many fewer than one per
+    // reference and one per write
+    int var_loads;
+    int var_stores;
+    int loads_saved;
+    int stores_saved;
+
+    // Emitted lines; the buffer grows as needed and is kept across compiles
+    ASSEMBLY *assembly_code;
+    int assembly_code_count;
+    int assembly_code_capacity;
+} TargetState;
+
+typedef struct BaiCompiler BaiCompiler;
 
-void initialize_registers();
-void generate_target_code();
+void initialize_registers(BaiCompiler *ctx);
+void generate_target_code(BaiCompiler *ctx);
+void target_cleanup(BaiCompiler *ctx);
 
 #endif
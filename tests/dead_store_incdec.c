@@ -0,0 +1,140 @@
+/* Regression test: dead-store elimination and prefix ++/--
+ *
+ * ++x and --x read x without marking it `used`, so the exit liveness of
+ * eliminateDeadStores() has to come from the reads in the code as well.
+ * Each case below reads a variable only through a prefix operator (and
+ * at most writes it again through a chained assignment, which leaves
+ * `used` unset too), yet the optimized code still refers to it, so it
+ * keeps its .data slot and its last store must survive.
+ *
+ * The check runs the optimized TAC bai_compile() returns over zeroed
+ * memory (as the .data section starts) and compares the final values.
+ * Exits 0 when every case passes.
+ *
+ * Build and run from the repository root:
+ *     gcc -I. tests/dead_store_incdec.c arena.c intern.c trace.c stats.c ast.c lex.yy.c scanner.c \
+ *         yacc.tab.c symbol_table.c semantic_analyzer.c intermediate_code_generator.c \
+ *         target_code_generator.c machine_code_generator.c compiler.c -o dead_store_incdec
+ *     ./dead_store_incdec
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compiler.h"
+
+typedef struct
+{
+    const char *source;
+    const char *name;   /* variable to check */
+    long long expect;   /* its value when the program ends */
+} Case;
+
+static const Case cases[] = {
+    {"ENTEGER a = 123456789!\nENTEGER c = 0!\nENTEGER d = 0!\nc -= --a!\nd = a = 7!\n", "a", 7},
+    {"ENTEGER a = 123456789!\nENTEGER c = 0!\nENTEGER d = 0!\nc -= ++a!\nd = a = 7!\n", "a", 7},
+    {"ENTEGER a = 123456789!\nENTEGER b = 7!\nENTEGER c = 0!\nENTEGER d = 0!\n"
+     "c -= (1 - --a)!\nd = a = b!\n", "a", 7},
+    {"ENTEGER a = (-100000)!\nENTEGER b = 0!\n((-100000) / 3)!\nb = (2 - ++a)!\nb = 0!\n"
+     "b = ((-100000) * 2)!\n", "a", -99999},
+};
+
+static long long operand_value(const BaiArtifacts *art, const long long *vars,
+                               const long long *temps, TACOperand o)
+{
+    switch (tac_kind(o))
+    {
+    case TAC_VAR:
+        return vars[tac_id(o)];
+    case TAC_TEMP:
+        return temps[tac_id(o)];
+    case TAC_IMM:
+    {
+        const char *text = art->names[tac_id(o)];
+        return text[0] == '\'' ? (long long)(unsigned char)text[1] : strtoll(text, NULL, 10);
+    }
+    default:
+        return 0;
+    }
+}
+
+/* Run the optimized TAC and return the final value of `name` */
+static int run_case(const Case *c, long long *value)
+{
+    BaiArtifacts art;
+    if (bai_compile(c->source, strlen(c->source), &art) != 0)
+    {
+        bai_artifacts_free(&art);
+        return -1;
+    }
+
+    int temp_count = 0;
+    for (int i = 0; i < art.tac_count; i++)
+        if (tac_kind(art.tac[i].result) == TAC_TEMP && tac_id(art.tac[i].result) >= temp_count)
+            temp_count = tac_id(art.tac[i].result) + 1;
+
+    long long *vars = calloc((size_t)art.name_count + 1, sizeof(long long));
+    long long *temps = calloc((size_t)temp_count + 1, sizeof(long long));
+    if (!vars || !temps)
+    {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < art.tac_count; i++)
+    {
+        const TACInstruction *ins = &art.tac[i];
+        long long a = operand_value(&art, vars, temps, ins->arg1);
+        long long b = operand_value(&art, vars, temps, ins->arg2);
+        long long r;
+        switch (ins->op)
+        {
+        case TAC_ADD: r = a + b; break;
+        case TAC_SUB: r = a - b; break;
+        case TAC_MUL: r = a * b; break;
+        case TAC_DIV: r = b ? a / b : 0; break;
+        default:      r = a; break;
+        }
+        if (tac_kind(ins->result) == TAC_VAR)
+            vars[tac_id(ins->result)] = r;
+        else if (tac_kind(ins->result) == TAC_TEMP)
+            temps[tac_id(ins->result)] = r;
+    }
+
+    int found = -1;
+    for (int id = 0; id < art.name_count; id++)
+        if (art.names[id] && strcmp(art.names[id], c->name) == 0)
+        {
+            *value = vars[id];
+            found = 0;
+            break;
+        }
+
+    free(vars);
+    free(temps);
+    bai_artifacts_free(&art);
+    return found;
+}
+
+int main(void)
+{
+    int failures = 0;
+    int count = (int)(sizeof(cases) / sizeof(cases[0]));
+
+    for (int i = 0; i < count; i++)
+    {
+        long long value = 0;
+        if (run_case(&cases[i], &value) != 0)
+        {
+            printf("case %d: did not compile\n", i + 1);
+            failures++;
+        }
+        else if (value != cases[i].expect)
+        {
+            printf("case %d: %s = %lld, expected %lld\n", i + 1, cases[i].name, value, cases[i].expect);
+            failures++;
+        }
+    }
+
+    printf("%d of %d case(s) passed\n", count - failures, count);
+    return failures ? 1 : 0;
+}
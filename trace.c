@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "trace.h"
+
+static const char *phase_names[TRACE_PHASE_COUNT] = {
+    "lex",
+    "parse",
+    "sem",
+    "tac",
+    "asm",
+    "mc",
+    "symbols",
+};
+
+void trace_set_all(BaiTrace *tr, TraceLevel level)
+{
+    for (int i = 0; i < TRACE_PHASE_COUNT; i++)
+        tr->level[i] = (unsigned char)level;
+}
+
+static int parse_level(const char *s, size_t n, TraceLevel *level)
+{
+    if ((n == 1 && s[0] == '0') || (n == 3 && strncmp(s, "off", 3) == 0))
+        *level = TRACE_OFF;
+    else if ((n == 1 && s[0] == '1') || (n == 4 && strncmp(s, "info", 4) == 0))
+        *level = TRACE_INFO;
+    else if ((n == 1 && s[0] == '2') || (n == 4 && strncmp(s, "full", 4) == 0))
+        *level = TRACE_FULL;
+    else
+        return 0;
+    return 1;
+}
+
+// One "level" or "phase=level" item of a spec
+static int apply_item(BaiTrace *tr, const char *s, size_t n)
+{
+    const char *eq = (const char *)memchr(s, '=', n);
+    TraceLevel level;
+
+    if (!eq)
+    {
+        if (!parse_level(s, n, &level))
+            return 0;
+        trace_set_all(tr, level);
+        return 1;
+    }
+
+    size_t name_len = (size_t)(eq - s);
+    if (!parse_level(eq + 1, n - name_len - 1, &level))
+        return 0;
+
+    if (name_len == 3 && strncmp(s, "all", 3) == 0)
+    {
+        trace_set_all(tr, level);
+        return 1;
+    }
+    for (int i = 0; i < TRACE_PHASE_COUNT; i++)
+    {
+        if (strlen(phase_names[i]) == name_len && strncmp(s, phase_names[i], name_len) == 0)
+        {
+            tr->level[i] = (unsigned char)level;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int trace_configure(BaiTrace *tr, const char *spec)
+{
+    int ok = 1;
+
+    while (spec && *spec)
+    {
+        const char *end = strchr(spec, ',');
+        size_t n = end ? (size_t)(end - spec) : strlen(spec);
+
+        if (n > 0 && !apply_item(tr, spec, n))
+            ok = 0;
+        spec = end ? end + 1 : NULL;
+    }
+    return ok;
+}
+
+static int reserve(BaiTrace *tr, size_t extra)
+{
+    size_t need = tr->len + extra + 1;
+    if (need <= tr->cap)
+        return 1;
+
+    size_t cap = tr->cap ? tr->cap : 4096;
+    while (cap < need)
+        cap *= 2;
+
+    char *data = (char *)realloc(tr->data, cap);
+    if (!data)
+        return 0;
+    tr->data = data;
+    tr->cap = cap;
+    return 1;
+}
+
+void trace_printf(BaiTrace *tr, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+
+    // most lines fit in what is left of the buffer; format straight into it
+    size_t room = tr->cap > tr->len ? tr->cap - tr->len : 0;
+    int n = vsnprintf(room ? tr->data + tr->len : NULL, room, fmt, ap);
+    va_end(ap);
+
+    if (n < 0)
+        return;
+    if ((size_t)n >= room)
+    {
+        if (!reserve(tr, (size_t)n))
+        {
+            fprintf(stderr, "Error: out of memory writing the trace\n");
+            return;
+        }
+        va_start(ap, fmt);
+        vsnprintf(tr->data + tr->len, (size_t)n + 1, fmt, ap);
+        va_end(ap);
+    }
+    tr->len += (size_t)n;
+
+    if (tr->len >= TRACE_FLUSH_SIZE)
+        trace_flush(tr);
+}
+
+void trace_flush(BaiTrace *tr)
+{
+    if (tr->len == 0)
+        return;
+    FILE *out = tr->out ? tr->out : stdout;
+    fwrite(tr->data, 1, tr->len, out);
+    tr->len = 0;
+}
+
+void trace_free(BaiTrace *tr)
+{
+    trace_flush(tr);
+    free(tr->data);
+    tr->data = NULL;
+    tr->len = tr->cap = 0;
+}
@@ -0,0 +1,92 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/* ----------------------------
+Trace channel
+
+The console logging of every phase ([LEX] lines, the AST dump, TAC,
+assembly, machine words, the symbol table) goes through here. Each
+phase has its own level; a trace call whose level is above it costs one
+compare and a not-taken branch and formats nothing. Text that is on is
+collected in memory and written with a single fwrite per compile (or
+whenever TRACE_FLUSH_SIZE bytes are pending).
+
+Levels are set with a spec string, from the BAI_TRACE environment
+variable or main's --trace= flag:
+
+    full                everything (the default for the command line)
+    0                   nothing (the default for --serve and the library)
+    lex=0,tac=full      per phase, applied left to right
+
+Levels are 0/off, 1/info (phase banners and status lines) and 2/full
+(plus the per-token, per-node and per-instruction dumps). Phases are
+lex, parse, sem, tac, asm, mc, symbols, or all. Building with
+-DBAI_NO_TRACE compiles every trace call out.
+---------------------------- */
+
+typedef enum
+{
+    TRACE_LEX,          /* [LEX] line per token */
+    TRACE_PARSE,        /* parse banners and the AST dump */
+    TRACE_SEM,          /* semantic analysis banners */
+    TRACE_TAC,          /* TAC before and after optimization */
+    TRACE_ASM,          /* assembly listing */
+    TRACE_MC,           /* every encoded machine word */
+    TRACE_SYMBOLS,      /* final symbol table */
+    TRACE_PHASE_COUNT
+} TracePhase;
+
+typedef enum
+{
+    TRACE_OFF,
+    TRACE_INFO,
+    TRACE_FULL
+} TraceLevel;
+
+#define TRACE_FLUSH_SIZE (1u << 20)
+
+typedef struct
+{
+    unsigned char level[TRACE_PHASE_COUNT];
+    char *data;         /* text not yet written */
+    size_t len;
+    size_t cap;
+    FILE *out;          /* NULL = stdout */
+} BaiTrace;
+
+#if defined(__GNUC__)
+#define TRACE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define TRACE_UNLIKELY(x) (x)
+#endif
+
+#ifdef BAI_NO_TRACE
+#define trace_on(tr, phase, lvl) 0
+#else
+#define trace_on(tr, phase, lvl) TRACE_UNLIKELY((tr)->level[(phase)] >= (lvl))
+#endif
+
+/* printf into the trace if `phase` is at `lvl` or above */
+#define TRACE(tr, phase, lvl, ...)                  \
+    do                                              \
+    {                                               \
+        if (trace_on(tr, phase, lvl))               \
+            trace_printf((tr), __VA_ARGS__);        \
+    } while (0)
+
+void trace_set_all(BaiTrace *tr, TraceLevel level);
+
+/* Apply a spec (see above). Unknown items are skipped; returns 0 if there were any. */
+int trace_configure(BaiTrace *tr, const char *spec);
+
+/* Unconditional; callers check trace_on() first */
+void trace_printf(BaiTrace *tr, const char *fmt, ...);
+
+/* Write the pending text with one fwrite */
+void trace_flush(BaiTrace *tr);
+void trace_free(BaiTrace *tr);
+
+#endif /* TRACE_H */
@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.7"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -61,8 +66,7 @@
 
 
 
-/* Copy the first part of user declarations.  */
-/* Line 371 of yacc.c  */
+/* First part of user prologue.  */
 #line 1 "yacc.y"
 
 #include <stdio.h>
@@ -70,149 +74,189 @@
 #include <string.h>
 #include "ast.h"
 
-int yylex(void);
-extern int parse_failed;
-extern ASTNode *root;
-extern void yyerror(const char *s);
+/* Only nesting (parentheses, unary chains, a = b = c) deepens the parser
+   stack now that the lists are left-recursive; let it grow with the input
+   instead of stopping at bison's default of 10000 */
+#define YYMAXDEPTH (1 << 26)
 
-/* Track real line number per input line */
-int lineCount = 1;
-
-/* Line 371 of yacc.c  */
 #line 83 "yacc.tab.c"
 
-# ifndef YY_NULL
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULL nullptr
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULL 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
+#include "yacc.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_KUAN = 3,                       /* KUAN  */
+  YYSYMBOL_ENTEGER = 4,                    /* ENTEGER  */
+  YYSYMBOL_CHAROT = 5,                     /* CHAROT  */
+  YYSYMBOL_PRENT = 6,                      /* PRENT  */
+  YYSYMBOL_EXCLAM = 7,                     /* EXCLAM  */
+  YYSYMBOL_PLUS = 8,                       /* PLUS  */
+  YYSYMBOL_MINUS = 9,                      /* MINUS  */
+  YYSYMBOL_MUL = 10,                       /* MUL  */
+  YYSYMBOL_DIV = 11,                       /* DIV  */
+  YYSYMBOL_PLUSPLUS = 12,                  /* PLUSPLUS  */
+  YYSYMBOL_MINUSMINUS = 13,                /* MINUSMINUS  */
+  YYSYMBOL_LPAREN = 14,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 15,                    /* RPAREN  */
+  YYSYMBOL_COMMA = 16,                     /* COMMA  */
+  YYSYMBOL_NEWLINE = 17,                   /* NEWLINE  */
+  YYSYMBOL_IDENTIFIER = 18,                /* IDENTIFIER  */
+  YYSYMBOL_INT_LITERAL = 19,               /* INT_LITERAL  */
+  YYSYMBOL_CHAR_LITERAL = 20,              /* CHAR_LITERAL  */
+  YYSYMBOL_STRING_LITERAL = 21,            /* STRING_LITERAL  */
+  YYSYMBOL_PLUS_EQUAL = 22,                /* PLUS_EQUAL  */
+  YYSYMBOL_MINUS_EQUAL = 23,               /* MINUS_EQUAL  */
+  YYSYMBOL_MUL_EQUAL = 24,                 /* MUL_EQUAL  */
+  YYSYMBOL_DIV_EQUAL = 25,                 /* DIV_EQUAL  */
+  YYSYMBOL_EQUAL = 26,                     /* EQUAL  */
+  YYSYMBOL_YYACCEPT = 27,                  /* $accept  */
+  YYSYMBOL_S = 28,                         /* S  */
+  YYSYMBOL_STATEMENT_LIST = 29,            /* STATEMENT_LIST  */
+  YYSYMBOL_STATEMENT = 30,                 /* STATEMENT  */
+  YYSYMBOL_PRINTING = 31,                  /* PRINTING  */
+  YYSYMBOL_PRINT_LIST = 32,                /* PRINT_LIST  */
+  YYSYMBOL_PRINT_LIST_PRIME = 33,          /* PRINT_LIST_PRIME  */
+  YYSYMBOL_PRINT_ITEM = 34,                /* PRINT_ITEM  */
+  YYSYMBOL_DECLARATION = 35,               /* DECLARATION  */
+  YYSYMBOL_DATATYPE = 36,                  /* DATATYPE  */
+  YYSYMBOL_INIT_DECLARATOR_LIST = 37,      /* INIT_DECLARATOR_LIST  */
+  YYSYMBOL_INIT_DECLARATOR = 38,           /* INIT_DECLARATOR  */
+  YYSYMBOL_DECLARATOR = 39,                /* DECLARATOR  */
+  YYSYMBOL_ASSIGNMENT = 40,                /* ASSIGNMENT  */
+  YYSYMBOL_ASSIGN_OP = 41,                 /* ASSIGN_OP  */
+  YYSYMBOL_SIMPLE_EXPR = 42,               /* SIMPLE_EXPR  */
+  YYSYMBOL_ADD_EXPR = 43,                  /* ADD_EXPR  */
+  YYSYMBOL_TERM = 44,                      /* TERM  */
+  YYSYMBOL_FACTOR = 45,                    /* FACTOR  */
+  YYSYMBOL_UNARY = 46,                     /* UNARY  */
+  YYSYMBOL_POSTFIX = 47,                   /* POSTFIX  */
+  YYSYMBOL_POSTFIX_OPT = 48,               /* POSTFIX_OPT  */
+  YYSYMBOL_PRIMARY = 49                    /* PRIMARY  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* In a future release of Bison, this section will be replaced
-   by #include "yacc.tab.h".  */
-#ifndef YY_YY_YACC_TAB_H_INCLUDED
-# define YY_YY_YACC_TAB_H_INCLUDED
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     KUAN = 258,
-     ENTEGER = 259,
-     CHAROT = 260,
-     PRENT = 261,
-     EXCLAM = 262,
-     PLUS = 263,
-     MINUS = 264,
-     MUL = 265,
-     DIV = 266,
-     PLUSPLUS = 267,
-     MINUSMINUS = 268,
-     LPAREN = 269,
-     RPAREN = 270,
-     COMMA = 271,
-     NEWLINE = 272,
-     IDENTIFIER = 273,
-     INT_LITERAL = 274,
-     CHAR_LITERAL = 275,
-     STRING_LITERAL = 276,
-     PLUS_EQUAL = 277,
-     MINUS_EQUAL = 278,
-     MUL_EQUAL = 279,
-     DIV_EQUAL = 280,
-     EQUAL = 281
-   };
-#endif
 
+/* Unqualified %code blocks.  */
+#line 41 "yacc.y"
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-{
-/* Line 387 of yacc.c  */
-#line 17 "yacc.y"
+/* Tokens come from the flex scanner or scanner.c, see bai_lex() */
+int bai_lex(YYSTYPE *yylval, BaiCompiler *ctx, yyscan_t scanner);
+#define yylex bai_lex
+void yyerror(BaiCompiler *ctx, yyscan_t scanner, const char *s);
 
-    char *str;       /* for token text */
-    ASTNode *node;   /* for AST nodes */
+#line 174 "yacc.tab.c"
 
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Line 387 of yacc.c  */
-#line 158 "yacc.tab.c"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-extern YYSTYPE yylval;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
-int yyparse ();
+typedef signed char yytype_int8;
 #endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-int yyparse ();
+typedef short yytype_int16;
 #endif
-#endif /* ! YYPARSE_PARAM */
-
-#endif /* !YY_YY_YACC_TAB_H_INCLUDED  */
 
-/* Copy the second part of user declarations.  */
-
-/* Line 390 of yacc.c  */
-#line 186 "yacc.tab.c"
-
-#ifdef short
-# undef short
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
 typedef unsigned char yytype_uint8;
-#endif
-
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
 #else
-typedef short int yytype_int8;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef int yytype_uint16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -220,16 +264,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -243,32 +299,71 @@ typedef short int yytype_int16;
 # endif
 #endif
 
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(N) (N)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -285,8 +380,7 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
       /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
 #     ifndef EXIT_SUCCESS
@@ -298,8 +392,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -315,7 +409,7 @@ YYID (yyi)
 #  endif
 #  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
 #   ifndef EXIT_SUCCESS
 #    define EXIT_SUCCESS 0
@@ -323,40 +417,37 @@ YYID (yyi)
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -366,16 +457,16 @@ union yyalloc
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
@@ -385,24 +476,24 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
-      while (YYID (0))
+      while (0)
 #  endif
 # endif
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  47
+#define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   88
+#define YYLAST   84
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  27
@@ -410,18 +501,23 @@ union yyalloc
 #define YYNNTS  23
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  56
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  82
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  80
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   281
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -455,260 +551,204 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     8,     9,    12,    15,    18,    21,
-      23,    26,    28,    31,    34,    35,    39,    40,    42,    44,
-      47,    49,    51,    53,    55,    59,    61,    65,    67,    71,
-      75,    79,    81,    83,    85,    87,    89,    91,    95,    99,
-     101,   105,   109,   111,   113,   115,   118,   121,   124,   127,
-     130,   131,   133,   135,   137,   139,   141
+       0,    80,    80,    90,    99,   104,   105,   106,   107,   108,
+     109,   110,   115,   120,   123,   127,   136,   140,   141,   146,
+     153,   154,   155,   161,   163,   180,   182,   187,   189,   195,
+     200,   209,   210,   211,   212,   213,   218,   222,   223,   224,
+     228,   229,   230,   234,   235,   239,   240,   241,   242,   246,
+     257,   258,   259,   263,   264,   265,   266
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      28,     0,    -1,    29,    -1,    30,    29,    -1,    -1,    35,
-       7,    -1,    40,     7,    -1,    42,     7,    -1,    31,     7,
-      -1,     7,    -1,     1,    17,    -1,    17,    -1,     6,    32,
-      -1,    34,    33,    -1,    -1,    16,    34,    33,    -1,    -1,
-      42,    -1,    21,    -1,    36,    37,    -1,     5,    -1,     4,
-      -1,     3,    -1,    38,    -1,    38,    16,    37,    -1,    39,
-      -1,    39,    26,    42,    -1,    18,    -1,    14,    39,    15,
-      -1,    18,    41,    40,    -1,    18,    41,    42,    -1,    26,
-      -1,    22,    -1,    23,    -1,    25,    -1,    24,    -1,    43,
-      -1,    43,     8,    44,    -1,    43,     9,    44,    -1,    44,
-      -1,    44,    10,    45,    -1,    44,    11,    45,    -1,    45,
-      -1,    46,    -1,    47,    -1,     8,    45,    -1,     9,    45,
-      -1,    12,    47,    -1,    13,    47,    -1,    49,    48,    -1,
-      -1,    12,    -1,    13,    -1,    18,    -1,    19,    -1,    20,
-      -1,    14,    42,    15,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint8 yyrline[] =
-{
-       0,    47,    47,    55,    58,    63,    64,    65,    66,    67,
-      68,    69,    74,    79,    82,    86,    89,    93,    94,    99,
-     107,   108,   109,   113,   115,   120,   122,   127,   129,   135,
-     141,   151,   152,   153,   154,   155,   160,   164,   165,   166,
-     170,   171,   172,   176,   177,   181,   182,   183,   184,   188,
-     200,   201,   202,   206,   207,   208,   209
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "KUAN", "ENTEGER", "CHAROT", "PRENT",
-  "EXCLAM", "PLUS", "MINUS", "MUL", "DIV", "PLUSPLUS", "MINUSMINUS",
-  "LPAREN", "RPAREN", "COMMA", "NEWLINE", "IDENTIFIER", "INT_LITERAL",
-  "CHAR_LITERAL", "STRING_LITERAL", "PLUS_EQUAL", "MINUS_EQUAL",
-  "MUL_EQUAL", "DIV_EQUAL", "EQUAL", "$accept", "S", "STATEMENT_LIST",
-  "STATEMENT", "PRINTING", "PRINT_LIST", "PRINT_LIST_PRIME", "PRINT_ITEM",
-  "DECLARATION", "DATATYPE", "INIT_DECLARATOR_LIST", "INIT_DECLARATOR",
-  "DECLARATOR", "ASSIGNMENT", "ASSIGN_OP", "SIMPLE_EXPR", "ADD_EXPR",
-  "TERM", "FACTOR", "UNARY", "POSTFIX", "POSTFIX_OPT", "PRIMARY", YY_NULL
+  "\"end of file\"", "error", "\"invalid token\"", "KUAN", "ENTEGER",
+  "CHAROT", "PRENT", "EXCLAM", "PLUS", "MINUS", "MUL", "DIV", "PLUSPLUS",
+  "MINUSMINUS", "LPAREN", "RPAREN", "COMMA", "NEWLINE", "IDENTIFIER",
+  "INT_LITERAL", "CHAR_LITERAL", "STRING_LITERAL", "PLUS_EQUAL",
+  "MINUS_EQUAL", "MUL_EQUAL", "DIV_EQUAL", "EQUAL", "$accept", "S",
+  "STATEMENT_LIST", "STATEMENT", "PRINTING", "PRINT_LIST",
+  "PRINT_LIST_PRIME", "PRINT_ITEM", "DECLARATION", "DATATYPE",
+  "INIT_DECLARATOR_LIST", "INIT_DECLARATOR", "DECLARATOR", "ASSIGNMENT",
+  "ASSIGN_OP", "SIMPLE_EXPR", "ADD_EXPR", "TERM", "FACTOR", "UNARY",
+  "POSTFIX", "POSTFIX_OPT", "PRIMARY", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-12)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+#define YYTABLE_NINF (-3)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int8 yypact[] =
 {
-       0,    27,    28,    29,    29,    30,    30,    30,    30,    30,
-      30,    30,    31,    32,    32,    33,    33,    34,    34,    35,
-      36,    36,    36,    37,    37,    38,    38,    39,    39,    40,
-      40,    41,    41,    41,    41,    41,    42,    43,    43,    43,
-      44,    44,    44,    45,    45,    46,    46,    46,    46,    47,
-      48,    48,    48,    49,    49,    49,    49
+     -12,     6,    10,   -12,     3,   -12,   -12,   -12,    23,   -12,
+      40,    40,   -11,   -11,    40,   -12,    52,   -12,   -12,   -12,
+      19,    33,     7,    48,    56,    -4,    28,   -12,   -12,   -12,
+      21,   -12,   -12,   -12,   -12,   -12,   -12,   -12,   -12,   -12,
+     -12,    49,   -12,   -12,   -12,   -12,   -12,    53,   -12,   -12,
+       7,   -12,    54,   -12,    43,   -12,   -12,    40,    40,    40,
+      40,   -12,   -12,   -12,    63,   -12,   -12,   -12,    65,     7,
+      40,    28,    28,   -12,   -12,    23,   -12,   -12,   -12,   -12
 };
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       0,     2,     1,     2,     0,     2,     2,     2,     2,     1,
-       2,     1,     2,     2,     0,     3,     0,     1,     1,     2,
-       1,     1,     1,     1,     3,     1,     3,     1,     3,     3,
-       3,     1,     1,     1,     1,     1,     1,     3,     3,     1,
-       3,     3,     1,     1,     1,     2,     2,     2,     2,     2,
-       0,     1,     1,     1,     1,     1,     3
+       4,     0,     0,     1,     0,    22,    21,    20,    14,     9,
+       0,     0,     0,     0,     0,    11,    53,    54,    55,     3,
+       0,     0,     0,     0,     0,    36,    39,    42,    43,    44,
+      50,    10,    53,    18,    12,    16,    17,    45,    46,    47,
+      48,     0,    32,    33,    35,    34,    31,     0,     8,     5,
+       0,    27,    19,    23,    25,     6,     7,     0,     0,     0,
+       0,    51,    52,    49,    13,    56,    29,    30,     0,     0,
+       0,    37,    38,    40,    41,     0,    28,    24,    26,    15
 };
 
-/* YYDEFACT[STATE-NAME] -- Default reduction number in state STATE-NUM.
-   Performed when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
 {
-       0,     0,    22,    21,    20,    14,     9,     0,     0,     0,
-       0,     0,    11,    53,    54,    55,     0,     2,     0,     0,
-       0,     0,     0,     0,    36,    39,    42,    43,    44,    50,
-      10,    53,    18,    12,    16,    17,    45,    46,    47,    48,
-       0,    32,    33,    35,    34,    31,     0,     1,     3,     8,
-       5,     0,    27,    19,    23,    25,     6,     7,     0,     0,
-       0,     0,    51,    52,    49,     0,    13,    56,    29,    30,
-       0,     0,     0,    37,    38,    40,    41,    16,    28,    24,
-      26,    15
+     -12,   -12,   -12,   -12,   -12,   -12,   -12,     8,   -12,   -12,
+     -12,    12,    32,    37,   -12,    -2,   -12,    -1,    -9,   -12,
+      34,   -12,   -12
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,    16,    17,    18,    19,    33,    66,    34,    20,    21,
-      53,    54,    55,    22,    46,    23,    24,    25,    26,    27,
-      28,    64,    29
+       0,     1,     2,    19,    20,    34,    64,    35,    21,    22,
+      52,    53,    54,    23,    47,    36,    25,    26,    27,    28,
+      29,    63,    30
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -15
-static const yytype_int8 yypact[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
-       4,   -14,   -15,   -15,   -15,    17,   -15,    31,    31,    14,
-      14,    31,   -15,    46,   -15,   -15,    20,   -15,     4,     7,
-      35,     1,    41,    52,    38,    55,   -15,   -15,   -15,    61,
-     -15,   -15,   -15,   -15,    11,   -15,   -15,   -15,   -15,   -15,
-      60,   -15,   -15,   -15,   -15,   -15,    44,   -15,   -15,   -15,
-     -15,     1,   -15,   -15,    45,    54,   -15,   -15,    31,    31,
-      31,    31,   -15,   -15,   -15,    17,   -15,   -15,   -15,   -15,
-      66,     1,    31,    55,    55,   -15,   -15,    11,   -15,   -15,
-     -15,   -15
+      24,    37,    38,    14,    57,    58,     3,    32,    17,    18,
+      -2,     4,    41,     5,     6,     7,     8,     9,    10,    11,
+      31,    50,    12,    13,    14,    51,    48,    15,    16,    17,
+      18,    10,    11,    61,    62,    12,    13,    14,    59,    60,
+      49,    32,    17,    18,    33,    67,    39,    40,    10,    11,
+      73,    74,    12,    13,    14,    55,    71,    72,    32,    17,
+      18,    10,    11,    56,    65,    12,    13,    14,    78,    70,
+      69,    16,    17,    18,    42,    43,    44,    45,    46,    75,
+      76,    77,    68,    79,    66
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int8 yycheck[] =
 {
-     -15,   -15,    64,   -15,   -15,   -15,     6,    19,   -15,   -15,
-      15,   -15,    34,    42,   -15,    -5,   -15,    18,    -6,   -15,
-      69,   -15,   -15
+       2,    10,    11,    14,     8,     9,     0,    18,    19,    20,
+       0,     1,    14,     3,     4,     5,     6,     7,     8,     9,
+      17,    14,    12,    13,    14,    18,     7,    17,    18,    19,
+      20,     8,     9,    12,    13,    12,    13,    14,    10,    11,
+       7,    18,    19,    20,    21,    47,    12,    13,     8,     9,
+      59,    60,    12,    13,    14,     7,    57,    58,    18,    19,
+      20,     8,     9,     7,    15,    12,    13,    14,    70,    26,
+      16,    18,    19,    20,    22,    23,    24,    25,    26,    16,
+      15,    69,    50,    75,    47
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -5
-static const yytype_int8 yytable[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-      35,    36,    37,    30,    -4,     1,    40,     2,     3,     4,
-       5,     6,     7,     8,    49,    51,     9,    10,    11,    52,
-      47,    12,    13,    14,    15,     7,     8,    65,    11,     9,
-      10,    11,    31,    14,    15,    31,    14,    15,    32,     7,
-       8,    69,    50,     9,    10,    11,    58,    59,    56,    31,
-      14,    15,     7,     8,    75,    76,     9,    10,    11,    57,
-      35,    71,    13,    14,    15,    60,    61,    80,    41,    42,
-      43,    44,    45,    62,    63,    67,    73,    74,    38,    39,
-      72,    78,    48,    81,    77,    70,    79,     0,    68
+       0,    28,    29,     0,     1,     3,     4,     5,     6,     7,
+       8,     9,    12,    13,    14,    17,    18,    19,    20,    30,
+      31,    35,    36,    40,    42,    43,    44,    45,    46,    47,
+      49,    17,    18,    21,    32,    34,    42,    45,    45,    47,
+      47,    42,    22,    23,    24,    25,    26,    41,     7,     7,
+      14,    18,    37,    38,    39,     7,     7,     8,     9,    10,
+      11,    12,    13,    48,    33,    15,    40,    42,    39,    16,
+      26,    44,    44,    45,    45,    16,    15,    38,    42,    34
 };
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-15)))
-
-#define yytable_value_is_error(Yytable_value) \
-  YYID (0)
-
-static const yytype_int8 yycheck[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       5,     7,     8,    17,     0,     1,    11,     3,     4,     5,
-       6,     7,     8,     9,     7,    14,    12,    13,    14,    18,
-       0,    17,    18,    19,    20,     8,     9,    16,    14,    12,
-      13,    14,    18,    19,    20,    18,    19,    20,    21,     8,
-       9,    46,     7,    12,    13,    14,     8,     9,     7,    18,
-      19,    20,     8,     9,    60,    61,    12,    13,    14,     7,
-      65,    16,    18,    19,    20,    10,    11,    72,    22,    23,
-      24,    25,    26,    12,    13,    15,    58,    59,     9,    10,
-      26,    15,    18,    77,    65,    51,    71,    -1,    46
+       0,    27,    28,    29,    29,    30,    30,    30,    30,    30,
+      30,    30,    31,    32,    32,    33,    33,    34,    34,    35,
+      36,    36,    36,    37,    37,    38,    38,    39,    39,    40,
+      40,    41,    41,    41,    41,    41,    42,    43,    43,    43,
+      44,    44,    44,    45,    45,    46,    46,    46,    46,    47,
+      48,    48,    48,    49,    49,    49,    49
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,     1,     3,     4,     5,     6,     7,     8,     9,    12,
-      13,    14,    17,    18,    19,    20,    28,    29,    30,    31,
-      35,    36,    40,    42,    43,    44,    45,    46,    47,    49,
-      17,    18,    21,    32,    34,    42,    45,    45,    47,    47,
-      42,    22,    23,    24,    25,    26,    41,     0,    29,     7,
-       7,    14,    18,    37,    38,    39,     7,     7,     8,     9,
-      10,    11,    12,    13,    48,    16,    33,    15,    40,    42,
-      39,    16,    26,    44,    44,    45,    45,    34,    15,    37,
-      42,    33
+       0,     2,     1,     2,     0,     2,     2,     2,     2,     1,
+       2,     1,     2,     2,     0,     3,     0,     1,     1,     2,
+       1,     1,     1,     1,     3,     1,     3,     1,     3,     3,
+       3,     1,     1,     1,     1,     1,     1,     3,     3,     1,
+       3,     3,     1,     1,     1,     2,     2,     2,     2,     2,
+       0,     1,     1,     1,     1,     1,     3
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
 
-#define YYRECOVERING()  (!!yyerrstatus)
+enum { YYENOMEM = -2 };
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-/* Error token number */
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (ctx, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -718,82 +758,60 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, ctx, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, BaiCompiler *ctx, yyscan_t scanner)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (ctx);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, BaiCompiler *ctx, yyscan_t scanner)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, ctx, scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -801,16 +819,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
 static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -821,63 +831,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, BaiCompiler *ctx, yyscan_t scanner)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], ctx, scanner);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, ctx, scanner); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -893,363 +896,85 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULL, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULL;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - Assume YYFAIL is not used.  It's too flawed to consider.  See
-       <http://lists.gnu.org/archive/html/bison-patches/2009-12/msg00024.html>
-       for details.  YYERROR is fine as it does not invoke this
-       function.
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULL, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, BaiCompiler *ctx, yyscan_t scanner)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
+  YY_USE (ctx);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
-    {
-
-      default:
-        break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-
-#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END
-#endif
-#ifndef YY_INITIAL_VALUE
-# define YY_INITIAL_VALUE(Value) /* Nothing. */
-#endif
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval YY_INITIAL_VALUE(yyval_default);
-
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
 int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
+yyparse (BaiCompiler *ctx, yyscan_t scanner)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1257,102 +982,107 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1363,18 +1093,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, ctx, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1402,15 +1143,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1425,14 +1164,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1445,347 +1184,367 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-/* Line 1792 of yacc.c  */
-#line 48 "yacc.y"
+  case 2: /* S: STATEMENT_LIST  */
+#line 81 "yacc.y"
     {
-        root = new_node(NODE_START, "START", (yyvsp[(1) - (1)].node), NULL, lineCount);
+        ctx->root = ast_node(&ctx->ast, NODE_START, AST_KIND_NONE, (yyvsp[0].list).head, AST_NULL, ctx->lineCount);
     }
+#line 1193 "yacc.tab.c"
     break;
 
-  case 3:
-/* Line 1792 of yacc.c  */
-#line 56 "yacc.y"
-    { (yyval.node) = new_node(NODE_STATEMENT_LIST, "STMT_LIST", (yyvsp[(1) - (2)].node), (yyvsp[(2) - (2)].node), lineCount); }
+  case 3: /* STATEMENT_LIST: STATEMENT_LIST STATEMENT  */
+#line 91 "yacc.y"
+      {
+          AstRef n = ast_node(&ctx->ast, NODE_STATEMENT_LIST, AST_KIND_NONE, (yyvsp[0].node), AST_NULL, ctx->lineCount);
+          if ((yyvsp[-1].list).tail)
+              ast_set_right(&ctx->ast, (yyvsp[-1].list).tail, n);
+          (yyval.list).head = (yyvsp[-1].list).head ? (yyvsp[-1].list).head : n;
+          (yyval.list).tail = n;
+      }
+#line 1205 "yacc.tab.c"
     break;
 
-  case 4:
-/* Line 1792 of yacc.c  */
-#line 58 "yacc.y"
-    { (yyval.node) = NULL; }
+  case 4: /* STATEMENT_LIST: %empty  */
+#line 99 "yacc.y"
+      { (yyval.list).head = (yyval.list).tail = AST_NULL; }
+#line 1211 "yacc.tab.c"
     break;
 
-  case 5:
-/* Line 1792 of yacc.c  */
-#line 63 "yacc.y"
-    { (yyval.node) = new_node(NODE_STATEMENT, "DECL_STMT", (yyvsp[(1) - (2)].node), NULL, lineCount); }
+  case 5: /* STATEMENT: DECLARATION EXCLAM  */
+#line 104 "yacc.y"
+                               { (yyval.node) = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_DECL, (yyvsp[-1].node), AST_NULL, ctx->lineCount); }
+#line 1217 "yacc.tab.c"
     break;
 
-  case 6:
-/* Line 1792 of yacc.c  */
-#line 64 "yacc.y"
-    { (yyval.node) = new_node(NODE_STATEMENT, "ASSIGN_STMT", (yyvsp[(1) - (2)].node), NULL, lineCount); }
+  case 6: /* STATEMENT: ASSIGNMENT EXCLAM  */
+#line 105 "yacc.y"
+                               { (yyval.node) = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_ASSIGN, (yyvsp[-1].node), AST_NULL, ctx->lineCount); }
+#line 1223 "yacc.tab.c"
     break;
 
-  case 7:
-/* Line 1792 of yacc.c  */
-#line 65 "yacc.y"
-    { (yyval.node) = new_node(NODE_STATEMENT, "EXPR_STMT", (yyvsp[(1) - (2)].node), NULL, lineCount); }
+  case 7: /* STATEMENT: SIMPLE_EXPR EXCLAM  */
+#line 106 "yacc.y"
+                               { (yyval.node) = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_EXPR, (yyvsp[-1].node), AST_NULL, ctx->lineCount); }
+#line 1229 "yacc.tab.c"
     break;
 
-  case 8:
-/* Line 1792 of yacc.c  */
-#line 66 "yacc.y"
-    { (yyval.node) = new_node(NODE_STATEMENT, "PRINT_STMT", (yyvsp[(1) - (2)].node), NULL, lineCount); }
+  case 8: /* STATEMENT: PRINTING EXCLAM  */
+#line 107 "yacc.y"
+                               { (yyval.node) = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_PRINT, (yyvsp[-1].node), AST_NULL, ctx->lineCount); }
+#line 1235 "yacc.tab.c"
     break;
 
-  case 9:
-/* Line 1792 of yacc.c  */
-#line 67 "yacc.y"
-    { (yyval.node) = new_node(NODE_STATEMENT, "EMPTY!", NULL, NULL, lineCount); }
+  case 9: /* STATEMENT: EXCLAM  */
+#line 108 "yacc.y"
+                               { (yyval.node) = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_EMPTY, AST_NULL, AST_NULL, ctx->lineCount); }
+#line 1241 "yacc.tab.c"
     break;
 
-  case 10:
-/* Line 1792 of yacc.c  */
-#line 68 "yacc.y"
-    { yyerror("Invalid statement"); yyerrok; ++lineCount; islexerror=0; }
+  case 10: /* STATEMENT: error NEWLINE  */
+#line 109 "yacc.y"
+                               { yyerror(ctx, scanner, "Invalid statement"); yyerrok; ++ctx->lineCount; ctx->islexerror=0; }
+#line 1247 "yacc.tab.c"
     break;
 
-  case 11:
-/* Line 1792 of yacc.c  */
-#line 69 "yacc.y"
-    { ++lineCount; }
+  case 11: /* STATEMENT: NEWLINE  */
+#line 110 "yacc.y"
+                               { ++ctx->lineCount; }
+#line 1253 "yacc.tab.c"
     break;
 
-  case 12:
-/* Line 1792 of yacc.c  */
-#line 75 "yacc.y"
-    { (yyval.node) = new_node(NODE_PRINTING, "PRINT", (yyvsp[(2) - (2)].node), NULL, lineCount); }
+  case 12: /* PRINTING: PRENT PRINT_LIST  */
+#line 116 "yacc.y"
+    { (yyval.node) = ast_node(&ctx->ast, NODE_PRINTING, AST_KIND_NONE, (yyvsp[0].node), AST_NULL, ctx->lineCount); }
+#line 1259 "yacc.tab.c"
     break;
 
-  case 13:
-/* Line 1792 of yacc.c  */
-#line 80 "yacc.y"
-    { (yyval.node) = new_node(NODE_PRINT_ITEM, "PRINT_LIST", (yyvsp[(1) - (2)].node), (yyvsp[(2) - (2)].node), lineCount); }
+  case 13: /* PRINT_LIST: PRINT_ITEM PRINT_LIST_PRIME  */
+#line 121 "yacc.y"
+      { (yyval.node) = ast_node(&ctx->ast, NODE_PRINT_ITEM, AST_PRINT_LIST, (yyvsp[-1].node), (yyvsp[0].list).head, ctx->lineCount); }
+#line 1265 "yacc.tab.c"
     break;
 
-  case 14:
-/* Line 1792 of yacc.c  */
-#line 82 "yacc.y"
-    { (yyval.node) = NULL; }
+  case 14: /* PRINT_LIST: %empty  */
+#line 123 "yacc.y"
+      { (yyval.node) = AST_NULL; }
+#line 1271 "yacc.tab.c"
     break;
 
-  case 15:
-/* Line 1792 of yacc.c  */
-#line 87 "yacc.y"
-    { (yyval.node) = new_node(NODE_PRINT_ITEM, "PRINT_ITEM", (yyvsp[(2) - (3)].node), (yyvsp[(3) - (3)].node), lineCount); }
+  case 15: /* PRINT_LIST_PRIME: PRINT_LIST_PRIME COMMA PRINT_ITEM  */
+#line 128 "yacc.y"
+      {
+          AstRef n = ast_node(&ctx->ast, NODE_PRINT_ITEM, AST_PRINT_ITEM, (yyvsp[0].node), AST_NULL, ctx->lineCount);
+          if ((yyvsp[-2].list).tail)
+              ast_set_right(&ctx->ast, (yyvsp[-2].list).tail, n);
+          (yyval.list).head = (yyvsp[-2].list).head ? (yyvsp[-2].list).head : n;
+          (yyval.list).tail = n;
+      }
+#line 1283 "yacc.tab.c"
     break;
 
-  case 16:
-/* Line 1792 of yacc.c  */
-#line 89 "yacc.y"
-    { (yyval.node) = NULL; }
+  case 16: /* PRINT_LIST_PRIME: %empty  */
+#line 136 "yacc.y"
+      { (yyval.list).head = (yyval.list).tail = AST_NULL; }
+#line 1289 "yacc.tab.c"
     break;
 
-  case 17:
-/* Line 1792 of yacc.c  */
-#line 93 "yacc.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); }
+  case 17: /* PRINT_ITEM: SIMPLE_EXPR  */
+#line 140 "yacc.y"
+                               { (yyval.node) = (yyvsp[0].node); }
+#line 1295 "yacc.tab.c"
     break;
 
-  case 18:
-/* Line 1792 of yacc.c  */
-#line 94 "yacc.y"
-    { (yyval.node) = new_node(NODE_STRING_LITERAL, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 18: /* PRINT_ITEM: STRING_LITERAL  */
+#line 141 "yacc.y"
+                               { (yyval.node) = ast_string_literal(&ctx->ast, (yyvsp[0].sym), ctx->lineCount); }
+#line 1301 "yacc.tab.c"
     break;
 
-  case 19:
-/* Line 1792 of yacc.c  */
-#line 100 "yacc.y"
+  case 19: /* DECLARATION: DATATYPE INIT_DECLARATOR_LIST  */
+#line 147 "yacc.y"
     {
-        (yyval.node) = new_node(NODE_DECLARATION, (yyvsp[(1) - (2)].node) ? (yyvsp[(1) - (2)].node)->value : "TYPE", (yyvsp[(2) - (2)].node), NULL, lineCount);
-        if ((yyvsp[(1) - (2)].node)) { free((yyvsp[(1) - (2)].node)->value); free((yyvsp[(1) - (2)].node)); }
+        (yyval.node) = ast_declaration(&ctx->ast, (yyvsp[-1].dtype), (yyvsp[0].list).head, ctx->lineCount);
     }
+#line 1309 "yacc.tab.c"
     break;
 
-  case 20:
-/* Line 1792 of yacc.c  */
-#line 107 "yacc.y"
-    { (yyval.node) = new_node(NODE_DATATYPE, "CHAROT", NULL, NULL, lineCount); }
+  case 20: /* DATATYPE: CHAROT  */
+#line 153 "yacc.y"
+               { (yyval.dtype) = AST_TYPE_CHAROT; }
+#line 1315 "yacc.tab.c"
     break;
 
-  case 21:
-/* Line 1792 of yacc.c  */
-#line 108 "yacc.y"
-    { (yyval.node) = new_node(NODE_DATATYPE, "ENTEGER", NULL, NULL, lineCount); }
+  case 21: /* DATATYPE: ENTEGER  */
+#line 154 "yacc.y"
+               { (yyval.dtype) = AST_TYPE_ENTEGER; }
+#line 1321 "yacc.tab.c"
     break;
 
-  case 22:
-/* Line 1792 of yacc.c  */
-#line 109 "yacc.y"
-    { (yyval.node) = new_node(NODE_DATATYPE, "KUAN", NULL, NULL, lineCount); }
+  case 22: /* DATATYPE: KUAN  */
+#line 155 "yacc.y"
+               { (yyval.dtype) = AST_TYPE_KUAN; }
+#line 1327 "yacc.tab.c"
     break;
 
-  case 23:
-/* Line 1792 of yacc.c  */
-#line 114 "yacc.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); }
+  case 23: /* INIT_DECLARATOR_LIST: INIT_DECLARATOR  */
+#line 162 "yacc.y"
+      { (yyval.list).head = (yyvsp[0].node); (yyval.list).tail = AST_NULL; }
+#line 1333 "yacc.tab.c"
     break;
 
-  case 24:
-/* Line 1792 of yacc.c  */
-#line 116 "yacc.y"
-    { (yyval.node) = new_node(NODE_DECLARATION, "DECL", (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node), lineCount); }
+  case 24: /* INIT_DECLARATOR_LIST: INIT_DECLARATOR_LIST COMMA INIT_DECLARATOR  */
+#line 164 "yacc.y"
+      {
+          if ((yyvsp[-2].list).tail)
+          {
+              AstRef n = ast_node(&ctx->ast, NODE_DECLARATION, AST_DECL_LIST, ast_right(&ctx->ast, (yyvsp[-2].list).tail), (yyvsp[0].node), ctx->lineCount);
+              ast_set_right(&ctx->ast, (yyvsp[-2].list).tail, n);
+              (yyval.list).head = (yyvsp[-2].list).head;
+              (yyval.list).tail = n;
+          }
+          else
+          {
+              (yyval.list).head = (yyval.list).tail = ast_node(&ctx->ast, NODE_DECLARATION, AST_DECL_LIST, (yyvsp[-2].list).head, (yyvsp[0].node), ctx->lineCount);
+          }
+      }
+#line 1351 "yacc.tab.c"
     break;
 
-  case 25:
-/* Line 1792 of yacc.c  */
-#line 121 "yacc.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); }
+  case 25: /* INIT_DECLARATOR: DECLARATOR  */
+#line 181 "yacc.y"
+      { (yyval.node) = (yyvsp[0].node); }
+#line 1357 "yacc.tab.c"
     break;
 
-  case 26:
-/* Line 1792 of yacc.c  */
-#line 123 "yacc.y"
-    { (yyval.node) = new_node(NODE_DECLARATION, "INIT_DECL", (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node), lineCount); }
+  case 26: /* INIT_DECLARATOR: DECLARATOR EQUAL SIMPLE_EXPR  */
+#line 183 "yacc.y"
+      { (yyval.node) = ast_node(&ctx->ast, NODE_DECLARATION, AST_DECL_INIT, (yyvsp[-2].node), (yyvsp[0].node), ctx->lineCount); }
+#line 1363 "yacc.tab.c"
     break;
 
-  case 27:
-/* Line 1792 of yacc.c  */
-#line 128 "yacc.y"
-    { (yyval.node) = new_node(NODE_IDENTIFIER, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 27: /* DECLARATOR: IDENTIFIER  */
+#line 188 "yacc.y"
+      { (yyval.node) = ast_ident(&ctx->ast, (yyvsp[0].sym), ctx->lineCount); }
+#line 1369 "yacc.tab.c"
     break;
 
-  case 28:
-/* Line 1792 of yacc.c  */
-#line 130 "yacc.y"
-    { (yyval.node) = (yyvsp[(2) - (3)].node); }
+  case 28: /* DECLARATOR: LPAREN DECLARATOR RPAREN  */
+#line 190 "yacc.y"
+      { (yyval.node) = (yyvsp[-1].node); }
+#line 1375 "yacc.tab.c"
     break;
 
-  case 29:
-/* Line 1792 of yacc.c  */
-#line 136 "yacc.y"
-    {
-          ASTNode *id = new_node(NODE_IDENTIFIER, (yyvsp[(1) - (3)].str), NULL, NULL, lineCount);
-          (yyval.node) = new_node(NODE_ASSIGNMENT, (yyvsp[(2) - (3)].node)->value, id, (yyvsp[(3) - (3)].node), lineCount);
-          free((yyvsp[(2) - (3)].node)->value); free((yyvsp[(2) - (3)].node));
+  case 29: /* ASSIGNMENT: IDENTIFIER ASSIGN_OP ASSIGNMENT  */
+#line 196 "yacc.y"
+      {
+          AstRef id = ast_ident(&ctx->ast, (yyvsp[-2].sym), ctx->lineCount);
+          (yyval.node) = ast_op_node(&ctx->ast, NODE_ASSIGNMENT, (yyvsp[-1].op), id, (yyvsp[0].node), ctx->lineCount);
       }
+#line 1384 "yacc.tab.c"
     break;
 
-  case 30:
-/* Line 1792 of yacc.c  */
-#line 142 "yacc.y"
-    {
-          ASTNode *id = new_node(NODE_IDENTIFIER, (yyvsp[(1) - (3)].str), NULL, NULL, lineCount);
-          (yyval.node) = new_node(NODE_ASSIGNMENT, (yyvsp[(2) - (3)].node)->value, id, (yyvsp[(3) - (3)].node), lineCount);
-          free((yyvsp[(2) - (3)].node)->value); free((yyvsp[(2) - (3)].node));
+  case 30: /* ASSIGNMENT: IDENTIFIER ASSIGN_OP SIMPLE_EXPR  */
+#line 201 "yacc.y"
+      {
+          AstRef id = ast_ident(&ctx->ast, (yyvsp[-2].sym), ctx->lineCount);
+          (yyval.node) = ast_op_node(&ctx->ast, NODE_ASSIGNMENT, (yyvsp[-1].op), id, (yyvsp[0].node), ctx->lineCount);
       }
+#line 1393 "yacc.tab.c"
     break;
 
-  case 31:
-/* Line 1792 of yacc.c  */
-#line 151 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNKNOWN, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 31: /* ASSIGN_OP: EQUAL  */
+#line 209 "yacc.y"
+                   { (yyval.op) = AST_OP_ASSIGN; }
+#line 1399 "yacc.tab.c"
     break;
 
-  case 32:
-/* Line 1792 of yacc.c  */
-#line 152 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNKNOWN, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 32: /* ASSIGN_OP: PLUS_EQUAL  */
+#line 210 "yacc.y"
+                   { (yyval.op) = AST_OP_ADD_ASSIGN; }
+#line 1405 "yacc.tab.c"
     break;
 
-  case 33:
-/* Line 1792 of yacc.c  */
-#line 153 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNKNOWN, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 33: /* ASSIGN_OP: MINUS_EQUAL  */
+#line 211 "yacc.y"
+                   { (yyval.op) = AST_OP_SUB_ASSIGN; }
+#line 1411 "yacc.tab.c"
     break;
 
-  case 34:
-/* Line 1792 of yacc.c  */
-#line 154 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNKNOWN, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 34: /* ASSIGN_OP: DIV_EQUAL  */
+#line 212 "yacc.y"
+                   { (yyval.op) = AST_OP_DIV_ASSIGN; }
+#line 1417 "yacc.tab.c"
     break;
 
-  case 35:
-/* Line 1792 of yacc.c  */
-#line 155 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNKNOWN, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 35: /* ASSIGN_OP: MUL_EQUAL  */
+#line 213 "yacc.y"
+                   { (yyval.op) = AST_OP_MUL_ASSIGN; }
+#line 1423 "yacc.tab.c"
     break;
 
-  case 36:
-/* Line 1792 of yacc.c  */
-#line 160 "yacc.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); }
+  case 36: /* SIMPLE_EXPR: ADD_EXPR  */
+#line 218 "yacc.y"
+               { (yyval.node) = (yyvsp[0].node); }
+#line 1429 "yacc.tab.c"
     break;
 
-  case 37:
-/* Line 1792 of yacc.c  */
-#line 164 "yacc.y"
-    { (yyval.node) = new_node(NODE_EXPRESSION, "+", (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node), lineCount); }
+  case 37: /* ADD_EXPR: ADD_EXPR PLUS TERM  */
+#line 222 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_EXPRESSION, AST_OP_ADD, (yyvsp[-2].node), (yyvsp[0].node), ctx->lineCount); }
+#line 1435 "yacc.tab.c"
     break;
 
-  case 38:
-/* Line 1792 of yacc.c  */
-#line 165 "yacc.y"
-    { (yyval.node) = new_node(NODE_EXPRESSION, "-", (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node), lineCount); }
+  case 38: /* ADD_EXPR: ADD_EXPR MINUS TERM  */
+#line 223 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_EXPRESSION, AST_OP_SUB, (yyvsp[-2].node), (yyvsp[0].node), ctx->lineCount); }
+#line 1441 "yacc.tab.c"
     break;
 
-  case 39:
-/* Line 1792 of yacc.c  */
-#line 166 "yacc.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); }
+  case 39: /* ADD_EXPR: TERM  */
+#line 224 "yacc.y"
+                           { (yyval.node) = (yyvsp[0].node); }
+#line 1447 "yacc.tab.c"
     break;
 
-  case 40:
-/* Line 1792 of yacc.c  */
-#line 170 "yacc.y"
-    { (yyval.node) = new_node(NODE_TERM, "*", (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node), lineCount); }
+  case 40: /* TERM: TERM MUL FACTOR  */
+#line 228 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_TERM, AST_OP_MUL, (yyvsp[-2].node), (yyvsp[0].node), ctx->lineCount); }
+#line 1453 "yacc.tab.c"
     break;
 
-  case 41:
-/* Line 1792 of yacc.c  */
-#line 171 "yacc.y"
-    { (yyval.node) = new_node(NODE_TERM, "/", (yyvsp[(1) - (3)].node), (yyvsp[(3) - (3)].node), lineCount); }
+  case 41: /* TERM: TERM DIV FACTOR  */
+#line 229 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_TERM, AST_OP_DIV, (yyvsp[-2].node), (yyvsp[0].node), ctx->lineCount); }
+#line 1459 "yacc.tab.c"
     break;
 
-  case 42:
-/* Line 1792 of yacc.c  */
-#line 172 "yacc.y"
-    { (yyval.node) = (yyvsp[(1) - (1)].node); }
+  case 42: /* TERM: FACTOR  */
+#line 230 "yacc.y"
+                           { (yyval.node) = (yyvsp[0].node); }
+#line 1465 "yacc.tab.c"
     break;
 
-  case 45:
-/* Line 1792 of yacc.c  */
-#line 181 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNARY_OP, "+", (yyvsp[(2) - (2)].node), NULL, lineCount); }
+  case 45: /* UNARY: PLUS FACTOR  */
+#line 239 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_ADD, (yyvsp[0].node), AST_NULL, ctx->lineCount); }
+#line 1471 "yacc.tab.c"
     break;
 
-  case 46:
-/* Line 1792 of yacc.c  */
-#line 182 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNARY_OP, "-", (yyvsp[(2) - (2)].node), NULL, lineCount); }
+  case 46: /* UNARY: MINUS FACTOR  */
+#line 240 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_SUB, (yyvsp[0].node), AST_NULL, ctx->lineCount); }
+#line 1477 "yacc.tab.c"
     break;
 
-  case 47:
-/* Line 1792 of yacc.c  */
-#line 183 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNARY_OP, "++", (yyvsp[(2) - (2)].node), NULL, lineCount); }
+  case 47: /* UNARY: PLUSPLUS POSTFIX  */
+#line 241 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_INC, (yyvsp[0].node), AST_NULL, ctx->lineCount); }
+#line 1483 "yacc.tab.c"
     break;
 
-  case 48:
-/* Line 1792 of yacc.c  */
-#line 184 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNARY_OP, "--", (yyvsp[(2) - (2)].node), NULL, lineCount); }
+  case 48: /* UNARY: MINUSMINUS POSTFIX  */
+#line 242 "yacc.y"
+                           { (yyval.node) = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_DEC, (yyvsp[0].node), AST_NULL, ctx->lineCount); }
+#line 1489 "yacc.tab.c"
     break;
 
-  case 49:
-/* Line 1792 of yacc.c  */
-#line 189 "yacc.y"
-    {
-          if ((yyvsp[(2) - (2)].node)) {
-              (yyval.node) = new_node(NODE_POSTFIX_OP, (yyvsp[(2) - (2)].node)->value, (yyvsp[(1) - (2)].node), NULL, lineCount);
-              free((yyvsp[(2) - (2)].node)->value); free((yyvsp[(2) - (2)].node));
+  case 49: /* POSTFIX: PRIMARY POSTFIX_OPT  */
+#line 247 "yacc.y"
+      {
+          if ((yyvsp[0].op) != AST_OP_NONE) {
+              (yyval.node) = ast_op_node(&ctx->ast, NODE_POSTFIX_OP, (yyvsp[0].op), (yyvsp[-1].node), AST_NULL, ctx->lineCount);
           } else {
-              (yyval.node) = (yyvsp[(1) - (2)].node);
+              (yyval.node) = (yyvsp[-1].node);
           }
       }
+#line 1501 "yacc.tab.c"
     break;
 
-  case 50:
-/* Line 1792 of yacc.c  */
-#line 200 "yacc.y"
-    { (yyval.node) = NULL; }
+  case 50: /* POSTFIX_OPT: %empty  */
+#line 257 "yacc.y"
+                  { (yyval.op) = AST_OP_NONE; }
+#line 1507 "yacc.tab.c"
     break;
 
-  case 51:
-/* Line 1792 of yacc.c  */
-#line 201 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNKNOWN, "++", NULL, NULL, lineCount); }
+  case 51: /* POSTFIX_OPT: PLUSPLUS  */
+#line 258 "yacc.y"
+                 { (yyval.op) = AST_OP_INC; }
+#line 1513 "yacc.tab.c"
     break;
 
-  case 52:
-/* Line 1792 of yacc.c  */
-#line 202 "yacc.y"
-    { (yyval.node) = new_node(NODE_UNKNOWN, "--", NULL, NULL, lineCount); }
+  case 52: /* POSTFIX_OPT: MINUSMINUS  */
+#line 259 "yacc.y"
+                 { (yyval.op) = AST_OP_DEC; }
+#line 1519 "yacc.tab.c"
     break;
 
-  case 53:
-/* Line 1792 of yacc.c  */
-#line 206 "yacc.y"
-    { (yyval.node) = new_node(NODE_IDENTIFIER, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 53: /* PRIMARY: IDENTIFIER  */
+#line 263 "yacc.y"
+                    { (yyval.node) = ast_ident(&ctx->ast, (yyvsp[0].sym), ctx->lineCount); }
+#line 1525 "yacc.tab.c"
     break;
 
-  case 54:
-/* Line 1792 of yacc.c  */
-#line 207 "yacc.y"
-    { (yyval.node) = new_node(NODE_LITERAL, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 54: /* PRIMARY: INT_LITERAL  */
+#line 264 "yacc.y"
+                    { (yyval.node) = ast_int_literal(&ctx->ast, &ctx->names, (yyvsp[0].sym), ctx->lineCount); }
+#line 1531 "yacc.tab.c"
     break;
 
-  case 55:
-/* Line 1792 of yacc.c  */
-#line 208 "yacc.y"
-    { (yyval.node) = new_node(NODE_LITERAL, (yyvsp[(1) - (1)].str), NULL, NULL, lineCount); }
+  case 55: /* PRIMARY: CHAR_LITERAL  */
+#line 265 "yacc.y"
+                    { (yyval.node) = ast_char_literal(&ctx->ast, &ctx->names, (yyvsp[0].sym), ctx->lineCount); }
+#line 1537 "yacc.tab.c"
     break;
 
-  case 56:
-/* Line 1792 of yacc.c  */
-#line 209 "yacc.y"
-    { (yyval.node) = (yyvsp[(2) - (3)].node); }
+  case 56: /* PRIMARY: LPAREN SIMPLE_EXPR RPAREN  */
+#line 266 "yacc.y"
+                                { (yyval.node) = (yyvsp[-1].node); }
+#line 1543 "yacc.tab.c"
     break;
 
 
-/* Line 1792 of yacc.c  */
-#line 1789 "yacc.tab.c"
+#line 1547 "yacc.tab.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1799,96 +1558,58 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (ctx, scanner, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, ctx, scanner);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -1900,14 +1621,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1920,29 +1640,30 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, ctx, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1954,7 +1675,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1965,71 +1686,68 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (ctx, scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, ctx, scanner);
     }
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, ctx, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
+
+  return yyresult;
 }
 
-
-/* Line 2055 of yacc.c  */
-#line 212 "yacc.y"
+#line 269 "yacc.y"
 
 
 /* Error handler */
-void yyerror(const char *s) {
-    if (islexerror == 0) {               // only log if no previous error
-        FILE *out = fopen("output_print.txt", "w"); // overwrite
-        if (out) {
-            /* fprintf(out, "[PARSE] Syntax Error [line:%d]\n", lineCount); */
-            fprintf(out, "Syntax Error [line:%d]\n", lineCount); 
-            fclose(out);
-        }
-        islexerror = 1;                  // mark that an error was logged
+void yyerror(BaiCompiler *ctx, yyscan_t scanner, const char *s) {
+    (void)scanner;
+    if (ctx->islexerror == 0) {          // only log if no previous error
+        bai_output_clear(ctx, BAI_OUT_PRINT); // overwrite
+        /* bai_output_printf(ctx, BAI_OUT_PRINT, "[PARSE] Syntax Error [line:%d]\n", ctx->lineCount); */
+        bai_output_printf(ctx, BAI_OUT_PRINT, "Syntax Error [line:%d]\n", ctx->lineCount);
+        bai_report(ctx, BAI_DIAG_ERROR, ctx->lineCount, "Syntax Error");
+        ctx->islexerror = 1;             // mark that an error was logged
     }
-    parse_failed = 1;
+    ctx->parse_failed = 1;
 }
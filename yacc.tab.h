@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2012 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,86 +27,99 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_YACC_TAB_H_INCLUDED
 # define YY_YY_YACC_TAB_H_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 13 "yacc.y"
+
+#include "compiler.h"
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+
+#line 58 "yacc.tab.h"
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     KUAN = 258,
-     ENTEGER = 259,
-     CHAROT = 260,
-     PRENT = 261,
-     EXCLAM = 262,
-     PLUS = 263,
-     MINUS = 264,
-     MUL = 265,
-     DIV = 266,
-     PLUSPLUS = 267,
-     MINUSMINUS = 268,
-     LPAREN = 269,
-     RPAREN = 270,
-     COMMA = 271,
-     NEWLINE = 272,
-     IDENTIFIER = 273,
-     INT_LITERAL = 274,
-     CHAR_LITERAL = 275,
-     STRING_LITERAL = 276,
-     PLUS_EQUAL = 277,
-     MINUS_EQUAL = 278,
-     MUL_EQUAL = 279,
-     DIV_EQUAL = 280,
-     EQUAL = 281
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    KUAN = 258,                    /* KUAN  */
+    ENTEGER = 259,                 /* ENTEGER  */
+    CHAROT = 260,                  /* CHAROT  */
+    PRENT = 261,                   /* PRENT  */
+    EXCLAM = 262,                  /* EXCLAM  */
+    PLUS = 263,                    /* PLUS  */
+    MINUS = 264,                   /* MINUS  */
+    MUL = 265,                     /* MUL  */
+    DIV = 266,                     /* DIV  */
+    PLUSPLUS = 267,                /* PLUSPLUS  */
+    MINUSMINUS = 268,              /* MINUSMINUS  */
+    LPAREN = 269,                  /* LPAREN  */
+    RPAREN = 270,                  /* RPAREN  */
+    COMMA = 271,                   /* COMMA  */
+    NEWLINE = 272,                 /* NEWLINE  */
+    IDENTIFIER = 273,              /* IDENTIFIER  */
+    INT_LITERAL = 274,             /* INT_LITERAL  */
+    CHAR_LITERAL = 275,            /* CHAR_LITERAL  */
+    STRING_LITERAL = 276,          /* STRING_LITERAL  */
+    PLUS_EQUAL = 277,              /* PLUS_EQUAL  */
+    MINUS_EQUAL = 278,             /* MINUS_EQUAL  */
+    MUL_EQUAL = 279,               /* MUL_EQUAL  */
+    DIV_EQUAL = 280,               /* DIV_EQUAL  */
+    EQUAL = 281                    /* EQUAL  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-/* Line 2058 of yacc.c  */
-#line 17 "yacc.y"
+#line 30 "yacc.y"
 
-    char *str;       /* for token text */
-    ASTNode *node;   /* for AST nodes */
+    int sym;             /* intern ID of an identifier or literal */
+    AstOp op;            /* assignment / postfix operator */
+    AstDataType dtype;   /* declared type */
+    AstRef node;         /* for AST nodes */
+    struct {
+        AstRef head;     /* first node of a list */
+        AstRef tail;     /* node the next element is linked onto */
+    } list;
 
+#line 112 "yacc.tab.h"
 
-/* Line 2058 of yacc.c  */
-#line 89 "yacc.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
+
+int yyparse (BaiCompiler *ctx, yyscan_t scanner);
+
 
 #endif /* !YY_YY_YACC_TAB_H_INCLUDED  */
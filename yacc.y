@@ -4,19 +4,45 @@
 #include <string.h>
 #include "ast.h"
 
-int yylex(void);
-extern int parse_failed;
-extern ASTNode *root;
-extern void yyerror(const char *s);
-
-/* Track real line number per input line */
-int lineCount = 1;
+/* Only nesting (parentheses, unary chains, a = b = c) deepens the parser
+   stack now that the lists are left-recursive; let it grow with the input
+   instead of stopping at bison's default of 10000 */
+#define YYMAXDEPTH (1 << 26)
 %}
 
+%code requires {
+#include "compiler.h"
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+}
+
+/* Pure parser: all state lives in the BaiCompiler passed to yyparse() */
+%define api.pure full
+%lex-param   { BaiCompiler *ctx }
+%lex-param   { yyscan_t scanner }
+%parse-param { BaiCompiler *ctx }
+%parse-param { yyscan_t scanner }
+
 /* Semantic value types */
 %union {
-    char *str;       /* for token text */
-    ASTNode *node;   /* for AST nodes */
+    int sym;             /* intern ID of an identifier or literal */
+    AstOp op;            /* assignment / postfix operator */
+    AstDataType dtype;   /* declared type */
+    AstRef node;         /* for AST nodes */
+    struct {
+        AstRef head;     /* first node of a list */
+        AstRef tail;     /* node the next element is linked onto */
+    } list;
+}
+
+%code {
+/* Tokens come from the flex scanner or scanner.c, see bai_lex() */
+int bai_lex(YYSTYPE *yylval, BaiCompiler *ctx, yyscan_t scanner);
+#define yylex bai_lex
+void yyerror(BaiCompiler *ctx, yyscan_t scanner, const char *s);
 }
 
 /* Tokens */
@@ -28,15 +54,22 @@ int lineCount = 1;
 %token LPAREN RPAREN COMMA
 %token NEWLINE
 
-%token <str> IDENTIFIER INT_LITERAL CHAR_LITERAL STRING_LITERAL
-%token <str> PLUS_EQUAL MINUS_EQUAL MUL_EQUAL DIV_EQUAL EQUAL
+%token <sym> IDENTIFIER INT_LITERAL CHAR_LITERAL STRING_LITERAL
+%token PLUS_EQUAL MINUS_EQUAL MUL_EQUAL DIV_EQUAL EQUAL
 
 /* Nonterminals that produce AST nodes */
-%type <node> S STATEMENT_LIST STATEMENT
-%type <node> PRINTING PRINT_LIST PRINT_LIST_PRIME PRINT_ITEM
-%type <node> DECLARATION DATATYPE INIT_DECLARATOR_LIST INIT_DECLARATOR DECLARATOR
-%type <node> ASSIGNMENT ASSIGN_OP
-%type <node> SIMPLE_EXPR ADD_EXPR TERM FACTOR UNARY POSTFIX POSTFIX_OPT PRIMARY
+%type <node> S STATEMENT
+%type <node> PRINTING PRINT_LIST PRINT_ITEM
+%type <node> DECLARATION INIT_DECLARATOR DECLARATOR
+
+/* Lists built front to back by left-recursive rules */
+%type <list> STATEMENT_LIST PRINT_LIST_PRIME INIT_DECLARATOR_LIST
+%type <node> ASSIGNMENT
+%type <node> SIMPLE_EXPR ADD_EXPR TERM FACTOR UNARY POSTFIX PRIMARY
+
+/* Nonterminals that only pick an operator */
+%type <op> ASSIGN_OP POSTFIX_OPT
+%type <dtype> DATATYPE
 
 %start S
 
@@ -46,86 +79,113 @@ int lineCount = 1;
 S:
     STATEMENT_LIST
     {
-        root = new_node(NODE_START, "START", $1, NULL, lineCount);
+        ctx->root = ast_node(&ctx->ast, NODE_START, AST_KIND_NONE, $1.head, AST_NULL, ctx->lineCount);
     }
 ;
 
-/* List of statements (can be empty) */
+/* List of statements (can be empty). Left-recursive, so the parser stack
+   stays flat however long the program is; each new STMT_LIST node is
+   linked onto the previous one, giving the same right-leaning chain. */
 STATEMENT_LIST:
-      STATEMENT STATEMENT_LIST
-      { $$ = new_node(NODE_STATEMENT_LIST, "STMT_LIST", $1, $2, lineCount); }
+      STATEMENT_LIST STATEMENT
+      {
+          AstRef n = ast_node(&ctx->ast, NODE_STATEMENT_LIST, AST_KIND_NONE, $2, AST_NULL, ctx->lineCount);
+          if ($1.tail)
+              ast_set_right(&ctx->ast, $1.tail, n);
+          $$.head = $1.head ? $1.head : n;
+          $$.tail = n;
+      }
     | /* empty */
-      { $$ = NULL; }
+      { $$.head = $$.tail = AST_NULL; }
 ;
 
 /* Statements must end with EXCLAM '!' */
 STATEMENT:
-      DECLARATION EXCLAM       { $$ = new_node(NODE_STATEMENT, "DECL_STMT", $1, NULL, lineCount); }
-    | ASSIGNMENT EXCLAM        { $$ = new_node(NODE_STATEMENT, "ASSIGN_STMT", $1, NULL, lineCount); }
-    | SIMPLE_EXPR EXCLAM       { $$ = new_node(NODE_STATEMENT, "EXPR_STMT", $1, NULL, lineCount); }
-    | PRINTING EXCLAM          { $$ = new_node(NODE_STATEMENT, "PRINT_STMT", $1, NULL, lineCount); }
-    | EXCLAM                   { $$ = new_node(NODE_STATEMENT, "EMPTY!", NULL, NULL, lineCount); }
-    | error NEWLINE            { yyerror("Invalid statement"); yyerrok; ++lineCount; islexerror=0; }
-    | NEWLINE                  { ++lineCount; }
+      DECLARATION EXCLAM       { $$ = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_DECL, $1, AST_NULL, ctx->lineCount); }
+    | ASSIGNMENT EXCLAM        { $$ = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_ASSIGN, $1, AST_NULL, ctx->lineCount); }
+    | SIMPLE_EXPR EXCLAM       { $$ = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_EXPR, $1, AST_NULL, ctx->lineCount); }
+    | PRINTING EXCLAM          { $$ = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_PRINT, $1, AST_NULL, ctx->lineCount); }
+    | EXCLAM                   { $$ = ast_node(&ctx->ast, NODE_STATEMENT, AST_STMT_EMPTY, AST_NULL, AST_NULL, ctx->lineCount); }
+    | error NEWLINE            { yyerror(ctx, scanner, "Invalid statement"); yyerrok; ++ctx->lineCount; ctx->islexerror=0; }
+    | NEWLINE                  { ++ctx->lineCount; }
 ;
 
 /* Printing */
 PRINTING:
     PRENT PRINT_LIST
-    { $$ = new_node(NODE_PRINTING, "PRINT", $2, NULL, lineCount); }
+    { $$ = ast_node(&ctx->ast, NODE_PRINTING, AST_KIND_NONE, $2, AST_NULL, ctx->lineCount); }
 ;
 
 PRINT_LIST:
       PRINT_ITEM PRINT_LIST_PRIME
-      { $$ = new_node(NODE_PRINT_ITEM, "PRINT_LIST", $1, $2, lineCount); }
+      { $$ = ast_node(&ctx->ast, NODE_PRINT_ITEM, AST_PRINT_LIST, $1, $2.head, ctx->lineCount); }
     | /* empty */
-      { $$ = NULL; }
+      { $$ = AST_NULL; }
 ;
 
 PRINT_LIST_PRIME:
-      COMMA PRINT_ITEM PRINT_LIST_PRIME
-      { $$ = new_node(NODE_PRINT_ITEM, "PRINT_ITEM", $2, $3, lineCount); }
+      PRINT_LIST_PRIME COMMA PRINT_ITEM
+      {
+          AstRef n = ast_node(&ctx->ast, NODE_PRINT_ITEM, AST_PRINT_ITEM, $3, AST_NULL, ctx->lineCount);
+          if ($1.tail)
+              ast_set_right(&ctx->ast, $1.tail, n);
+          $$.head = $1.head ? $1.head : n;
+          $$.tail = n;
+      }
     | /* empty */
-      { $$ = NULL; }
+      { $$.head = $$.tail = AST_NULL; }
 ;
 
 PRINT_ITEM:
       SIMPLE_EXPR              { $$ = $1; }
-    | STRING_LITERAL           { $$ = new_node(NODE_STRING_LITERAL, $1, NULL, NULL, lineCount); }
+    | STRING_LITERAL           { $$ = ast_string_literal(&ctx->ast, $1, ctx->lineCount); }
 ;
 
 /* Declarations */
 DECLARATION:
     DATATYPE INIT_DECLARATOR_LIST
     {
-        $$ = new_node(NODE_DECLARATION, $1 ? $1->value : "TYPE", $2, NULL, lineCount);
-        if ($1) { free($1->value); free($1); }
+        $$ = ast_declaration(&ctx->ast, $1, $2.head, ctx->lineCount);
     }
 ;
 
 DATATYPE:
-      CHAROT   { $$ = new_node(NODE_DATATYPE, "CHAROT", NULL, NULL, lineCount); }
-    | ENTEGER  { $$ = new_node(NODE_DATATYPE, "ENTEGER", NULL, NULL, lineCount); }
-    | KUAN     { $$ = new_node(NODE_DATATYPE, "KUAN", NULL, NULL, lineCount); }
+      CHAROT   { $$ = AST_TYPE_CHAROT; }
+    | ENTEGER  { $$ = AST_TYPE_ENTEGER; }
+    | KUAN     { $$ = AST_TYPE_KUAN; }
 ;
 
+/* a, b, c becomes DECL(a, DECL(b, c)): each new declarator shares a DECL
+   node with the one that used to end the list */
 INIT_DECLARATOR_LIST:
       INIT_DECLARATOR
-      { $$ = $1; }
-    | INIT_DECLARATOR COMMA INIT_DECLARATOR_LIST
-      { $$ = new_node(NODE_DECLARATION, "DECL", $1, $3, lineCount); }
+      { $$.head = $1; $$.tail = AST_NULL; }
+    | INIT_DECLARATOR_LIST COMMA INIT_DECLARATOR
+      {
+          if ($1.tail)
+          {
+              AstRef n = ast_node(&ctx->ast, NODE_DECLARATION, AST_DECL_LIST, ast_right(&ctx->ast, $1.tail), $3, ctx->lineCount);
+              ast_set_right(&ctx->ast, $1.tail, n);
+              $$.head = $1.head;
+              $$.tail = n;
+          }
+          else
+          {
+              $$.head = $$.tail = ast_node(&ctx->ast, NODE_DECLARATION, AST_DECL_LIST, $1.head, $3, ctx->lineCount);
+          }
+      }
 ;
 
 INIT_DECLARATOR:
       DECLARATOR
       { $$ = $1; }
     | DECLARATOR EQUAL SIMPLE_EXPR
-      { $$ = new_node(NODE_DECLARATION, "INIT_DECL", $1, $3, lineCount); }
+      { $$ = ast_node(&ctx->ast, NODE_DECLARATION, AST_DECL_INIT, $1, $3, ctx->lineCount); }
 ;
 
 DECLARATOR:
       IDENTIFIER
-      { $$ = new_node(NODE_IDENTIFIER, $1, NULL, NULL, lineCount); }
+      { $$ = ast_ident(&ctx->ast, $1, ctx->lineCount); }
     | LPAREN DECLARATOR RPAREN
       { $$ = $2; }
 ;
@@ -134,25 +194,23 @@ DECLARATOR:
 ASSIGNMENT:
       IDENTIFIER ASSIGN_OP ASSIGNMENT
       {
-          ASTNode *id = new_node(NODE_IDENTIFIER, $1, NULL, NULL, lineCount);
-          $$ = new_node(NODE_ASSIGNMENT, $2->value, id, $3, lineCount);
-          free($2->value); free($2);
+          AstRef id = ast_ident(&ctx->ast, $1, ctx->lineCount);
+          $$ = ast_op_node(&ctx->ast, NODE_ASSIGNMENT, $2, id, $3, ctx->lineCount);
       }
     | IDENTIFIER ASSIGN_OP SIMPLE_EXPR
       {
-          ASTNode *id = new_node(NODE_IDENTIFIER, $1, NULL, NULL, lineCount);
-          $$ = new_node(NODE_ASSIGNMENT, $2->value, id, $3, lineCount);
-          free($2->value); free($2);
+          AstRef id = ast_ident(&ctx->ast, $1, ctx->lineCount);
+          $$ = ast_op_node(&ctx->ast, NODE_ASSIGNMENT, $2, id, $3, ctx->lineCount);
       }
 ;
 
-/* ASSIGN_OP returns a node carrying the operator text */
+/* ASSIGN_OP yields the operator */
 ASSIGN_OP:
-      EQUAL        { $$ = new_node(NODE_UNKNOWN, $1, NULL, NULL, lineCount); }
-    | PLUS_EQUAL   { $$ = new_node(NODE_UNKNOWN, $1, NULL, NULL, lineCount); }
-    | MINUS_EQUAL  { $$ = new_node(NODE_UNKNOWN, $1, NULL, NULL, lineCount); }
-    | DIV_EQUAL    { $$ = new_node(NODE_UNKNOWN, $1, NULL, NULL, lineCount); }
-    | MUL_EQUAL    { $$ = new_node(NODE_UNKNOWN, $1, NULL, NULL, lineCount); }
+      EQUAL        { $$ = AST_OP_ASSIGN; }
+    | PLUS_EQUAL   { $$ = AST_OP_ADD_ASSIGN; }
+    | MINUS_EQUAL  { $$ = AST_OP_SUB_ASSIGN; }
+    | DIV_EQUAL    { $$ = AST_OP_DIV_ASSIGN; }
+    | MUL_EQUAL    { $$ = AST_OP_MUL_ASSIGN; }
 ;
 
 /* Expressions */
@@ -161,14 +219,14 @@ SIMPLE_EXPR:
 ;
 
 ADD_EXPR:
-      ADD_EXPR PLUS TERM   { $$ = new_node(NODE_EXPRESSION, "+", $1, $3, lineCount); }
-    | ADD_EXPR MINUS TERM  { $$ = new_node(NODE_EXPRESSION, "-", $1, $3, lineCount); }
+      ADD_EXPR PLUS TERM   { $$ = ast_op_node(&ctx->ast, NODE_EXPRESSION, AST_OP_ADD, $1, $3, ctx->lineCount); }
+    | ADD_EXPR MINUS TERM  { $$ = ast_op_node(&ctx->ast, NODE_EXPRESSION, AST_OP_SUB, $1, $3, ctx->lineCount); }
     | TERM                 { $$ = $1; }
 ;
 
 TERM:
-      TERM MUL FACTOR      { $$ = new_node(NODE_TERM, "*", $1, $3, lineCount); }
-    | TERM DIV FACTOR      { $$ = new_node(NODE_TERM, "/", $1, $3, lineCount); }
+      TERM MUL FACTOR      { $$ = ast_op_node(&ctx->ast, NODE_TERM, AST_OP_MUL, $1, $3, ctx->lineCount); }
+    | TERM DIV FACTOR      { $$ = ast_op_node(&ctx->ast, NODE_TERM, AST_OP_DIV, $1, $3, ctx->lineCount); }
     | FACTOR               { $$ = $1; }
 ;
 
@@ -178,18 +236,17 @@ FACTOR:
 ;
 
 UNARY:
-      PLUS FACTOR          { $$ = new_node(NODE_UNARY_OP, "+", $2, NULL, lineCount); }
-    | MINUS FACTOR         { $$ = new_node(NODE_UNARY_OP, "-", $2, NULL, lineCount); }
-    | PLUSPLUS POSTFIX     { $$ = new_node(NODE_UNARY_OP, "++", $2, NULL, lineCount); }
-    | MINUSMINUS POSTFIX   { $$ = new_node(NODE_UNARY_OP, "--", $2, NULL, lineCount); }
+      PLUS FACTOR          { $$ = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_ADD, $2, AST_NULL, ctx->lineCount); }
+    | MINUS FACTOR         { $$ = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_SUB, $2, AST_NULL, ctx->lineCount); }
+    | PLUSPLUS POSTFIX     { $$ = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_INC, $2, AST_NULL, ctx->lineCount); }
+    | MINUSMINUS POSTFIX   { $$ = ast_op_node(&ctx->ast, NODE_UNARY_OP, AST_OP_DEC, $2, AST_NULL, ctx->lineCount); }
 ;
 
 POSTFIX:
       PRIMARY POSTFIX_OPT
       {
-          if ($2) {
-              $$ = new_node(NODE_POSTFIX_OP, $2->value, $1, NULL, lineCount);
-              free($2->value); free($2);
+          if ($2 != AST_OP_NONE) {
+              $$ = ast_op_node(&ctx->ast, NODE_POSTFIX_OP, $2, $1, AST_NULL, ctx->lineCount);
           } else {
               $$ = $1;
           }
@@ -197,30 +254,29 @@ POSTFIX:
 ;
 
 POSTFIX_OPT:
-      /* empty */ { $$ = NULL; }
-    | PLUSPLUS   { $$ = new_node(NODE_UNKNOWN, "++", NULL, NULL, lineCount); }
-    | MINUSMINUS { $$ = new_node(NODE_UNKNOWN, "--", NULL, NULL, lineCount); }
+      /* empty */ { $$ = AST_OP_NONE; }
+    | PLUSPLUS   { $$ = AST_OP_INC; }
+    | MINUSMINUS { $$ = AST_OP_DEC; }
 ;
 
 PRIMARY:
-      IDENTIFIER    { $$ = new_node(NODE_IDENTIFIER, $1, NULL, NULL, lineCount); }
-    | INT_LITERAL   { $$ = new_node(NODE_LITERAL, $1, NULL, NULL, lineCount); }
-    | CHAR_LITERAL  { $$ = new_node(NODE_LITERAL, $1, NULL, NULL, lineCount); }
+      IDENTIFIER    { $$ = ast_ident(&ctx->ast, $1, ctx->lineCount); }
+    | INT_LITERAL   { $$ = ast_int_literal(&ctx->ast, &ctx->names, $1, ctx->lineCount); }
+    | CHAR_LITERAL  { $$ = ast_char_literal(&ctx->ast, &ctx->names, $1, ctx->lineCount); }
     | LPAREN SIMPLE_EXPR RPAREN { $$ = $2; }
 ;
 
 %%
 
 /* Error handler */
-void yyerror(const char *s) {
-    if (islexerror == 0) {               // only log if no previous error
-        FILE *out = fopen("output_print.txt", "w"); // overwrite
-        if (out) {
-            /* fprintf(out, "[PARSE] Syntax Error [line:%d]\n", lineCount); */
-            fprintf(out, "Syntax Error [line:%d]\n", lineCount); 
-            fclose(out);
-        }
-        islexerror = 1;                  // mark that an error was logged
+void yyerror(BaiCompiler *ctx, yyscan_t scanner, const char *s) {
+    (void)scanner;
+    if (ctx->islexerror == 0) {          // only log if no previous error
+        bai_output_clear(ctx, BAI_OUT_PRINT); // overwrite
+        /* bai_output_printf(ctx, BAI_OUT_PRINT, "[PARSE] Syntax Error [line:%d]\n", ctx->lineCount); */
+        bai_output_printf(ctx, BAI_OUT_PRINT, "Syntax Error [line:%d]\n", ctx->lineCount);
+        bai_report(ctx, BAI_DIAG_ERROR, ctx->lineCount, "Syntax Error");
+        ctx->islexerror = 1;             // mark that an error was logged
     }
-    parse_failed = 1;
+    ctx->parse_failed = 1;
 }